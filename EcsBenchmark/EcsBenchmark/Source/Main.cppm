@@ -0,0 +1,181 @@
+import std;
+
+import gse.utility;
+
+struct body {
+	gse::id owner;
+	std::array<float, 24> state{};
+
+	explicit body(const gse::id owner) : owner(owner) {}
+};
+
+using queue = gse::double_buffered_id_mapped_queue<body, gse::id>;
+
+struct lookup_data {
+	std::array<float, 16> state{};
+};
+
+struct lookup_component : gse::component<lookup_data> {
+	using component::component;
+};
+
+struct flip_result {
+	double frame_us = 0.0;
+	double flip_us = 0.0;
+	std::size_t copied = 0;
+};
+
+auto populate(queue& q, queue::writer& writer, const std::size_t count) -> void {
+	for (std::size_t i = 0; i < count; ++i) {
+		const auto owner = gse::generate_temp_id(i + 1);
+		writer.emplace_queued(owner);
+		writer.activate(owner, static_cast<std::uint32_t>(i));
+	}
+	q.flip();
+}
+
+auto run(const std::size_t count, const double touched, const gse::flip_mode mode, const std::size_t frames, const bool structural) -> flip_result {
+	queue q;
+	q.set_flip_mode(mode);
+	auto writer = q.bind(0, 1).second;
+	populate(q, writer, count);
+
+	const auto stride = std::max<std::size_t>(1, static_cast<std::size_t>(1.0 / touched));
+	std::mt19937 rng(7);
+	std::chrono::duration<double, std::micro> frame_time{};
+	std::chrono::duration<double, std::micro> flip_time{};
+	std::size_t copied = 0;
+	std::uint64_t next_id = count + 1;
+
+	for (std::size_t frame = 0; frame < frames; ++frame) {
+		const auto frame_start = std::chrono::steady_clock::now();
+
+		const auto storage = writer.storage();
+		const auto offset = rng() % stride;
+		for (std::size_t i = offset; i < count; i += stride) {
+			if (auto* b = storage.try_get(static_cast<std::uint32_t>(i))) {
+				b->state[frame % b->state.size()] += 1.f;
+			}
+		}
+
+		if (structural) {
+			const auto owner = gse::generate_temp_id(next_id++);
+			writer.emplace_queued(owner);
+			writer.activate(owner, gse::sparse_span<body>::null_index);
+			writer.remove(owner);
+		}
+
+		const auto flip_start = std::chrono::steady_clock::now();
+		copied += q.flip();
+		const auto flip_end = std::chrono::steady_clock::now();
+
+		frame_time += flip_end - frame_start;
+		flip_time += flip_end - flip_start;
+	}
+
+	return {
+		.frame_us = frame_time.count() / static_cast<double>(frames),
+		.flip_us = flip_time.count() / static_cast<double>(frames),
+		.copied = copied / frames
+	};
+}
+
+auto time_per_op(const std::size_t ops, auto&& fn) -> double {
+	const auto start = std::chrono::steady_clock::now();
+	fn();
+	const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / static_cast<double>(ops);
+}
+
+auto run_lookups(const std::size_t count, const std::size_t rounds) -> void {
+	gse::registry reg;
+	std::vector<gse::id> ids;
+	std::vector<gse::entity> handles;
+	ids.reserve(count);
+	handles.reserve(count);
+
+	for (std::size_t i = 0; i < count; ++i) {
+		const auto owner = reg.create(std::format("ecs_benchmark.{}", i));
+		reg.activate(owner);
+		reg.add_component<lookup_component>(owner);
+		ids.push_back(owner);
+		handles.push_back(*reg.handle(owner));
+	}
+
+	std::ranges::shuffle(ids, std::mt19937(11));
+	for (std::size_t i = 0; i < count; ++i) {
+		handles[i] = *reg.handle(ids[i]);
+	}
+
+	const std::size_t ops = count * rounds;
+	float sink = 0.f;
+
+	const double read_id = time_per_op(ops, [&] {
+		for (std::size_t r = 0; r < rounds; ++r) {
+			for (const auto& owner : ids) {
+				sink += reg.try_linked_object_read<lookup_component>(owner)->state[0];
+			}
+		}
+	});
+
+	const double read_handle = time_per_op(ops, [&] {
+		for (std::size_t r = 0; r < rounds; ++r) {
+			for (const auto& handle : handles) {
+				sink += reg.try_linked_object_read<lookup_component>(handle)->state[0];
+			}
+		}
+	});
+
+	const double write_id = time_per_op(ops, [&] {
+		for (std::size_t r = 0; r < rounds; ++r) {
+			for (const auto& owner : ids) {
+				reg.try_linked_object_write<lookup_component>(owner)->state[0] += 1.f;
+			}
+		}
+	});
+	const auto updated_id = reg.drain_component_updates<lookup_component>().size();
+
+	const double write_handle = time_per_op(ops, [&] {
+		for (std::size_t r = 0; r < rounds; ++r) {
+			for (const auto& handle : handles) {
+				reg.try_linked_object_write<lookup_component>(handle)->state[0] += 1.f;
+			}
+		}
+	});
+	const auto updated_handle = reg.drain_component_updates<lookup_component>().size();
+
+	std::println("");
+	std::println("EcsBenchmark: component lookup over {} entities, {} rounds (sink {})", count, rounds, sink);
+	std::println("{:>10} {:>12} {:>12} {:>10}", "path", "read ns", "write ns", "updates");
+	std::println("{:>10} {:>12.1f} {:>12.1f} {:>10}", "id", read_id, write_id, updated_id);
+	std::println("{:>10} {:>12.1f} {:>12.1f} {:>10}", "handle", read_handle, write_handle, updated_handle);
+}
+
+auto main(const int argc, char** argv) -> int {
+	const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 100'000;
+	const std::size_t frames = argc > 2 ? std::stoul(argv[2]) : 200;
+
+	std::println("EcsBenchmark: flip of {} components ({} bytes each), {} frames", count, sizeof(body), frames);
+	std::println("{:>10} {:>8} {:>11} {:>12} {:>12} {:>12}", "mode", "touched", "structural", "copied", "flip us", "frame us");
+
+	for (const auto mode : { gse::flip_mode::full_copy, gse::flip_mode::dirty_only }) {
+		for (const double touched : { 0.01, 0.1, 1.0 }) {
+			for (const bool structural : { false, true }) {
+				const auto [frame_us, flip_us, copied] = run(count, touched, mode, frames, structural);
+				std::println(
+					"{:>10} {:>7.0f}% {:>11} {:>12} {:>12.1f} {:>12.1f}",
+					mode == gse::flip_mode::full_copy ? "full" : "dirty",
+					touched * 100.0,
+					structural ? "yes" : "no",
+					copied,
+					flip_us,
+					frame_us
+				);
+			}
+		}
+	}
+
+	run_lookups(count, 20);
+
+	return 0;
+}
@@ -15,17 +15,28 @@ import gse.graphics;
 
 export import :actions;
 export import :remote_peer;
+export import :baseline;
+export import :priority;
+export import :owner_index;
 export import :socket;
+export import :link_conditioner;
 export import :bitstream;
+export import :quantize;
 export import :packet_header;
+export import :packet_buffer;
 export import :message;
+export import :message_batch;
+export import :send_queue;
 export import :connection;
 export import :ping_pong;
 export import :input_frame;
+export import :prediction;
+export import :interpolation;
 export import :notify_scene_change;
 export import :client;
 export import :discovery;
 export import :registry_sync;
+export import :interest;
 export import :replication;
 export import :server_info;
 
@@ -85,6 +96,10 @@ export namespace gse::network {
 		auto current_state(
 		) const -> client::state;
 
+		auto predict(
+			id entity
+		) -> void;
+
 		template <typename T>
 		auto send(
 			const T& m
@@ -101,6 +116,12 @@ export namespace gse::network {
 		std::mutex user_inbox_mutex;
 		std::vector<inbox_message> user_inbox;
 		std::vector<std::move_only_function<void(registry&)>> deferred;
+		baseline_history baselines;
+		owner_index_map owners;
+		prediction_buffer prediction;
+		interpolation_buffer interpolation;
+		id predicted_entity;
+		std::uint32_t stepped_sequence = 0;
 	};
 
 	struct system {
@@ -127,70 +148,97 @@ auto gse::network::system::update(const update_phase& phase, system_state& s) ->
 	const auto* renderer_state = phase.try_state_of<renderer::state>();
 
 	s.client_ptr->drain([&s, renderer_state](inbox_message& msg) {
+		if (const auto* ack = std::get_if<input_ack>(&msg)) {
+			s.prediction.reconcile(*ack);
+			return;
+		}
+
 		if (auto* rep = std::get_if<replication_message>(&msg)) {
-			const std::span data(rep->payload);
-			bitstream stream(data);
+			auto stream = bitstream::reader(rep->payload.bytes);
+
+			s.interpolation.observe(rep->server_time, rep->received_time);
+
+			auto apply_upsert = [&]<typename T>(const component_upsert<T>& m) {
+				if constexpr (std::is_same_v<T, physics::motion_component>) {
+					if (m.owner_id != s.predicted_entity) {
+						s.interpolation.push(m.owner_id, {
+							.server_time = rep->server_time,
+							.position = m.data.current_position,
+							.velocity = m.data.current_velocity,
+							.orientation = m.data.orientation
+						});
+					}
+				}
 
-			match_and_apply_components(
-				stream,
-				rep->id,
-				[&]<typename T>(const component_upsert<T>& m) {
-					if constexpr (std::is_same_v<T, render_component>) {
-						auto fixed_data = m.data;
+				if constexpr (std::is_same_v<T, render_component>) {
+					auto fixed_data = m.data;
 
-						if (renderer_state) {
-							for (std::uint32_t i = 0; i < fixed_data.model_count; ++i) {
-								const auto res_id = fixed_data.models[i].id();
-								fixed_data.models[i] = renderer_state->try_get<model>(res_id);
-							}
+					if (renderer_state) {
+						for (std::uint32_t i = 0; i < fixed_data.model_count; ++i) {
+							const auto res_id = fixed_data.models[i].id();
+							fixed_data.models[i] = renderer_state->try_get<model>(res_id);
+						}
 
-							for (std::uint32_t i = 0; i < fixed_data.skinned_model_count; ++i) {
-								const auto res_id = fixed_data.skinned_models[i].id();
-								fixed_data.skinned_models[i] = renderer_state->try_get<skinned_model>(res_id);
-							}
+						for (std::uint32_t i = 0; i < fixed_data.skinned_model_count; ++i) {
+							const auto res_id = fixed_data.skinned_models[i].id();
+							fixed_data.skinned_models[i] = renderer_state->try_get<skinned_model>(res_id);
 						}
+					}
 
-						s.deferred.push_back([entity = m.owner_id, data = std::move(fixed_data)](registry& r) {
-							r.ensure_exists(entity);
-							r.add_deferred_action(entity, [entity, data](registry& reg) -> bool {
-								if (!reg.active(entity)) {
-									reg.ensure_active(entity);
-									return false;
-								}
-								if (auto* c = reg.try_linked_object_write<T>(entity)) {
-									c->networked_data() = data;
-									return true;
-								}
-								auto* c = reg.add_component<T>(entity, data);
+					s.deferred.push_back([entity = m.owner_id, data = std::move(fixed_data)](registry& r) {
+						r.ensure_exists(entity);
+						r.add_deferred_action(entity, [entity, data](registry& reg) -> bool {
+							if (!reg.active(entity)) {
+								reg.ensure_active(entity);
+								return false;
+							}
+							if (auto* c = reg.try_linked_object_write<T>(entity)) {
 								c->networked_data() = data;
 								return true;
-							});
+							}
+							auto* c = reg.add_component<T>(entity, data);
+							c->networked_data() = data;
+							return true;
 						});
-					}
-					else {
-						s.deferred.push_back([entity = m.owner_id, data = m.data](registry& r) {
-							r.ensure_exists(entity);
-							r.add_deferred_action(entity, [entity, data](registry& reg) -> bool {
-								if (!reg.active(entity)) {
-									reg.ensure_active(entity);
-									return false;
-								}
-								if (auto* c = reg.try_linked_object_write<T>(entity)) {
-									c->networked_data() = data;
-									return true;
-								}
-								auto* c = reg.add_component<T>(entity, data);
+					});
+				}
+				else {
+					s.deferred.push_back([entity = m.owner_id, data = m.data](registry& r) {
+						r.ensure_exists(entity);
+						r.add_deferred_action(entity, [entity, data](registry& reg) -> bool {
+							if (!reg.active(entity)) {
+								reg.ensure_active(entity);
+								return false;
+							}
+							if (auto* c = reg.try_linked_object_write<T>(entity)) {
 								c->networked_data() = data;
 								return true;
-							});
+							}
+							auto* c = reg.add_component<T>(entity, data);
+							c->networked_data() = data;
+							return true;
 						});
-					}
+					});
+				}
+			};
+
+			match_and_apply_components(
+				stream,
+				rep->id,
+				[&]<typename T>(const component_upsert<T>& m) {
+					s.owners.define(m.owner_index, m.owner_id);
+					apply_upsert(m);
 				},
 				[&]<typename T>(const component_remove<T>& m) {
-					if (!m.owner_id.exists()) {
+					const auto owner = s.owners.resolve(m.owner_index);
+					if (!owner.exists()) {
 						return;
 					}
-					s.deferred.push_back([entity = m.owner_id](registry& r) {
+					s.baselines.forget(baseline_key_of<T>(owner));
+					if constexpr (std::is_same_v<T, physics::motion_component>) {
+						s.interpolation.forget(owner);
+					}
+					s.deferred.push_back([entity = owner](registry& r) {
 						r.add_deferred_action(entity, [entity](registry& reg) -> bool {
 							if constexpr (std::is_same_v<T, player_controller>) {
 								if (reg.exists(entity)) {
@@ -202,6 +250,37 @@ auto gse::network::system::update(const update_phase& phase, system_state& s) ->
 							return true;
 						});
 					});
+				},
+				[&]<typename T>(const component_delta<T>& m) {
+					auto owner = m.owner_id;
+					if (owner.exists()) {
+						s.owners.define(m.owner_index, owner);
+					}
+					else {
+						owner = s.owners.resolve(m.owner_index);
+					}
+					if (!owner.exists()) {
+						return;
+					}
+
+					const auto key = baseline_key_of<T>(owner);
+
+					typename T::network_data_t baseline{};
+					if (m.baseline_sequence != no_baseline) {
+						const auto stored = s.baselines.find(key, m.baseline_sequence);
+						if (stored.size() != sizeof(baseline)) {
+							return;
+						}
+						std::memcpy(&baseline, stored.data(), sizeof(baseline));
+					}
+
+					const component_upsert<T> full{
+						.owner_id = owner,
+						.owner_index = m.owner_index,
+						.data = apply_component_delta(m, baseline)
+					};
+					s.baselines.store(key, rep->sequence, std::as_bytes(std::span{ &full.data, 1 }));
+					apply_upsert(full);
 				}
 			);
 
@@ -219,19 +298,55 @@ auto gse::network::system::update(const update_phase& phase, system_state& s) ->
 	}
 	s.deferred.clear();
 
+	phase.schedule([&s, time = s.interpolation.playout_time(current_time_ms())](chunk<physics::motion_component> motion) {
+		s.interpolation.for_each(time, [&](const id entity, const entity_snapshot& snapshot) {
+			auto* mc = motion.find(entity);
+			if (!mc) {
+				return;
+			}
+
+			mc->current_position = snapshot.position;
+			mc->previous_position = snapshot.position;
+			mc->current_velocity = snapshot.velocity;
+			mc->orientation = snapshot.orientation;
+			mc->previous_orientation = snapshot.orientation;
+		});
+	});
+
 	if (s.client_ptr->current_state() == client::state::connected) {
+		std::uint32_t sent_sequence = 0;
 		if (const auto* actions_state = phase.try_state_of<actions::system_state>()) {
 			angle yaw;
 			if (const auto* cam_state = phase.try_state_of<camera::state>()) {
 				yaw = cam_state->yaw;
 			}
-			s.client_ptr->push_input(
+			sent_sequence = s.client_ptr->push_input(
 				actions_state->current_state(),
 				actions_state->axis1_ids(),
 				actions_state->axis2_ids(),
 				yaw
 			);
 		}
+
+		// Network updates before physics, so the motion state seen here is the result of
+		// last frame's step, which consumed the input pushed last frame.
+		const auto stepped_sequence = std::exchange(s.stepped_sequence, sent_sequence);
+
+		if (s.predicted_entity.exists()) {
+			phase.schedule([&s, entity = s.predicted_entity, sequence = stepped_sequence](chunk<physics::motion_component> motion) {
+				auto* mc = motion.find(entity);
+				if (!mc) {
+					return;
+				}
+
+				s.prediction.record(sequence, mc->current_position, mc->current_velocity);
+
+				const auto [position, velocity] = s.prediction.take_correction();
+				mc->current_position += position;
+				mc->previous_position += position;
+				mc->current_velocity += velocity;
+			});
+		}
 	}
 }
 
@@ -297,6 +412,10 @@ auto gse::network::system_state::connect(const discovery_result& pick, const std
 
 auto gse::network::system_state::disconnect() -> void {
 	client_ptr.reset();
+	prediction.reset();
+	interpolation.clear();
+	owners.clear();
+	stepped_sequence = 0;
 }
 
 auto gse::network::system_state::current_state() const -> client::state {
@@ -306,6 +425,13 @@ auto gse::network::system_state::current_state() const -> client::state {
 	return client::state::disconnected;
 }
 
+auto gse::network::system_state::predict(const id entity) -> void {
+	if (entity != predicted_entity) {
+		prediction.reset();
+	}
+	predicted_entity = entity;
+}
+
 auto gse::network::system_state::drain(const std::function<void(inbox_message&)>& handler, time_t<std::uint32_t>) -> void {
 	std::vector<inbox_message> batch;
 
@@ -3,6 +3,10 @@ export module gse.physics;
 export import gse.math;
 
 export import :bounding_box;
+export import :broad_phase_collision;
+export import :convex_hull;
+export import :mesh_collider;
+export import :scene_query;
 export import :collision_component;
 export import :motion_component;
 export import :contact_manifold;
@@ -11,4 +15,5 @@ export import :vbd_constraint_graph;
 export import :vbd_contact_cache;
 export import :vbd_solver;
 export import :vbd_gpu_solver;
+export import :simulation_islands;
 export import :system;
\ No newline at end of file
@@ -37,6 +37,7 @@ export import :task;
 export import :timed_lock;
 export import :timer;
 export import :trace;
+export import :trace_capture;
 export import :variant_match;
 export import :file_watcher;
 
@@ -19,6 +19,7 @@ export namespace gse {
         std::optional<vec2f> size = std::nullopt;
         bool resizable = true;
         bool fullscreen = false;
+        std::optional<std::filesystem::path> trace_capture = std::nullopt;
     };
 
     template <typename State>
@@ -90,6 +91,7 @@ auto gse::start(const flags<engine_flag> engine_flags, const engine_config& conf
     (engine_instance->add_hook<Hooks>(), ...);
 
     auto cleanup = make_scope_exit([] {
+        trace::end_capture();
         if (engine_instance) {
             engine_instance->shutdown();
             engine_instance.reset();
@@ -97,6 +99,11 @@ auto gse::start(const flags<engine_flag> engine_flags, const engine_config& conf
     });
 
     engine_instance->initialize();
+
+    if (config.trace_capture) {
+        trace::begin_capture({ .path = *config.trace_capture });
+    }
+
     task::start([&] {
         while (!should_shutdown.load(std::memory_order_acquire)) {
             if (engine_flags.test(engine_flag::create_window)) {
@@ -7,6 +7,7 @@ import gse.utility;
 import gse.platform;
 import gse.physics;
 import gse.graphics;
+import gse.network;
 
 export namespace gse {
 	struct evaluation_context {
@@ -232,6 +233,7 @@ export namespace gse {
 							reg.remove(current_local);
 						}
 						m_owner->set_local_controlled_entity({});
+						m_owner->state_of<network::system_state>().predict({});
 						m_processed.erase(our_controller);
 						m_controller_to_local_player.erase(our_controller);
 					}
@@ -281,6 +283,7 @@ export namespace gse {
 
 					const auto local_player_id = factory(*current);
 					m_owner->set_local_controlled_entity(local_player_id);
+					m_owner->state_of<network::system_state>().predict(local_player_id);
 					m_processed.insert(controller_id);
 					m_controller_to_local_player[controller_id] = local_player_id;
 				}
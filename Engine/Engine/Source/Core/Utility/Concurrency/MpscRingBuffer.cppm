@@ -7,53 +7,98 @@ export namespace gse {
 	class mpsc_ring_buffer {
 		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
 	public:
+		mpsc_ring_buffer();
+
 		auto push(
 			const T& value
 		) -> bool;
 
+		auto push(
+			T&& value
+		) -> bool;
+
 		auto pop(
 			T& out
 		) -> bool;
 	private:
+		struct cell {
+			std::atomic<std::size_t> sequence{ 0 };
+			T value{};
+		};
+
 		static constexpr auto index(
 			std::size_t i
 		) -> std::size_t;
 
-		std::array<T, Capacity> m_data{};
+		template <typename U>
+		auto emplace(
+			U&& value
+		) -> bool;
+
+		std::array<cell, Capacity> m_data{};
 		alignas(std::hardware_destructive_interference_size) std::atomic<std::size_t> m_head{ 0 };
 		alignas(std::hardware_destructive_interference_size) std::atomic<std::size_t> m_tail{ 0 };
 	};
 }
 
+template <typename T, std::size_t Capacity>
+gse::mpsc_ring_buffer<T, Capacity>::mpsc_ring_buffer() {
+	for (std::size_t i = 0; i < Capacity; ++i) {
+		m_data[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
 template <typename T, std::size_t Capacity>
 auto gse::mpsc_ring_buffer<T, Capacity>::push(const T& value) -> bool {
-	std::size_t head_old;
+	return emplace(value);
+}
+
+template <typename T, std::size_t Capacity>
+auto gse::mpsc_ring_buffer<T, Capacity>::push(T&& value) -> bool {
+	return emplace(std::move(value));
+}
+
+template <typename T, std::size_t Capacity>
+template <typename U>
+auto gse::mpsc_ring_buffer<T, Capacity>::emplace(U&& value) -> bool {
+	std::size_t head = m_head.load(std::memory_order_relaxed);
+	cell* c;
+
 	for (;;) {
-		head_old = m_head.load(std::memory_order_relaxed);
-		if (const auto tail = m_tail.load(std::memory_order_acquire); head_old - tail >= Capacity) {
+		c = &m_data[index(head)];
+		const auto sequence = c->sequence.load(std::memory_order_acquire);
+		const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(head);
+
+		if (diff == 0) {
+			if (m_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (diff < 0) {
 			return false;
 		}
-		if (m_head.compare_exchange_weak(
-				head_old,
-				head_old + 1,
-				std::memory_order_acq_rel,
-				std::memory_order_relaxed
-			)) {
-			break;
+		else {
+			head = m_head.load(std::memory_order_relaxed);
 		}
 	}
-	m_data[index(head_old)] = value;
+
+	c->value = std::forward<U>(value);
+	c->sequence.store(head + 1, std::memory_order_release);
 	return true;
 }
 
 template <typename T, std::size_t Capacity>
 auto gse::mpsc_ring_buffer<T, Capacity>::pop(T& out) -> bool {
 	const auto tail = m_tail.load(std::memory_order_relaxed);
-	if (const auto head = m_head.load(std::memory_order_acquire); tail == head) {
+	cell& c = m_data[index(tail)];
+
+	if (c.sequence.load(std::memory_order_acquire) != tail + 1) {
 		return false;
 	}
-	out = std::move(m_data[index(tail)]);
-	m_tail.store(tail + 1, std::memory_order_release);
+
+	out = std::move(c.value);
+	c.sequence.store(tail + Capacity, std::memory_order_release);
+	m_tail.store(tail + 1, std::memory_order_relaxed);
 	return true;
 }
 
@@ -61,4 +106,3 @@ template <typename T, std::size_t Capacity>
 constexpr auto gse::mpsc_ring_buffer<T, Capacity>::index(const std::size_t i) -> std::size_t {
 	return i & (Capacity - 1);
 }
-
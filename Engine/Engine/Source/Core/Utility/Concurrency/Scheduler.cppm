@@ -81,8 +81,29 @@ export namespace gse {
 			F&& fn
 		) -> void;
 	private:
+		struct work_graph {
+			std::vector<id> names;
+			std::vector<std::vector<std::type_index>> reads;
+			std::vector<std::vector<std::type_index>> writes;
+			std::vector<std::vector<std::uint32_t>> successors;
+			std::vector<std::uint32_t> dependency_counts;
+
+			auto matches(
+				std::span<const queued_work> work
+			) const -> bool;
+
+			auto rebuild(
+				std::span<const queued_work> work
+			) -> void;
+		};
+
 		auto drain_deferred(
 		) -> void;
+
+		auto run_work_graph(
+			std::vector<queued_work>& work
+		) -> void;
+
 		std::vector<std::unique_ptr<system_node_base>> m_nodes;
 		std::unordered_map<std::type_index, system_node_base*> m_state_index;
 		std::unordered_map<std::type_index, std::unique_ptr<channel_base>> m_channels;
@@ -91,6 +112,7 @@ export namespace gse {
 		std::mutex m_deferred_mutex;
 		registry* m_registry = nullptr;
 		registry_access m_registry_access{};
+		work_graph m_work_graph;
 
 		auto snapshot_all_channels(
 		) -> void;
@@ -102,10 +124,6 @@ export namespace gse {
 
 		auto make_channel_writer(
 		) -> channel_writer;
-
-		static auto build_work_batches(
-			std::vector<queued_work>& work
-		) -> std::vector<std::vector<queued_work*>>;
 	};
 }
 
@@ -224,40 +242,32 @@ auto gse::scheduler::defer(F&& fn) -> void {
 auto gse::scheduler::update() -> void {
 	drain_deferred();
 	auto writer = make_channel_writer();
-	work_queue work;
+	std::vector<work_queue> queues(m_nodes.size());
 
 	const registry_access const_registry_access = m_registry_access;
 
-	update_phase phase{
-		.registry = const_registry_access,
-		.snapshots = *this,
-		.channels = writer,
-		.channel_reader = *this,
-		.work = work
-	};
-
 	task::parallel_for(0uz, m_nodes.size(), [&](const std::size_t i) {
+		update_phase phase{
+			.registry = const_registry_access,
+			.snapshots = *this,
+			.channels = writer,
+			.channel_reader = *this,
+			.work = queues[i]
+		};
+
 		m_nodes[i]->update(phase);
 	});
 
-	if (work.work().empty()) {
-		return;
+	std::vector<queued_work> work;
+	for (auto& queue : queues) {
+		std::ranges::move(queue.work(), std::back_inserter(work));
 	}
 
-	for (auto& batch : build_work_batches(work.work())) {
-		if (batch.size() == 1) {
-			trace::scope(batch[0]->name, [&] {
-				batch[0]->execute(*m_registry);
-			});
-		}
-		else {
-			task::parallel_for(0uz, batch.size(), [&](const size_t i) {
-				trace::scope(batch[i]->name, [&] {
-					batch[i]->execute(*m_registry);
-				});
-			});
-		}
+	if (work.empty()) {
+		return;
 	}
+
+	run_work_graph(work);
 }
 
 auto gse::scheduler::render(const std::function<void()>& in_frame) -> void {
@@ -357,33 +367,99 @@ auto gse::scheduler::make_channel_writer() -> channel_writer {
 	});
 }
 
-auto gse::scheduler::build_work_batches(std::vector<queued_work>& work) -> std::vector<std::vector<queued_work*>> {
-	std::vector<std::vector<queued_work*>> batches;
+auto gse::scheduler::run_work_graph(std::vector<queued_work>& work) -> void {
+	if (work.size() == 1) {
+		trace::scope(work[0].name, [&] {
+			work[0].execute(*m_registry);
+		});
+		return;
+	}
 
-	for (auto& w : work) {
-		bool placed = false;
+	if (!m_work_graph.matches(work)) {
+		m_work_graph.rebuild(work);
+	}
 
-		for (auto& batch : batches) {
-			bool conflicts = false;
+	const auto& graph = m_work_graph;
+	std::vector<std::atomic<std::uint32_t>> pending(work.size());
+	for (const auto& [count, initial] : std::views::zip(pending, graph.dependency_counts)) {
+		count.store(initial, std::memory_order_relaxed);
+	}
 
-			for (const auto* existing : batch) {
-				if (w.conflicts_with(*existing)) {
-					conflicts = true;
-					break;
+	task::group group(find_or_generate_id("scheduler.work_graph"));
+
+	auto run = [&](this const auto& self, std::uint32_t index) -> void {
+		while (true) {
+			trace::scope(work[index].name, [&] {
+				work[index].execute(*m_registry);
+			});
+
+			std::optional<std::uint32_t> next;
+			for (const auto successor : graph.successors[index]) {
+				if (pending[successor].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+					continue;
+				}
+
+				if (!next) {
+					next = successor;
+				}
+				else {
+					group.post([&self, successor] {
+						self(successor);
+					}, find_or_generate_id("scheduler.work"));
 				}
 			}
 
-			if (!conflicts) {
-				batch.push_back(&w);
-				placed = true;
-				break;
+			if (!next) {
+				return;
 			}
+			index = *next;
 		}
+	};
 
-		if (!placed) {
-			batches.push_back({ &w });
+	for (std::uint32_t i = 0; i < work.size(); ++i) {
+		if (graph.dependency_counts[i] == 0) {
+			group.post([&run, i] {
+				run(i);
+			}, find_or_generate_id("scheduler.work"));
 		}
 	}
 
-	return batches;
+	group.wait();
+}
+
+auto gse::scheduler::work_graph::matches(const std::span<const queued_work> work) const -> bool {
+	if (work.size() != names.size()) {
+		return false;
+	}
+
+	for (const auto& [i, w] : work | std::views::enumerate) {
+		if (w.name != names[i] || w.reads != reads[i] || w.writes != writes[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+auto gse::scheduler::work_graph::rebuild(const std::span<const queued_work> work) -> void {
+	names.clear();
+	reads.clear();
+	writes.clear();
+	successors.assign(work.size(), {});
+	dependency_counts.assign(work.size(), 0);
+
+	for (const auto& w : work) {
+		names.push_back(w.name);
+		reads.push_back(w.reads);
+		writes.push_back(w.writes);
+	}
+
+	for (std::uint32_t later = 0; later < work.size(); ++later) {
+		for (std::uint32_t earlier = 0; earlier < later; ++earlier) {
+			if (work[later].conflicts_with(work[earlier])) {
+				successors[earlier].push_back(later);
+				++dependency_counts[later];
+			}
+		}
+	}
 }
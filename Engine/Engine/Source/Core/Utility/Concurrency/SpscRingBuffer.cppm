@@ -11,9 +11,16 @@ export namespace gse {
 			const T& value
 		) -> bool;
 
+		auto push(
+			T&& value
+		) -> bool;
+
 		auto pop(
 			T& out
 		) -> bool;
+
+		auto free_slots(
+		) const -> std::size_t;
 	private:
 		static constexpr auto mask(
 			std::size_t i
@@ -37,6 +44,18 @@ auto gse::spsc_ring_buffer<T, Capacity>::push(const T& value) -> bool {
 	return true;
 }
 
+template <typename T, std::size_t Capacity>
+auto gse::spsc_ring_buffer<T, Capacity>::push(T&& value) -> bool {
+	const auto head = m_head.load(std::memory_order_relaxed);
+	const auto next = mask(head + 1);
+	if (next == m_tail.load(std::memory_order_acquire)) {
+		return false;
+	}
+	m_data[head] = std::move(value);
+	m_head.store(next, std::memory_order_release);
+	return true;
+}
+
 template <typename T, std::size_t Capacity>
 auto gse::spsc_ring_buffer<T, Capacity>::pop(T& out) -> bool {
 	const auto tail = m_tail.load(std::memory_order_relaxed);
@@ -48,6 +67,13 @@ auto gse::spsc_ring_buffer<T, Capacity>::pop(T& out) -> bool {
 	return true;
 }
 
+template <typename T, std::size_t Capacity>
+auto gse::spsc_ring_buffer<T, Capacity>::free_slots() const -> std::size_t {
+	const auto head = m_head.load(std::memory_order_relaxed);
+	const auto tail = m_tail.load(std::memory_order_acquire);
+	return Capacity - 1 - mask(head - tail);
+}
+
 template <typename T, std::size_t Capacity>
 constexpr auto gse::spsc_ring_buffer<T, Capacity>::mask(const std::size_t i) -> std::size_t {
 	return i & (Capacity - 1);
@@ -1,11 +1,8 @@
-module;
-
-#include <oneapi/tbb.h>
-
 export module gse.utility:task;
 
 import std;
 
+import :non_copyable;
 import :scope_exit;
 import :lambda_traits;
 import :id;
@@ -24,19 +21,54 @@ namespace gse::task {
 		parallel_for_fn func,
 		id id
 	) -> void;
+
+	struct job_node {
+		static constexpr std::size_t inline_size = 64;
+
+		alignas(std::max_align_t) std::array<std::byte, inline_size> storage;
+		auto (*invoke)(job_node&) -> void = nullptr;
+		auto (*destroy)(job_node&) -> void = nullptr;
+		id label;
+		std::uint64_t parent_eid = 0;
+		std::atomic<std::size_t>* pending = nullptr;
+		job_node* next = nullptr;
+	};
+
+	template <typename F>
+	auto make_job(
+		F&& f,
+		id label,
+		std::uint64_t parent_eid,
+		std::atomic<std::size_t>* pending
+	) -> job_node*;
+
+	auto acquire_node(
+	) -> job_node*;
+
+	auto submit(
+		job_node* node
+	) -> void;
+
+	auto help_until(
+		const std::atomic<std::size_t>& pending
+	) -> void;
 }
 
 export namespace gse::task {
 	class group;
 
+	template <typename T = void>
+	class task;
+
 	template <typename F>
 	auto start(
 		F&& fn = [] {},
 		std::size_t worker_count = std::thread::hardware_concurrency()
 	) -> std::invoke_result_t<F&>;
 
+	template <std::invocable F>
 	auto post(
-		job j,
+		F&& f,
 		id id = trace::make_loc_id(std::source_location::current())
 	) -> void;
 
@@ -64,6 +96,26 @@ export namespace gse::task {
 	auto wait_idle(
 	) -> void;
 
+	auto schedule(
+		id id = trace::make_loc_id(std::source_location::current())
+	);
+
+	template <typename T>
+	auto when_all(
+		std::vector<task<T>> tasks,
+		id id = trace::make_loc_id(std::source_location::current())
+	) -> task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>;
+
+	template <typename T>
+	auto sync_wait(
+		task<T> t
+	) -> T;
+
+	auto spawn(
+		task<> t,
+		id id = trace::make_loc_id(std::source_location::current())
+	) -> void;
+
 	class group : non_copyable, non_movable {
 	public:
 		explicit group(
@@ -72,8 +124,9 @@ export namespace gse::task {
 
 		~group() noexcept override;
 
+		template <std::invocable F>
 		auto post(
-			job j,
+			F&& f,
 			id id = trace::make_loc_id(std::source_location::current())
 		) -> void;
 
@@ -91,46 +144,368 @@ export namespace gse::task {
 		id m_label;
 		std::uint64_t m_outer_parent = 0;
 		std::uint64_t m_parent_eid = 0;
-		tbb::task_group m_tbb_group;
+		std::atomic<std::size_t> m_pending{ 0 };
+	};
+}
+
+namespace gse::task {
+	template <typename T>
+	class promise;
+
+	class promise_base {
+	public:
+		struct final_awaiter {
+			static auto await_ready(
+			) noexcept -> bool {
+				return false;
+			}
+
+			template <typename P>
+			static auto await_suspend(
+				std::coroutine_handle<P> h
+			) noexcept -> std::coroutine_handle<> {
+				return h.promise().m_continuation;
+			}
+
+			static auto await_resume(
+			) noexcept -> void {}
+		};
+
+		static auto initial_suspend(
+		) noexcept -> std::suspend_always {
+			return {};
+		}
+
+		static auto final_suspend(
+		) noexcept -> final_awaiter {
+			return {};
+		}
+
+		auto unhandled_exception(
+		) noexcept -> void {
+			m_exception = std::current_exception();
+		}
+
+		auto set_continuation(
+			const std::coroutine_handle<> continuation
+		) noexcept -> void {
+			m_continuation = continuation;
+		}
+	protected:
+		auto rethrow_if_failed(
+		) const -> void {
+			if (m_exception) {
+				std::rethrow_exception(m_exception);
+			}
+		}
+	private:
+		std::coroutine_handle<> m_continuation = std::noop_coroutine();
+		std::exception_ptr m_exception;
+	};
+
+	template <typename T>
+	class promise final : public promise_base {
+	public:
+		auto get_return_object(
+		) noexcept -> task<T>;
+
+		template <typename U>
+		auto return_value(
+			U&& value
+		) -> void {
+			m_value.emplace(std::forward<U>(value));
+		}
+
+		auto result(
+		) -> T {
+			rethrow_if_failed();
+			return std::move(*m_value);
+		}
+	private:
+		std::optional<T> m_value;
+	};
+
+	template <>
+	class promise<void> final : public promise_base {
+	public:
+		auto get_return_object(
+		) noexcept -> task<>;
+
+		static auto return_void(
+		) noexcept -> void {}
+
+		auto result(
+		) const -> void {
+			rethrow_if_failed();
+		}
+	};
+
+	struct detached {
+		struct promise_type {
+			static auto get_return_object(
+			) noexcept -> detached {
+				return {};
+			}
+
+			static auto initial_suspend(
+			) noexcept -> std::suspend_never {
+				return {};
+			}
+
+			static auto final_suspend(
+			) noexcept -> std::suspend_never {
+				return {};
+			}
+
+			static auto return_void(
+			) noexcept -> void {}
+
+			static auto unhandled_exception(
+			) noexcept -> void {
+				std::println("Exception in detached task");
+			}
+		};
+	};
+
+	struct schedule_awaiter {
+		id label;
+
+		static auto await_ready(
+		) noexcept -> bool {
+			return false;
+		}
+
+		auto await_suspend(
+			std::coroutine_handle<> h
+		) const -> void {
+			submit(make_job([h] {
+				h.resume();
+			}, label, trace::current_eid(), nullptr));
+		}
+
+		static auto await_resume(
+		) noexcept -> void {}
+	};
+
+	template <typename T>
+	struct when_all_state {
+		using slot = std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>>;
+
+		explicit when_all_state(
+			const std::size_t count
+		) : remaining(count + 1), results(count), exceptions(count) {}
+
+		std::atomic<std::size_t> remaining;
+		std::coroutine_handle<> continuation;
+		std::vector<slot> results;
+		std::vector<std::exception_ptr> exceptions;
+
+		auto arrive(
+		) -> void {
+			if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				continuation.resume();
+			}
+		}
+	};
+
+	template <typename T>
+	auto run_child(
+		task<T> child,
+		when_all_state<T>& state,
+		std::size_t index,
+		id label
+	) -> detached;
+
+	template <typename T>
+	auto run_sync(
+		task<T> t,
+		std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>>& out,
+		std::exception_ptr& error,
+		std::atomic<std::size_t>& pending
+	) -> detached;
+
+	auto run_spawned(
+		task<> t,
+		id label
+	) -> detached;
+}
+
+export namespace gse::task {
+	template <typename T>
+	class task {
+	public:
+		using promise_type = promise<T>;
+		using handle_type = std::coroutine_handle<promise_type>;
+
+		task() = default;
+
+		explicit task(
+			const handle_type handle
+		) : m_handle(handle) {}
+
+		task(
+			task&& other
+		) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+		auto operator=(
+			task&& other
+		) noexcept -> task& {
+			if (this != &other) {
+				if (m_handle) {
+					m_handle.destroy();
+				}
+				m_handle = std::exchange(other.m_handle, {});
+			}
+			return *this;
+		}
+
+		~task() {
+			if (m_handle) {
+				m_handle.destroy();
+			}
+		}
+
+		auto operator co_await(
+		) && noexcept {
+			struct awaiter {
+				handle_type handle;
+
+				auto await_ready(
+				) const noexcept -> bool {
+					return !handle || handle.done();
+				}
+
+				auto await_suspend(
+					const std::coroutine_handle<> awaiting
+				) const noexcept -> std::coroutine_handle<> {
+					handle.promise().set_continuation(awaiting);
+					return handle;
+				}
+
+				auto await_resume(
+				) const -> T {
+					return handle.promise().result();
+				}
+			};
+
+			return awaiter{ m_handle };
+		}
+
+		auto valid(
+		) const noexcept -> bool {
+			return static_cast<bool>(m_handle);
+		}
+	private:
+		handle_type m_handle;
 	};
 }
 
 namespace gse::task {
-	std::unique_ptr<tbb::task_arena> arena;
-	std::unique_ptr<tbb::global_control> control;
+	struct worker_state;
+
+	class work_deque {
+	public:
+		auto push(
+			job_node* node
+		) noexcept -> bool;
+
+		auto pop(
+		) noexcept -> job_node*;
+
+		auto steal(
+		) noexcept -> job_node*;
+	private:
+		static constexpr std::int64_t capacity = 4096;
+		static constexpr std::int64_t mask = capacity - 1;
+
+		alignas(64) std::atomic<std::int64_t> m_top{ 0 };
+		alignas(64) std::atomic<std::int64_t> m_bottom{ 0 };
+		std::array<std::atomic<job_node*>, capacity> m_buffer{};
+	};
+
+	struct worker_state {
+		std::size_t index = 0;
+		work_deque deque;
+		std::jthread thread;
+	};
+
+	struct node_pool {
+		static constexpr std::size_t batch = 64;
+
+		job_node* head = nullptr;
+		std::size_t count = 0;
+
+		~node_pool();
+	};
+
+	std::vector<std::unique_ptr<worker_state>> workers;
+
+	std::mutex injection_mutex;
+	std::deque<job_node*> injection;
+	std::atomic<std::size_t> injection_count{ 0 };
+
+	std::mutex pool_mutex;
+	std::vector<std::unique_ptr<job_node[]>> node_slabs;
+	job_node* shared_free = nullptr;
+
+	std::atomic<std::uint64_t> work_epoch{ 0 };
+	std::atomic<std::uint32_t> sleeping{ 0 };
 
 	std::atomic started = false;
 	std::atomic stopping = false;
 
 	std::atomic<std::size_t> in_flight{ 0 };
 
-	std::mutex idle;
-	std::condition_variable idle_cv;
-
 	std::size_t chunk_size = 256;
 	std::size_t coalesce_threshold = 64;
+	std::size_t spin_count = 64;
 
 	thread_local std::optional<std::size_t> local_worker_id = std::nullopt;
+	thread_local worker_state* local_worker = nullptr;
+	thread_local node_pool local_pool;
 
-	struct parent {
-		std::uint64_t forced_eid = 0;
-	};
+	auto release_node(
+		job_node* node
+	) -> void;
+
+	auto find_work(
+	) -> job_node*;
 
-	auto enqueue(
-		job j,
-		id id,
-		parent parent
+	auto execute(
+		job_node* node
 	) -> void;
 
-	auto current_worker_id(
-	) noexcept -> std::optional<std::size_t>;
+	auto complete(
+		std::atomic<std::size_t>& pending
+	) -> void;
 
-	auto likely_idle(
-	) noexcept -> bool;
+	auto signal_work(
+	) -> void;
 
-	auto async_key(
-		const void* p
-	) -> std::uint64_t;
+	auto wait_for_work(
+		std::uint64_t epoch
+	) -> void;
+
+	auto worker_loop(
+		const std::stop_token& stop,
+		worker_state& self
+	) -> void;
+
+	auto start_workers(
+		std::size_t worker_count
+	) -> void;
+
+	auto stop_workers(
+	) -> void;
+}
+
+template <typename T>
+auto gse::task::promise<T>::get_return_object() noexcept -> task<T> {
+	return task<T>(std::coroutine_handle<promise>::from_promise(*this));
+}
+
+auto gse::task::promise<void>::get_return_object() noexcept -> task<> {
+	return task(std::coroutine_handle<promise>::from_promise(*this));
 }
 
 gse::task::group::group(const id label) : m_label(label) {
@@ -144,25 +519,20 @@ gse::task::group::~group() noexcept {
 }
 
 auto gse::task::group::wait() -> void {
-	m_tbb_group.wait();
+	help_until(m_pending);
 }
 
-auto gse::task::group::post(job j, const id id) -> void {
-	const std::uint64_t parent_eid = m_parent_eid;
+template <std::invocable F>
+auto gse::task::group::post(F&& f, const id id) -> void {
+	m_pending.fetch_add(1, std::memory_order_relaxed);
+	submit(make_job(std::forward<F>(f), id, m_parent_eid, &m_pending));
+}
 
-	m_tbb_group.run([j = std::move(j), id, parent_eid] {
-		try {
-			trace::scope(id, [&] {
-				j();
-			}, parent_eid);
-		}
-		catch (const std::exception& e) {
-			std::println("Exception in task: {}", e.what());
-		}
-		catch (...) {
-			std::println("Exception in task");
-		}
-	});
+template <std::input_iterator It>
+auto gse::task::group::post_range(It first, It last, const id id) -> void {
+	for (; first != last; ++first) {
+		this->post(*first, id);
+	}
 }
 
 template <typename F>
@@ -190,22 +560,14 @@ auto gse::task::start(F&& fn, std::size_t worker_count) -> std::invoke_result_t<
 		}
 	}
 
-	arena.reset();
-	control.reset();
-
-	arena = std::make_unique<tbb::task_arena>(static_cast<int>(worker_count));
-	control = std::make_unique<tbb::global_control>(
-		tbb::global_control::max_allowed_parallelism,
-		static_cast<int>(worker_count)
-	);
+	start_workers(worker_count);
 
 	auto guard = make_scope_exit([] {
 		if (!started.load()) return;
 		if (stopping.exchange(true)) return;
 
 		wait_idle();
-		control.reset();
-		arena.reset();
+		stop_workers();
 
 		stopping.store(false, std::memory_order_release);
 		started.store(false, std::memory_order_release);
@@ -226,22 +588,16 @@ auto gse::task::start(F&& fn, std::size_t worker_count) -> std::invoke_result_t<
 	}
 }
 
-auto gse::task::post(job j, const id id) -> void {
-	const parent parent{
-		.forced_eid = trace::current_eid()
-	};
-
-	enqueue(std::move(j), id, parent);
+template <std::invocable F>
+auto gse::task::post(F&& f, const id id) -> void {
+	in_flight.fetch_add(1, std::memory_order_relaxed);
+	submit(make_job(std::forward<F>(f), id, trace::current_eid(), &in_flight));
 }
 
 template <std::input_iterator It>
 auto gse::task::post_range(It first, It last, const id id) -> void {
 	for (; first != last; ++first) {
-		parent parent{
-			.forced_eid = trace::current_eid()
-		};
-
-		enqueue(job(*first), id, std::move(parent));
+		post(*first, id);
 	}
 }
 
@@ -253,29 +609,45 @@ auto gse::task::parallel_for_impl(const std::size_t first, const std::size_t las
 	const std::size_t n = last - first;
 
 	trace::scope(id, [&] {
-		if (n <= coalesce_threshold) {
+		if (n <= coalesce_threshold || workers.empty()) {
 			for (std::size_t i = first; i < last; ++i) {
-				trace::scope(id, [&] {
-					func(i);
-				});
+				func(i);
 			}
 			return;
 		}
 
-		arena->execute([&] {
-			tbb::parallel_for(
-				tbb::blocked_range(first, last, chunk_size),
-				[&](const tbb::blocked_range<std::size_t>& r) {
-					trace::scope(id, [&] {
-						for (std::size_t i = r.begin(); i != r.end(); ++i) {
-							trace::scope(id, [&] {
-								func(i);
-							});
-						}
-					});
+		const std::size_t grain = std::clamp<std::size_t>(n / thread_count(), 1, chunk_size);
+		const std::size_t chunks = (n + grain - 1) / grain;
+
+		std::atomic next = first;
+		auto drain = [&] {
+			while (true) {
+				const std::size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+				if (begin >= last) {
+					return;
 				}
-			);
-		});
+
+				const std::size_t end = std::min(last, begin + grain);
+				trace::scope<trace::level::detailed>(id, [&] {
+					for (std::size_t i = begin; i != end; ++i) {
+						func(i);
+					}
+				});
+			}
+		};
+
+		const std::size_t helpers = std::min(chunks, thread_count()) - 1;
+		const std::uint64_t parent_eid = trace::current_eid();
+
+		std::atomic pending = helpers;
+		for (std::size_t h = 0; h < helpers; ++h) {
+			submit(make_job([&drain] {
+				drain();
+			}, id, parent_eid, &pending));
+		}
+
+		drain();
+		help_until(pending);
 	});
 }
 
@@ -297,16 +669,9 @@ auto gse::task::parallel_for(first_arg_t<F> first, first_arg_t<F> last, F&& func
 	);
 }
 
-template <std::input_iterator It>
-auto gse::task::group::post_range(It first, It last, const id id) -> void {
-	for (; first != last; ++first) {
-		this->post(job(*first), id);
-	}
-}
-
 auto gse::task::thread_count() -> size_t {
-	if (arena) {
-		return static_cast<size_t>(arena->max_concurrency());
+	if (!workers.empty()) {
+		return workers.size();
 	}
 
 	return std::max<std::size_t>(2, std::thread::hardware_concurrency());
@@ -316,8 +681,8 @@ auto gse::task::current_worker() noexcept -> std::optional<std::size_t> {
 	const auto n = thread_count();
 	if (n == 0) return 0;
 
-	if (const auto id = current_worker_id(); id.has_value()) {
-		return *id % n;
+	if (local_worker_id.has_value()) {
+		return *local_worker_id % n;
 	}
 
 	const auto h = std::hash<std::thread::id>{}(std::this_thread::get_id());
@@ -325,74 +690,449 @@ auto gse::task::current_worker() noexcept -> std::optional<std::size_t> {
 }
 
 auto gse::task::wait_idle() -> void {
-	for (int i = 0; i < 1024; ++i) {
-		if (likely_idle()) {
-			return;
+	help_until(in_flight);
+}
+
+auto gse::task::schedule(const id id) {
+	return schedule_awaiter{ .label = id };
+}
+
+template <typename T>
+auto gse::task::when_all(std::vector<task<T>> tasks, const id id) -> task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> {
+	when_all_state<T> state(tasks.size());
+
+	struct join_awaiter {
+		when_all_state<T>& state;
+		std::vector<task<T>>& tasks;
+		gse::id label;
+
+		static auto await_ready(
+		) noexcept -> bool {
+			return false;
+		}
+
+		auto await_suspend(
+			const std::coroutine_handle<> h
+		) const -> bool {
+			state.continuation = h;
+			for (std::size_t i = 0; i < tasks.size(); ++i) {
+				run_child(std::move(tasks[i]), state, i, label);
+			}
+			return state.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+		}
+
+		static auto await_resume(
+		) noexcept -> void {}
+	};
+
+	co_await join_awaiter{ state, tasks, id };
+
+	for (const auto& e : state.exceptions) {
+		if (e) {
+			std::rethrow_exception(e);
 		}
-		std::this_thread::yield();
 	}
 
-	std::unique_lock lk(idle);
-	idle_cv.wait(lk, [] {
-		return likely_idle();
-	});
+	if constexpr (!std::is_void_v<T>) {
+		std::vector<T> out;
+		out.reserve(state.results.size());
+		for (auto& r : state.results) {
+			out.push_back(std::move(*r));
+		}
+		co_return out;
+	}
 }
 
-auto gse::task::enqueue(job j, id id, parent parent) -> void {
+template <typename T>
+auto gse::task::sync_wait(task<T> t) -> T {
+	std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>> out;
+	std::exception_ptr error;
+	std::atomic<std::size_t> pending{ 1 };
+
+	run_sync(std::move(t), out, error, pending);
+	help_until(pending);
+
+	if (error) {
+		std::rethrow_exception(error);
+	}
+
+	if constexpr (!std::is_void_v<T>) {
+		return std::move(*out);
+	}
+}
+
+auto gse::task::spawn(task<> t, const id id) -> void {
 	in_flight.fetch_add(1, std::memory_order_relaxed);
+	run_spawned(std::move(t), id);
+}
+
+template <typename T>
+auto gse::task::run_child(task<T> child, when_all_state<T>& state, const std::size_t index, const id label) -> detached {
+	co_await schedule(label);
+
+	try {
+		if constexpr (std::is_void_v<T>) {
+			co_await std::move(child);
+		} else {
+			state.results[index].emplace(co_await std::move(child));
+		}
+	} catch (...) {
+		state.exceptions[index] = std::current_exception();
+	}
+
+	state.arrive();
+}
+
+template <typename T>
+auto gse::task::run_sync(task<T> t, std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>>& out, std::exception_ptr& error, std::atomic<std::size_t>& pending) -> detached {
+	try {
+		if constexpr (std::is_void_v<T>) {
+			co_await std::move(t);
+		} else {
+			out.emplace(co_await std::move(t));
+		}
+	} catch (...) {
+		error = std::current_exception();
+	}
+
+	complete(pending);
+}
+
+auto gse::task::run_spawned(task<> t, const id label) -> detached {
+	co_await schedule(label);
+
+	try {
+		co_await std::move(t);
+	} catch (const std::exception& e) {
+		std::println("Exception in task: {}", e.what());
+	} catch (...) {
+		std::println("Exception in task");
+	}
+
+	complete(in_flight);
+}
+
+template <typename F>
+auto gse::task::make_job(F&& f, const id label, const std::uint64_t parent_eid, std::atomic<std::size_t>* pending) -> job_node* {
+	using fn = std::decay_t<F>;
+
+	job_node* node = acquire_node();
+	node->label = label;
+	node->parent_eid = parent_eid;
+	node->pending = pending;
+
+	if constexpr (sizeof(fn) <= job_node::inline_size && alignof(fn) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<fn>) {
+		std::construct_at(reinterpret_cast<fn*>(node->storage.data()), std::forward<F>(f));
+		node->invoke = [](job_node& n) {
+			(*std::launder(reinterpret_cast<fn*>(n.storage.data())))();
+		};
+		node->destroy = [](job_node& n) {
+			std::destroy_at(std::launder(reinterpret_cast<fn*>(n.storage.data())));
+		};
+	} else {
+		std::construct_at(reinterpret_cast<fn**>(node->storage.data()), new fn(std::forward<F>(f)));
+		node->invoke = [](job_node& n) {
+			(**std::launder(reinterpret_cast<fn**>(n.storage.data())))();
+		};
+		node->destroy = [](job_node& n) {
+			delete *std::launder(reinterpret_cast<fn**>(n.storage.data()));
+		};
+	}
+
+	return node;
+}
+
+auto gse::task::acquire_node() -> job_node* {
+	auto& pool = local_pool;
 
-	const auto key = async_key(&j);
-	trace::begin_async(id, key);
+	if (!pool.head) {
+		std::lock_guard lock(pool_mutex);
 
-	arena->enqueue([j = std::move(j), id, key, parent = std::move(parent)] {
-		trace::end_async(id, key);
+		for (std::size_t i = 0; i < node_pool::batch && shared_free; ++i) {
+			job_node* node = std::exchange(shared_free, shared_free->next);
+			node->next = pool.head;
+			pool.head = node;
+			++pool.count;
+		}
 
-		auto flight_done = make_scope_exit([] {
-			if (in_flight.fetch_sub(1, std::memory_order_acq_rel) == 1) {
-				std::scoped_lock lk(idle);
-				idle_cv.notify_all();
+		if (!pool.head) {
+			auto& slab = node_slabs.emplace_back(std::make_unique<job_node[]>(node_pool::batch));
+			for (std::size_t i = 0; i < node_pool::batch; ++i) {
+				slab[i].next = pool.head;
+				pool.head = &slab[i];
 			}
-		});
+			pool.count += node_pool::batch;
+		}
+	}
+
+	job_node* node = std::exchange(pool.head, pool.head->next);
+	--pool.count;
+	return node;
+}
+
+auto gse::task::release_node(job_node* node) -> void {
+	auto& pool = local_pool;
+
+	node->next = pool.head;
+	pool.head = node;
+
+	if (++pool.count <= node_pool::batch * 2) {
+		return;
+	}
+
+	std::lock_guard lock(pool_mutex);
+	for (std::size_t i = 0; i < node_pool::batch; ++i) {
+		job_node* spilled = std::exchange(pool.head, pool.head->next);
+		spilled->next = shared_free;
+		shared_free = spilled;
+	}
+	pool.count -= node_pool::batch;
+}
+
+gse::task::node_pool::~node_pool() {
+	if (!head) {
+		return;
+	}
+
+	std::lock_guard lock(pool_mutex);
+	while (head) {
+		job_node* node = std::exchange(head, head->next);
+		node->next = shared_free;
+		shared_free = node;
+	}
+}
+
+auto gse::task::submit(job_node* node) -> void {
+	if (!local_worker || !local_worker->deque.push(node)) {
+		std::lock_guard lock(injection_mutex);
+		injection.push_back(node);
+		injection_count.fetch_add(1, std::memory_order_release);
+	}
 
-		const std::uint64_t parent_eid = parent.forced_eid;
+	signal_work();
+}
 
-		try {
-			trace::scope(id, [&] {
-				j();
-			}, parent_eid);
-		} catch (const std::exception& e) {
-			std::println("Exception in task: {}", e.what());
-		} catch (...) {
-			std::println("Exception in task");
+auto gse::task::find_work() -> job_node* {
+	if (local_worker) {
+		if (job_node* node = local_worker->deque.pop()) {
+			return node;
 		}
-	});
+	}
+
+	if (injection_count.load(std::memory_order_acquire) > 0) {
+		std::lock_guard lock(injection_mutex);
+		if (!injection.empty()) {
+			job_node* node = injection.front();
+			injection.pop_front();
+			injection_count.fetch_sub(1, std::memory_order_relaxed);
+			return node;
+		}
+	}
+
+	const std::size_t count = workers.size();
+	if (count == 0) {
+		return nullptr;
+	}
+
+	const std::size_t offset = local_worker_id.value_or(0) + 1;
+	for (std::size_t i = 0; i < count; ++i) {
+		worker_state& victim = *workers[(offset + i) % count];
+		if (&victim == local_worker) {
+			continue;
+		}
+
+		if (job_node* node = victim.deque.steal()) {
+			return node;
+		}
+	}
+
+	return nullptr;
+}
+
+auto gse::task::execute(job_node* node) -> void {
+	try {
+		trace::scope(node->label, [&] {
+			node->invoke(*node);
+		}, node->parent_eid);
+	} catch (const std::exception& e) {
+		std::println("Exception in task: {}", e.what());
+	} catch (...) {
+		std::println("Exception in task");
+	}
+
+	std::atomic<std::size_t>* pending = node->pending;
+	node->destroy(*node);
+	release_node(node);
+
+	if (pending) {
+		complete(*pending);
+	}
 }
 
-auto gse::task::current_worker_id() noexcept -> std::optional<std::size_t> {
-	return local_worker_id;
+auto gse::task::complete(std::atomic<std::size_t>& pending) -> void {
+	if (pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+
+	work_epoch.fetch_add(1, std::memory_order_seq_cst);
+	if (sleeping.load(std::memory_order_seq_cst) > 0) {
+		work_epoch.notify_all();
+	}
 }
 
-auto gse::task::likely_idle() noexcept -> bool {
-	return in_flight.load(std::memory_order_acquire) == 0;
+auto gse::task::signal_work() -> void {
+	work_epoch.fetch_add(1, std::memory_order_seq_cst);
+	if (sleeping.load(std::memory_order_seq_cst) > 0) {
+		work_epoch.notify_one();
+	}
 }
 
-auto gse::task::async_key(const void* p) -> std::uint64_t {
-	const std::uint64_t x = reinterpret_cast<std::uintptr_t>(p);
+auto gse::task::wait_for_work(const std::uint64_t epoch) -> void {
+	sleeping.fetch_add(1, std::memory_order_seq_cst);
+	work_epoch.wait(epoch, std::memory_order_seq_cst);
+	sleeping.fetch_sub(1, std::memory_order_relaxed);
+}
 
-	auto mix = [](std::uint64_t v) {
-		v += 0x9E3779B97F4A7C15ull;
-		v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ull;
-		v = (v ^ (v >> 27)) * 0x94D049BB133111EBull;
-		v ^= (v >> 31);
-		return v;
-	};
+auto gse::task::help_until(const std::atomic<std::size_t>& pending) -> void {
+	std::size_t idle_spins = 0;
+
+	while (pending.load(std::memory_order_acquire) != 0) {
+		const std::uint64_t epoch = work_epoch.load(std::memory_order_seq_cst);
+
+		if (job_node* node = find_work()) {
+			execute(node);
+			idle_spins = 0;
+			continue;
+		}
+
+		if (pending.load(std::memory_order_acquire) == 0) {
+			return;
+		}
+
+		if (++idle_spins < spin_count) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		wait_for_work(epoch);
+	}
+}
+
+auto gse::task::worker_loop(const std::stop_token& stop, worker_state& self) -> void {
+	local_worker = &self;
+	local_worker_id = self.index;
 
-	std::uint64_t k = mix(x);
+	std::size_t idle_spins = 0;
 
-	if (k == 0) {
-		static std::atomic<std::uint64_t> seq{ 1 };
-		k = mix(seq.fetch_add(1, std::memory_order_relaxed));
+	while (!stop.stop_requested()) {
+		const std::uint64_t epoch = work_epoch.load(std::memory_order_seq_cst);
+
+		if (job_node* node = find_work()) {
+			execute(node);
+			idle_spins = 0;
+			continue;
+		}
+
+		if (++idle_spins < spin_count) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		if (!stop.stop_requested()) {
+			wait_for_work(epoch);
+		}
+	}
+
+	local_worker = nullptr;
+	local_worker_id = std::nullopt;
+}
+
+auto gse::task::start_workers(const std::size_t worker_count) -> void {
+	workers.reserve(worker_count);
+	for (std::size_t i = 0; i < worker_count; ++i) {
+		auto& w = workers.emplace_back(std::make_unique<worker_state>());
+		w->index = i;
+	}
+
+	local_worker = workers.front().get();
+	local_worker_id = 0;
+
+	for (std::size_t i = 1; i < worker_count; ++i) {
+		worker_state& w = *workers[i];
+		w.thread = std::jthread([&w](const std::stop_token& stop) {
+			worker_loop(stop, w);
+		});
+	}
+}
+
+auto gse::task::stop_workers() -> void {
+	for (const auto& w : workers) {
+		w->thread.request_stop();
+	}
+
+	work_epoch.fetch_add(1, std::memory_order_seq_cst);
+	work_epoch.notify_all();
+
+	for (const auto& w : workers) {
+		if (w->thread.joinable()) {
+			w->thread.join();
+		}
 	}
 
-	return k;
-}
\ No newline at end of file
+	local_worker = nullptr;
+	local_worker_id = std::nullopt;
+	workers.clear();
+}
+
+auto gse::task::work_deque::push(job_node* node) noexcept -> bool {
+	const std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+	const std::int64_t t = m_top.load(std::memory_order_acquire);
+
+	if (b - t >= capacity) {
+		return false;
+	}
+
+	m_buffer[b & mask].store(node, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
+}
+
+auto gse::task::work_deque::pop() noexcept -> job_node* {
+	const std::int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+	m_bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t t = m_top.load(std::memory_order_relaxed);
+
+	if (t > b) {
+		m_bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	job_node* node = m_buffer[b & mask].load(std::memory_order_relaxed);
+	if (t == b) {
+		if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			node = nullptr;
+		}
+		m_bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	return node;
+}
+
+auto gse::task::work_deque::steal() noexcept -> job_node* {
+	std::int64_t t = m_top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const std::int64_t b = m_bottom.load(std::memory_order_acquire);
+
+	if (t >= b) {
+		return nullptr;
+	}
+
+	job_node* node = m_buffer[t & mask].load(std::memory_order_relaxed);
+	if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr;
+	}
+
+	return node;
+}
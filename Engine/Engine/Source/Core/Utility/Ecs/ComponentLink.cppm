@@ -3,6 +3,7 @@ export module gse.utility:component_link;
 import std;
 
 import :id;
+import :entity;
 import :component;
 import :misc;
 import :frame_sync;
@@ -14,7 +15,8 @@ export namespace gse {
 		virtual ~component_link_base() = default;
 
 		virtual auto activate(
-			id id
+			id id,
+			std::uint32_t entity_index
 		) -> bool = 0;
 
 		virtual auto remove(
@@ -29,6 +31,10 @@ export namespace gse {
 		virtual auto flip(
 			std::size_t read,
 			std::size_t write
+		) -> std::size_t = 0;
+
+		virtual auto set_flip_mode(
+			flip_mode mode
 		) -> void = 0;
 	};
 }
@@ -52,7 +58,8 @@ export namespace gse {
 		) -> T*;
 
 		auto activate(
-			owner_id_t owner_id
+			owner_id_t owner_id,
+			std::uint32_t entity_index
 		) -> bool override;
 
 		auto remove(
@@ -65,6 +72,12 @@ export namespace gse {
 		auto objects_write(
 		) -> std::span<component_type>;
 
+		auto storage_read(
+		) -> sparse_span<const component_type>;
+
+		auto storage_write(
+		) -> sparse_span<component_type>;
+
 		auto try_get_read(
 			owner_id_t owner_id
 		) -> const component_type*;
@@ -73,6 +86,14 @@ export namespace gse {
 			owner_id_t owner_id
 		) -> component_type*;
 
+		auto try_get_read(
+			const entity& handle
+		) -> const component_type*;
+
+		auto try_get_write(
+			const entity& handle
+		) -> component_type*;
+
 		auto try_get_by_link_id_read(
 			const link_id_t& link_id
 		) -> const T*;
@@ -89,6 +110,10 @@ export namespace gse {
 		auto flip(
 			std::size_t read,
 			std::size_t write
+		) -> std::size_t override;
+
+		auto set_flip_mode(
+			flip_mode mode
 		) -> void override;
 
 		auto mark_updated(
@@ -115,6 +140,7 @@ export namespace gse {
 		std::vector<owner_id_t> m_added;
 		std::unordered_set<owner_id_t> m_updated;
 		mutable std::mutex m_updated_mutex;
+		std::vector<std::uint64_t> m_updated_entities;
 		std::vector<owner_id_t> m_removed;
 	};
 }
@@ -136,8 +162,12 @@ auto gse::component_link<T>::add(const owner_id_t owner_id, registry* reg, Args&
 }
 
 template <gse::is_component T>
-auto gse::component_link<T>::activate(const owner_id_t owner_id) -> bool {
-	if (m_writer.activate(owner_id)) {
+auto gse::component_link<T>::activate(const owner_id_t owner_id, const std::uint32_t entity_index) -> bool {
+	if (entity_index != sparse_span<T>::null_index && entity_index / 64 >= m_updated_entities.size()) {
+		m_updated_entities.resize(entity_index / 64 + 1, 0);
+	}
+
+	if (m_writer.activate(owner_id, entity_index)) {
 		m_added.push_back(owner_id);
 		m_reader.emplace_from_writer(owner_id);
 		return true;
@@ -168,6 +198,16 @@ auto gse::component_link<T>::objects_write() -> std::span<component_type> {
 	return m_writer.objects();
 }
 
+template <gse::is_component T>
+auto gse::component_link<T>::storage_read() -> sparse_span<const component_type> {
+	return m_reader.storage();
+}
+
+template <gse::is_component T>
+auto gse::component_link<T>::storage_write() -> sparse_span<component_type> {
+	return m_writer.storage();
+}
+
 template <gse::is_component T>
 auto gse::component_link<T>::try_get_read(const owner_id_t owner_id) -> const component_type* {
 	return m_reader.try_get(owner_id);
@@ -183,6 +223,20 @@ auto gse::component_link<T>::try_get_write(const owner_id_t owner_id) -> compone
 	return nullptr;
 }
 
+template <gse::is_component T>
+auto gse::component_link<T>::try_get_read(const entity& handle) -> const component_type* {
+	return m_reader.try_get(handle.index);
+}
+
+template <gse::is_component T>
+auto gse::component_link<T>::try_get_write(const entity& handle) -> component_type* {
+	auto* p = m_writer.try_get(handle.index);
+	if (p && handle.index / 64 < m_updated_entities.size()) {
+		std::atomic_ref(m_updated_entities[handle.index / 64]).fetch_or(std::uint64_t{ 1 } << (handle.index % 64), std::memory_order_relaxed);
+	}
+	return p;
+}
+
 template <gse::is_component T>
 auto gse::component_link<T>::try_get_by_link_id_read(const link_id_t& link_id) -> const component_type* {
 	if (const auto it = m_link_to_owner_map.find(link_id); it != m_link_to_owner_map.end()) {
@@ -205,9 +259,15 @@ auto gse::component_link<T>::bind(const std::size_t read_index, const std::size_
 }
 
 template <gse::is_component T>
-auto gse::component_link<T>::flip(std::size_t read, std::size_t write) -> void {
-	m_dbq.flip();
+auto gse::component_link<T>::flip(std::size_t read, std::size_t write) -> std::size_t {
+	const auto copied = m_dbq.flip();
 	std::tie(m_reader, m_writer) = m_dbq.bind(read, write);
+	return copied;
+}
+
+template <gse::is_component T>
+auto gse::component_link<T>::set_flip_mode(const flip_mode mode) -> void {
+	m_dbq.set_flip_mode(mode);
 }
 
 template <gse::is_component T>
@@ -234,6 +294,16 @@ auto gse::component_link<T>::drain_updates() -> std::vector<owner_id_t> {
 		m_updated.clear();
 	}
 
+	const auto storage = m_writer.storage();
+	for (std::size_t word = 0; word < m_updated_entities.size(); ++word) {
+		for (auto bits = std::atomic_ref(m_updated_entities[word]).exchange(0, std::memory_order_relaxed); bits != 0; bits &= bits - 1) {
+			const auto entity_index = word * 64 + std::countr_zero(bits);
+			if (entity_index < storage.sparse.size() && storage.sparse[entity_index] != sparse_span<T>::null_index) {
+				snapshot.insert(storage.items[storage.sparse[entity_index]].owner_id());
+			}
+		}
+	}
+
 	std::vector<owner_id_t> out;
 	out.reserve(snapshot.size());
 	for (const auto& id : snapshot) {
@@ -4,6 +4,7 @@ import std;
 
 import :concepts;
 import :registry;
+import :entity;
 import :id;
 import :n_buffer;
 import :channel_base;
@@ -127,30 +128,100 @@ export namespace gse {
 		using reference = T&;
 		using const_reference = const T&;
 
+		class iterator {
+		public:
+			using iterator_concept = std::random_access_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = std::remove_const_t<T>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = T*;
+			using reference = T&;
+
+			iterator() = default;
+			iterator(const chunk* owner, const difference_type index) : m_owner(owner), m_index(index) {}
+
+			auto operator*() const -> reference { return m_owner->touch(static_cast<std::size_t>(m_index)); }
+			auto operator->() const -> pointer { return std::addressof(**this); }
+			auto operator[](const difference_type n) const -> reference { return *(*this + n); }
+
+			auto operator++() -> iterator& { ++m_index; return *this; }
+			auto operator++(int) -> iterator { auto copy = *this; ++m_index; return copy; }
+			auto operator--() -> iterator& { --m_index; return *this; }
+			auto operator--(int) -> iterator { auto copy = *this; --m_index; return copy; }
+			auto operator+=(const difference_type n) -> iterator& { m_index += n; return *this; }
+			auto operator-=(const difference_type n) -> iterator& { m_index -= n; return *this; }
+
+			friend auto operator+(iterator it, const difference_type n) -> iterator { return it += n; }
+			friend auto operator+(const difference_type n, iterator it) -> iterator { return it += n; }
+			friend auto operator-(iterator it, const difference_type n) -> iterator { return it -= n; }
+			friend auto operator-(const iterator& a, const iterator& b) -> difference_type { return a.m_index - b.m_index; }
+			friend auto operator==(const iterator& a, const iterator& b) -> bool { return a.m_index == b.m_index; }
+			friend auto operator<=>(const iterator& a, const iterator& b) -> std::strong_ordering { return a.m_index <=> b.m_index; }
+		private:
+			const chunk* m_owner = nullptr;
+			difference_type m_index = 0;
+		};
+
 		explicit chunk(std::span<T> span) : m_span(span) {}
+		explicit chunk(sparse_span<T> storage, const registry* reg = nullptr) : m_span(storage.items), m_storage(storage), m_registry(reg) {}
 
-		auto begin() -> auto { return m_span.begin(); }
-		auto end() -> auto { return m_span.end(); }
+		auto begin() -> iterator { return iterator(this, 0); }
+		auto end() -> iterator { return iterator(this, static_cast<std::ptrdiff_t>(m_span.size())); }
 		auto begin() const -> auto { return m_span.begin(); }
 		auto end() const -> auto { return m_span.end(); }
 
 		auto size() const -> std::size_t { return m_span.size(); }
 		auto empty() const -> bool { return m_span.empty(); }
-		auto data() -> pointer { return m_span.data(); }
 		auto data() const -> const_pointer { return m_span.data(); }
 
-		auto operator[](std::size_t i) -> reference { return m_span[i]; }
+		auto data() -> pointer {
+			m_storage.mark_all_dirty();
+			return m_span.data();
+		}
+
+		auto operator[](std::size_t i) -> reference { return touch(i); }
 		auto operator[](std::size_t i) const -> const_reference { return m_span[i]; }
 
+		auto index_of(const_reference item) const -> std::size_t {
+			return static_cast<std::size_t>(std::addressof(item) - m_span.data());
+		}
+
+		auto storage() const -> sparse_span<T> { return m_storage; }
+
 		auto find(const id owner) -> pointer {
-			build_lookup();
-			if (const auto it = m_lookup->find(owner); it != m_lookup->end()) {
-				return it->second;
+			auto* item = locate(owner);
+			if (item) {
+				m_storage.mark_dirty(index_of(*item));
 			}
-			return nullptr;
+			return item;
 		}
 
 		auto find(const id owner) const -> const_pointer {
+			return locate(owner);
+		}
+
+		auto find(const entity& handle) -> pointer {
+			return m_storage.try_get(handle.index);
+		}
+
+		auto find(const entity& handle) const -> const_pointer {
+			return slot_of(handle.index);
+		}
+
+	private:
+		auto slot_of(const std::uint32_t entity_index) const -> pointer {
+			if (entity_index >= m_storage.sparse.size() || m_storage.sparse[entity_index] == sparse_span<T>::null_index) {
+				return nullptr;
+			}
+			return std::addressof(m_span[m_storage.sparse[entity_index]]);
+		}
+
+		auto locate(const id owner) const -> pointer {
+			if (m_registry) {
+				const auto handle = m_registry->handle(owner);
+				return handle ? slot_of(handle->index) : nullptr;
+			}
+
 			const_cast<chunk*>(this)->build_lookup();
 			if (const auto it = m_lookup->find(owner); it != m_lookup->end()) {
 				return it->second;
@@ -158,7 +229,11 @@ export namespace gse {
 			return nullptr;
 		}
 
-	private:
+		auto touch(const std::size_t i) const -> reference {
+			m_storage.mark_dirty(i);
+			return m_span[i];
+		}
+
 		auto build_lookup() -> void {
 			if (m_lookup) return;
 			m_lookup.emplace();
@@ -169,9 +244,70 @@ export namespace gse {
 		}
 
 		std::span<T> m_span;
+		sparse_span<T> m_storage;
+		const registry* m_registry = nullptr;
 		mutable std::optional<std::unordered_map<id, pointer>> m_lookup;
 	};
 
+	template <typename... Ts>
+	class view {
+	public:
+		explicit view(sparse_span<Ts>... storages) : m_storages(storages...) {}
+		explicit view(chunk<Ts>&... chunks) : m_storages(chunks.storage()...) {}
+
+		class iterator {
+		public:
+			using value_type = std::tuple<Ts&...>;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() = default;
+			iterator(const view* owner, const std::size_t index) : m_view(owner), m_index(index) { seek(); }
+
+			auto operator*() const -> value_type {
+				return std::apply([](auto*... ptrs) { return value_type(*ptrs...); }, m_current);
+			}
+
+			auto operator++() -> iterator& {
+				++m_index;
+				seek();
+				return *this;
+			}
+
+			auto operator++(int) -> void { ++*this; }
+
+			auto operator==(std::default_sentinel_t) const -> bool {
+				return m_index >= std::get<0>(m_view->m_storages).items.size();
+			}
+
+		private:
+			auto seek() -> void {
+				const auto& lead = std::get<0>(m_view->m_storages);
+				for (; m_index < lead.items.size(); ++m_index) {
+					if (resolve(lead.dense_to_sparse[m_index], std::index_sequence_for<Ts...>{})) return;
+				}
+			}
+
+			template <std::size_t... Is>
+			auto resolve(const std::uint32_t sparse_index, std::index_sequence<Is...>) -> bool {
+				m_current = { std::get<Is>(m_view->m_storages).try_get(sparse_index)... };
+				return ((std::get<Is>(m_current) != nullptr) && ...);
+			}
+
+			const view* m_view = nullptr;
+			std::size_t m_index = 0;
+			std::tuple<Ts*...> m_current{};
+		};
+
+		auto begin() const -> iterator { return iterator(this, 0); }
+		auto end() const -> std::default_sentinel_t { return {}; }
+
+	private:
+		std::tuple<sparse_span<Ts>...> m_storages;
+	};
+
+	template <typename... Ts>
+	view(chunk<Ts>&...) -> view<Ts...>;
+
 	struct queued_work {
 		id name;
 		std::vector<std::type_index> reads;
@@ -248,11 +384,39 @@ export namespace gse {
 		static auto make_chunk(registry& reg) -> ChunkArg {
 			using element_t = chunk_element_t<ChunkArg>;
 
-			if constexpr (is_read_chunk_v<ChunkArg>) {
-				return ChunkArg(reg.linked_objects_read<element_t>());
+			if constexpr (is_view_v<ChunkArg>) {
+				return make_view(reg, std::type_identity<std::remove_cvref_t<ChunkArg>>{});
+			}
+			else if constexpr (is_read_chunk_v<ChunkArg>) {
+				if constexpr (is_component<element_t>) {
+					return ChunkArg(reg.linked_storage_read<element_t>(), &reg);
+				}
+				else {
+					return ChunkArg(reg.linked_objects_read<element_t>());
+				}
+			}
+			else {
+				if constexpr (is_component<element_t>) {
+					return ChunkArg(reg.linked_storage_write<element_t>(), &reg);
+				}
+				else {
+					return ChunkArg(reg.linked_objects_write<element_t>());
+				}
+			}
+		}
+
+		template <typename... Ts>
+		static auto make_view(registry& reg, std::type_identity<view<Ts...>>) -> view<Ts...> {
+			return view<Ts...>(make_storage<Ts>(reg)...);
+		}
+
+		template <typename T>
+		static auto make_storage(registry& reg) -> sparse_span<T> {
+			if constexpr (std::is_const_v<T>) {
+				return reg.linked_storage_read<std::remove_const_t<T>>();
 			}
 			else {
-				return ChunkArg(reg.linked_objects_write<element_t>());
+				return reg.linked_storage_write<T>();
 			}
 		}
 
@@ -6,12 +6,109 @@ import :id;
 import :non_copyable;
 import :misc;
 import :frame_sync;
+import :trace;
 
 import :entity;
 import :concepts;
 import :component_link;
 import :hook_link;
 
+namespace gse {
+	template <typename T>
+	inline constexpr char link_type_tag = 0;
+
+	template <typename T>
+	auto link_type_key(
+	) -> std::uint64_t;
+
+	template <typename Base>
+	class link_table {
+	public:
+		template <typename T>
+		auto find(
+		) const -> Base*;
+
+		template <typename T>
+		auto insert(
+			std::unique_ptr<Base> link
+		) -> Base*;
+
+		auto links(
+		) const -> auto;
+
+		auto size(
+		) const -> std::size_t;
+	private:
+		struct entry {
+			std::uint64_t key = 0;
+			std::unique_ptr<Base> link;
+		};
+
+		auto probe(
+			std::uint64_t key
+		) const -> std::size_t;
+
+		std::vector<entry> m_entries = std::vector<entry>(64);
+		std::size_t m_count = 0;
+	};
+}
+
+template <typename T>
+auto gse::link_type_key() -> std::uint64_t {
+	return reinterpret_cast<std::uintptr_t>(&link_type_tag<T>);
+}
+
+template <typename Base>
+template <typename T>
+auto gse::link_table<Base>::find() const -> Base* {
+	const auto key = link_type_key<T>();
+	return m_entries[probe(key)].link.get();
+}
+
+template <typename Base>
+template <typename T>
+auto gse::link_table<Base>::insert(std::unique_ptr<Base> link) -> Base* {
+	if ((m_count + 1) * 2 > m_entries.size()) {
+		auto old = std::exchange(m_entries, std::vector<entry>(m_entries.size() * 2));
+		for (auto& e : old) {
+			if (e.link) {
+				m_entries[probe(e.key)] = std::move(e);
+			}
+		}
+	}
+
+	const auto key = link_type_key<T>();
+	auto& e = m_entries[probe(key)];
+	assert(!e.link, std::source_location::current(), "Link for type {} is already registered.", typeid(T).name());
+
+	e.key = key;
+	e.link = std::move(link);
+	++m_count;
+	return e.link.get();
+}
+
+template <typename Base>
+auto gse::link_table<Base>::links() const -> auto {
+	return m_entries
+		| std::views::filter([](const entry& e) { return e.link != nullptr; })
+		| std::views::transform([](const entry& e) { return e.link.get(); });
+}
+
+template <typename Base>
+auto gse::link_table<Base>::size() const -> std::size_t {
+	return m_count;
+}
+
+template <typename Base>
+auto gse::link_table<Base>::probe(const std::uint64_t key) const -> std::size_t {
+	const std::size_t mask = m_entries.size() - 1;
+	for (std::size_t i = key & mask;; i = (i + 1) & mask) {
+		if (m_entries[i].key == key || m_entries[i].key == 0) {
+			return i;
+		}
+	}
+}
+
 export namespace gse {
 	class registry final : public non_copyable {
 	public:
@@ -56,6 +153,14 @@ export namespace gse {
 		auto linked_objects_write(
 		) -> std::span<U>;
 
+		template <is_component U>
+		auto linked_storage_read(
+		) const -> sparse_span<const U>;
+
+		template <is_component U>
+		auto linked_storage_write(
+		) -> sparse_span<U>;
+
 		auto all_hooks(
 		) const -> std::vector<hook<entity>*>;
 
@@ -79,6 +184,16 @@ export namespace gse {
 			id id
 		) -> U*;
 
+		template <typename U>
+		auto try_linked_object_read(
+			const entity& handle
+		) -> const U*;
+
+		template <typename U>
+		auto try_linked_object_write(
+			const entity& handle
+		) -> U*;
+
 		template <typename U>
 		auto try_linked_object_by_link_id_read(
 			id link_id
@@ -103,6 +218,18 @@ export namespace gse {
 			id id
 		) const -> bool;
 
+		auto handle(
+			id id
+		) const -> std::optional<entity>;
+
+		auto valid(
+			const entity& handle
+		) const -> bool;
+
+		auto owner(
+			const entity& handle
+		) const -> id;
+
 		auto active(
 			id id
 		) const -> bool;
@@ -139,20 +266,40 @@ export namespace gse {
 			deferred_action action
 		) -> void;
 
+		auto set_flip_mode(
+			flip_mode mode
+		) -> void;
+
 		auto update() -> void;
 		auto render() -> void;
 
 	private:
+		struct entity_slot {
+			id owner;
+			std::uint32_t generation = 0;
+		};
+
+		template <typename U>
+		auto try_component_link(
+		) const -> component_link<U>*;
+
+		template <typename U>
+		auto try_hook_link(
+		) const -> hook_link<U>*;
+
 		std::vector<std::pair<id, deferred_action>> m_deferred_actions;
 		id_mapped_collection<entity> m_active_entities;
 		std::unordered_set<id> m_inactive_ids;
 		std::vector<std::uint32_t> m_free_indices;
+		std::vector<entity_slot> m_entity_slots;
 
-		std::unordered_map<std::type_index, std::unique_ptr<component_link_base>> m_component_links;
-		std::unordered_map<std::type_index, std::unique_ptr<hook_link_base>> m_hook_links;
+		link_table<component_link_base> m_component_links;
+		link_table<hook_link_base> m_hook_links;
 
 		std::size_t m_read_index = 0;
 		std::size_t m_write_index = 1;
+
+		flip_mode m_flip_mode = flip_mode::dirty_only;
 	};
 }
 
@@ -160,9 +307,13 @@ gse::registry::registry() {
 	frame_sync::on_end([this] {
 		std::swap(m_read_index, m_write_index);
 
-		for (const auto& link : m_component_links | std::views::values) {
-			link->flip(m_read_index, m_write_index);
-		}
+		std::size_t copied = 0;
+		trace::scope(generate_id("registry.flip"), [&] {
+			for (auto* link : m_component_links.links()) {
+				copied += link->flip(m_read_index, m_write_index);
+			}
+		});
+		trace::counter(generate_id("registry.flip.copied"), static_cast<double>(copied));
 	});
 }
 
@@ -186,31 +337,30 @@ auto gse::registry::activate(id id) -> void {
 	if (!m_free_indices.empty()) {
 		object.index = m_free_indices.back();
 		m_free_indices.pop_back();
-		if (auto* old_entity = m_active_entities.try_get(id)) {
-			old_entity->generation++;
-			object.generation = old_entity->generation;
-		}
 	}
 	else {
-		object.index = static_cast<std::uint32_t>(m_active_entities.size());
+		object.index = static_cast<std::uint32_t>(m_entity_slots.size());
+		m_entity_slots.emplace_back();
 	}
+
+	auto& slot = m_entity_slots[object.index];
+	slot.owner = id;
+	object.generation = slot.generation;
 	m_active_entities.add(id, object);
 
 	bool work_was_done;
 	do {
 		work_was_done = false;
 
-		for (const auto& link : m_component_links | std::views::values) {
-			if (link->activate(id)) {
+		for (auto* link : m_component_links.links()) {
+			if (link->activate(id, object.index)) {
 				work_was_done = true;
 			}
 		}
 
 		std::vector<hook_link_base*> current_hook_links;
 		current_hook_links.reserve(m_hook_links.size());
-		std::ranges::transform(m_hook_links | std::views::values,
-			std::back_inserter(current_hook_links),
-			[](const auto& val) { return val.get(); });
+		std::ranges::copy(m_hook_links.links(), std::back_inserter(current_hook_links));
 
 		for (auto* link : current_hook_links) {
 			if (link->activate(id)) {
@@ -224,6 +374,9 @@ auto gse::registry::activate(id id) -> void {
 auto gse::registry::remove(const id id) -> void {
 	if (active(id)) {
 		if (const auto* entity = m_active_entities.try_get(id)) {
+			auto& slot = m_entity_slots[entity->index];
+			slot.owner.reset();
+			++slot.generation;
 			m_free_indices.push_back(entity->index);
 		}
 		m_active_entities.remove(id);
@@ -232,10 +385,10 @@ auto gse::registry::remove(const id id) -> void {
 		m_inactive_ids.erase(id);
 	}
 
-	for (const auto& link : m_component_links | std::views::values) {
+	for (auto* link : m_component_links.links()) {
 		link->remove(id);
 	}
-	for (const auto& link : m_hook_links | std::views::values) {
+	for (auto* link : m_hook_links.links()) {
 		link->remove(id);
 	}
 }
@@ -244,18 +397,18 @@ template <gse::is_component U, typename... Args>
 auto gse::registry::add_component(id owner_id, Args&&... args) -> U* {
 	assert(exists(owner_id), std::source_location::current(), "Cannot add component to entity with id {}: it does not exist.", owner_id);
 
-	const auto type_idx = std::type_index(typeid(U));
-	if (!m_component_links.contains(type_idx)) {
+	auto* lnk = try_component_link<U>();
+	if (!lnk) {
 		auto link = std::make_unique<component_link<U>>();
 		link->bind(m_read_index, m_write_index);
-		m_component_links[type_idx] = std::move(link);
+		link->set_flip_mode(m_flip_mode);
+		lnk = static_cast<component_link<U>*>(m_component_links.template insert<U>(std::move(link)));
 	}
 
-	auto& lnk = static_cast<component_link<U>&>(*m_component_links.at(type_idx));
-	auto* comp_ptr = lnk.add(owner_id, this, std::forward<Args>(args)...);
+	auto* comp_ptr = lnk->add(owner_id, this, std::forward<Args>(args)...);
 
-	if (active(owner_id)) {
-		lnk.activate(owner_id);
+	if (const auto* entity = m_active_entities.try_get(owner_id)) {
+		lnk->activate(owner_id, entity->index);
 	}
 
 	return comp_ptr;
@@ -265,17 +418,16 @@ template <gse::is_entity_hook U, typename... Args>
 auto gse::registry::add_hook(id owner_id, Args&&... args) -> U* {
 	assert(exists(owner_id), std::source_location::current(), "Cannot add hook to entity with id {}: it does not exist.", owner_id);
 
-	const auto type_idx = std::type_index(typeid(U));
-	if (!m_hook_links.contains(type_idx)) {
-		m_hook_links[type_idx] = std::make_unique<hook_link<U>>(*this);
+	auto* lnk = try_hook_link<U>();
+	if (!lnk) {
+		lnk = static_cast<hook_link<U>*>(m_hook_links.template insert<U>(std::make_unique<hook_link<U>>(*this)));
 	}
 
-	auto& lnk = static_cast<hook_link<U>&>(*m_hook_links.at(type_idx));
-	auto* hook_ptr = lnk.add(owner_id, std::forward<Args>(args)...);
+	auto* hook_ptr = lnk->add(owner_id, std::forward<Args>(args)...);
 
 	if (active(owner_id)) {
-		lnk.activate(owner_id);
-		lnk.initialize_hook(owner_id);
+		lnk->activate(owner_id);
+		lnk->initialize_hook(owner_id);
 	}
 
 	return hook_ptr;
@@ -283,77 +435,83 @@ auto gse::registry::add_hook(id owner_id, Args&&... args) -> U* {
 
 template <typename U>
 auto gse::registry::remove_link(const id id) -> void {
-	const auto type_idx = std::type_index(typeid(U));
-
 	if constexpr (is_entity_hook<U>) {
-		if (const auto it = m_hook_links.find(type_idx); it != m_hook_links.end()) {
-			it->second->remove(id);
+		if (auto* lnk = try_hook_link<U>()) {
+			lnk->remove(id);
 		}
 	}
 	else {
-		if (const auto it = m_component_links.find(type_idx); it != m_component_links.end()) {
-			it->second->remove(id);
+		if (auto* lnk = try_component_link<U>()) {
+			lnk->remove(id);
 		}
 	}
 }
 
 template <typename U>
 auto gse::registry::linked_objects_read() const -> std::span<const U> {
-	const auto type_idx = std::type_index(typeid(U));
-
 	if constexpr (is_entity_hook<U>) {
-		const auto it = m_hook_links.find(type_idx);
-
-		if (it == m_hook_links.end()) {
+		auto* lnk = try_hook_link<U>();
+		if (!lnk) {
 			return std::span<const U>{};
 		}
 
-		auto& lnk = static_cast<hook_link<U>&>(*it->second);
-		auto span_mut = lnk.objects();
+		auto span_mut = lnk->objects();
 		return std::span<const U>(span_mut.data(), span_mut.size());
 	}
 	else {
-		const auto it = m_component_links.find(type_idx);
-
-		if (it == m_component_links.end()) {
+		auto* lnk = try_component_link<U>();
+		if (!lnk) {
 			return std::span<const U>{};
 		}
 
-		auto& lnk = static_cast<component_link<U>&>(*it->second);
-		return lnk.objects_read();
+		return lnk->objects_read();
 	}
 }
 
 template <typename U>
 auto gse::registry::linked_objects_write() -> std::span<U> {
-	const auto type_idx = std::type_index(typeid(U));
-
 	if constexpr (is_entity_hook<U>) {
-		const auto it = m_hook_links.find(type_idx);
-
-		if (it == m_hook_links.end()) {
+		auto* lnk = try_hook_link<U>();
+		if (!lnk) {
 			return std::span<U>{};
 		}
 
-		auto& lnk = static_cast<hook_link<U>&>(*it->second);
-		return lnk.objects();
+		return lnk->objects();
 	}
 	else {
-		const auto it = m_component_links.find(type_idx);
-
-		if (it == m_component_links.end()) {
+		auto* lnk = try_component_link<U>();
+		if (!lnk) {
 			return std::span<U>{};
 		}
 
-		auto& lnk = static_cast<component_link<U>&>(*it->second);
-		return lnk.objects_write();
+		return lnk->objects_write();
 	}
 }
 
+template <gse::is_component U>
+auto gse::registry::linked_storage_read() const -> sparse_span<const U> {
+	auto* lnk = try_component_link<U>();
+	if (!lnk) {
+		return {};
+	}
+
+	return lnk->storage_read();
+}
+
+template <gse::is_component U>
+auto gse::registry::linked_storage_write() -> sparse_span<U> {
+	auto* lnk = try_component_link<U>();
+	if (!lnk) {
+		return {};
+	}
+
+	return lnk->storage_write();
+}
+
 auto gse::registry::all_hooks() const -> std::vector<hook<entity>*> {
 	std::vector<hook<entity>*> collected_hooks;
 
-	for (const auto& link_ptr : m_hook_links | std::views::values) {
+	for (auto* link_ptr : m_hook_links.links()) {
 		auto hooks_from_link = link_ptr->hooks_as_base();
 		collected_hooks.insert(collected_hooks.end(), hooks_from_link.begin(), hooks_from_link.end());
 	}
@@ -370,19 +528,16 @@ auto gse::registry::linked_object_read(id id) -> const U& {
 
 template <typename U>
 auto gse::registry::linked_object_write(id id) -> U& {
-	const auto type_idx = std::type_index(typeid(U));
-
-	const auto it = m_component_links.find(type_idx);
+	auto* lnk = try_component_link<U>();
 
 	assert(
-		it != m_component_links.end(),
+		lnk,
 		std::source_location::current(),
 		"Linked object (write) of type {} with id {} not found.",
 		typeid(U).name(), id
 	);
 
-	auto& lnk = static_cast<component_link<U>&>(*it->second);
-	if (auto* p = lnk.try_get_write(id)) {
+	if (auto* p = lnk->try_get_write(id)) {
 		return *p;
 	}
 
@@ -392,72 +547,90 @@ auto gse::registry::linked_object_write(id id) -> U& {
 
 template <typename U>
 auto gse::registry::try_linked_object_read(id id) -> const U* {
-	const auto type_idx = std::type_index(typeid(U));
-
 	if constexpr (is_entity_hook<U>) {
-		const auto it = m_hook_links.find(type_idx);
-		if (it == m_hook_links.end()) {
+		auto* lnk = try_hook_link<U>();
+		if (!lnk) {
 			return nullptr;
 		}
-		auto& lnk = static_cast<hook_link<U>&>(*it->second);
-		return lnk.try_get(id);
+
+		return lnk->try_get(id);
 	}
 	else {
-		const auto it = m_component_links.find(type_idx);
-		if (it == m_component_links.end()) {
+		auto* lnk = try_component_link<U>();
+		if (!lnk) {
 			return nullptr;
 		}
-		auto& lnk = static_cast<component_link<U>&>(*it->second);
-		return lnk.try_get_read(id);
+
+		return lnk->try_get_read(id);
 	}
 }
 
 template <typename U>
 auto gse::registry::try_linked_object_write(id id) -> U* {
-	const auto type_idx = std::type_index(typeid(U));
-
 	if constexpr (is_entity_hook<U>) {
-		const auto it = m_hook_links.find(type_idx);
-		if (it == m_hook_links.end()) {
+		auto* lnk = try_hook_link<U>();
+		if (!lnk) {
 			return nullptr;
 		}
-		auto& lnk = static_cast<hook_link<U>&>(*it->second);
-		return lnk.try_get(id);
+
+		return lnk->try_get(id);
 	}
 	else {
-		const auto it = m_component_links.find(type_idx);
-		if (it == m_component_links.end()) {
+		auto* lnk = try_component_link<U>();
+		if (!lnk) {
 			return nullptr;
 		}
-		auto& lnk = static_cast<component_link<U>&>(*it->second);
-		return lnk.try_get_write(id);
+
+		return lnk->try_get_write(id);
 	}
 }
 
 template <typename U>
-auto gse::registry::try_linked_object_by_link_id_read(id link_id) -> const U* {
-	const auto type_idx = std::type_index(typeid(U));
-	const auto it = m_component_links.find(type_idx);
+auto gse::registry::try_linked_object_read(const entity& handle) -> const U* {
+	if (!valid(handle)) {
+		return nullptr;
+	}
 
-	if (it == m_component_links.end()) {
+	auto* lnk = try_component_link<U>();
+	if (!lnk) {
 		return nullptr;
 	}
 
-	auto& lnk = static_cast<component_link<U>&>(*it->second);
-	return lnk.try_get_by_link_id_read(link_id);
+	return lnk->try_get_read(handle);
 }
 
 template <typename U>
-auto gse::registry::try_linked_object_by_link_id_write(id link_id) -> U* {
-	const auto type_idx = std::type_index(typeid(U));
-	const auto it = m_component_links.find(type_idx);
+auto gse::registry::try_linked_object_write(const entity& handle) -> U* {
+	if (!valid(handle)) {
+		return nullptr;
+	}
 
-	if (it == m_component_links.end()) {
+	auto* lnk = try_component_link<U>();
+	if (!lnk) {
 		return nullptr;
 	}
 
-	auto& lnk = static_cast<component_link<U>&>(*it->second);
-	return lnk.try_get_by_link_id_write(link_id);
+	return lnk->try_get_write(handle);
+}
+
+template <typename U>
+auto gse::registry::try_linked_object_by_link_id_read(id link_id) -> const U* {
+	auto* lnk = try_component_link<U>();
+	if (!lnk) {
+		return nullptr;
+	}
+
+	return lnk->try_get_by_link_id_read(link_id);
+}
+
+template <typename U>
+auto gse::registry::try_linked_object_by_link_id_write(id link_id) -> U* {
+	auto* lnk = try_component_link<U>();
+	if (!lnk) {
+		return nullptr;
+	}
+
+	return lnk->try_get_by_link_id_write(link_id);
 }
 
 template <typename U>
@@ -478,6 +651,24 @@ auto gse::registry::exists(const id id) const -> bool {
 	return m_active_entities.contains(id) || m_inactive_ids.contains(id);
 }
 
+auto gse::registry::handle(const id id) const -> std::optional<entity> {
+	if (const auto* entity = m_active_entities.try_get(id)) {
+		return *entity;
+	}
+	return std::nullopt;
+}
+
+auto gse::registry::valid(const entity& handle) const -> bool {
+	return handle.index < m_entity_slots.size() && m_entity_slots[handle.index].generation == handle.generation && m_entity_slots[handle.index].owner.exists();
+}
+
+auto gse::registry::owner(const entity& handle) const -> id {
+	if (!valid(handle)) {
+		return {};
+	}
+	return m_entity_slots[handle.index].owner;
+}
+
 auto gse::registry::active(const id id) const -> bool {
 	return m_active_entities.contains(id);
 }
@@ -500,44 +691,53 @@ auto gse::registry::ensure_active(const id id) -> void {
 
 template <typename U>
 auto gse::registry::drain_component_adds() -> std::vector<id> {
-	const auto type_idx = std::type_index(typeid(U));
-	const auto it = m_component_links.find(type_idx);
-	if (it == m_component_links.end()) return {};
-	auto& lnk = static_cast<component_link<U>&>(*it->second);
-	return lnk.drain_adds();
+	auto* lnk = try_component_link<U>();
+	if (!lnk) return {};
+	return lnk->drain_adds();
 }
 
 template <typename U>
 auto gse::registry::drain_component_updates() -> std::vector<id> {
-	const auto type_idx = std::type_index(typeid(U));
-	const auto it = m_component_links.find(type_idx);
-	if (it == m_component_links.end()) return {};
-	auto& lnk = static_cast<component_link<U>&>(*it->second);
-	return lnk.drain_updates();
+	auto* lnk = try_component_link<U>();
+	if (!lnk) return {};
+	return lnk->drain_updates();
 }
 
 template <typename U>
 auto gse::registry::drain_component_removes() -> std::vector<id> {
-	const auto type_idx = std::type_index(typeid(U));
-	const auto it = m_component_links.find(type_idx);
-	if (it == m_component_links.end()) return {};
-	auto& lnk = static_cast<component_link<U>&>(*it->second);
-	return lnk.drain_removes();
+	auto* lnk = try_component_link<U>();
+	if (!lnk) return {};
+	return lnk->drain_removes();
 }
 
 template <typename U>
 auto gse::registry::mark_component_updated(const id owner_id) -> void {
-	const auto type_idx = std::type_index(typeid(U));
-	const auto it = m_component_links.find(type_idx);
-	if (it == m_component_links.end()) return;
-	auto& lnk = static_cast<component_link<U>&>(*it->second);
-	lnk.mark_updated(owner_id);
+	auto* lnk = try_component_link<U>();
+	if (!lnk) return;
+	lnk->mark_updated(owner_id);
+}
+
+template <typename U>
+auto gse::registry::try_component_link() const -> component_link<U>* {
+	return static_cast<component_link<U>*>(m_component_links.template find<U>());
+}
+
+template <typename U>
+auto gse::registry::try_hook_link() const -> hook_link<U>* {
+	return static_cast<hook_link<U>*>(m_hook_links.template find<U>());
 }
 
 auto gse::registry::add_deferred_action(const id owner_id, deferred_action action) -> void {
 	m_deferred_actions.emplace_back(owner_id, std::move(action));
 }
 
+auto gse::registry::set_flip_mode(const flip_mode mode) -> void {
+	m_flip_mode = mode;
+	for (auto* link : m_component_links.links()) {
+		link->set_flip_mode(mode);
+	}
+}
+
 auto gse::registry::update() -> void {
 	std::erase_if(m_deferred_actions, [this](auto& pair) {
 		return pair.second(*this);
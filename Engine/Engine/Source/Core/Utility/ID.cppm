@@ -284,6 +284,10 @@ export namespace gse {
 			const PrimaryIdType& id
 		) const -> bool;
 
+		auto index_of(
+			const PrimaryIdType& id
+		) const -> std::optional<std::size_t>;
+
 		auto size(
 		) const -> size_t;
 
@@ -294,49 +298,55 @@ export namespace gse {
 			id_mapped_collection& other
 		) -> void;
 	private:
+		using index_map = std::unordered_map<PrimaryIdType, size_t>;
+
+		auto mutable_map(
+		) -> index_map&;
+
 		std::vector<T> m_items;
 		std::vector<PrimaryIdType> m_ids;
-		std::unordered_map<PrimaryIdType, size_t> m_map;
+		std::shared_ptr<index_map> m_map = std::make_shared<index_map>();
 	};
 }
 
 template <typename T, typename PrimaryIdType>
 auto gse::id_mapped_collection<T, PrimaryIdType>::add(const PrimaryIdType& id, T object) -> T* {
-	if (m_map.contains(id)) {
+	if (m_map->contains(id)) {
 		return nullptr;
 	}
 
 	const std::size_t new_index = m_items.size();
-	m_map[id] = new_index;
+	mutable_map()[id] = new_index;
 	m_ids.push_back(id);
 	return &m_items.emplace_back(std::move(object));
 }
 
 template <typename T, typename PrimaryIdType>
 auto gse::id_mapped_collection<T, PrimaryIdType>::remove(const PrimaryIdType& id) -> void {
-	const auto it = m_map.find(id);
-	if (it == m_map.end()) {
+	const auto it = m_map->find(id);
+	if (it == m_map->end()) {
 		return;
 	}
 
 	const size_t index_to_remove = it->second;
+	auto& map = mutable_map();
 
 	if (const size_t last_index = m_items.size() - 1; index_to_remove != last_index) {
 		const PrimaryIdType& last_id = m_ids.back();
 		m_items[index_to_remove] = std::move(m_items.back());
 		m_ids[index_to_remove] = std::move(m_ids.back());
-		m_map[last_id] = index_to_remove;
+		map[last_id] = index_to_remove;
 	}
 
-	m_map.erase(id);
+	map.erase(id);
 	m_items.pop_back();
 	m_ids.pop_back();
 }
 
 template <typename T, typename PrimaryIdType>
 auto gse::id_mapped_collection<T, PrimaryIdType>::pop(const PrimaryIdType& id) -> std::optional<T> {
-	const auto it = m_map.find(id);
-	if (it == m_map.end()) {
+	const auto it = m_map->find(id);
+	if (it == m_map->end()) {
 		return std::nullopt;
 	}
 
@@ -350,7 +360,7 @@ auto gse::id_mapped_collection<T, PrimaryIdType>::pop(const PrimaryIdType& id) -
 
 template <typename T, typename PrimaryIdType>
 auto gse::id_mapped_collection<T, PrimaryIdType>::try_get(const PrimaryIdType& id) -> T* {
-	if (const auto it = m_map.find(id); it != m_map.end()) {
+	if (const auto it = m_map->find(id); it != m_map->end()) {
 		return &m_items[it->second];
 	}
 	return nullptr;
@@ -358,7 +368,7 @@ auto gse::id_mapped_collection<T, PrimaryIdType>::try_get(const PrimaryIdType& i
 
 template <typename T, typename PrimaryIdType>
 auto gse::id_mapped_collection<T, PrimaryIdType>::try_get(const PrimaryIdType& id) const -> const T* {
-	if (const auto it = m_map.find(id); it != m_map.end()) {
+	if (const auto it = m_map->find(id); it != m_map->end()) {
 		return &m_items[it->second];
 	}
 	return nullptr;
@@ -371,7 +381,15 @@ auto gse::id_mapped_collection<T, PrimaryIdType>::items(this auto&& self) -> dec
 
 template <typename T, typename PrimaryIdType>
 auto gse::id_mapped_collection<T, PrimaryIdType>::contains(const PrimaryIdType& id) const -> bool {
-	return m_map.contains(id);
+	return m_map->contains(id);
+}
+
+template <typename T, typename PrimaryIdType>
+auto gse::id_mapped_collection<T, PrimaryIdType>::index_of(const PrimaryIdType& id) const -> std::optional<std::size_t> {
+	if (const auto it = m_map->find(id); it != m_map->end()) {
+		return it->second;
+	}
+	return std::nullopt;
 }
 
 template <typename T, typename PrimaryIdType>
@@ -383,14 +401,22 @@ template <typename T, typename PrimaryIdType>
 auto gse::id_mapped_collection<T, PrimaryIdType>::clear() noexcept -> void {
 	m_items.clear();
 	m_ids.clear();
-	m_map.clear();
+	m_map = std::make_shared<index_map>();
 }
 
 template <typename T, typename PrimaryIdType>
 auto gse::id_mapped_collection<T, PrimaryIdType>::transfer_from(id_mapped_collection& other) -> void {
 	m_items = std::move(other.m_items);
     m_ids   = std::move(other.m_ids);
-    m_map   = std::move(other.m_map);
+    m_map   = std::exchange(other.m_map, std::make_shared<index_map>());
+}
+
+template <typename T, typename PrimaryIdType>
+auto gse::id_mapped_collection<T, PrimaryIdType>::mutable_map() -> index_map& {
+	if (m_map.use_count() > 1) {
+		m_map = std::make_shared<index_map>(*m_map);
+	}
+	return *m_map;
 }
 
 export template <>
@@ -557,12 +583,40 @@ auto gse::number(const std::string_view tag) -> uuid {
 }
 
 export namespace gse {
+	enum class flip_mode {
+		full_copy,
+		dirty_only
+	};
+
+	template <typename T>
+	struct sparse_span {
+		static constexpr std::uint32_t null_index = std::numeric_limits<std::uint32_t>::max();
+
+		std::span<T> items;
+		std::span<const std::uint32_t> dense_to_sparse;
+		std::span<const std::uint32_t> sparse;
+		std::span<std::uint64_t> dirty_words;
+
+		auto try_get(
+			std::uint32_t sparse_index
+		) const -> T*;
+
+		auto mark_dirty(
+			std::size_t index
+		) const -> void;
+
+		auto mark_all_dirty(
+		) const -> void;
+	};
+
 	template <typename T, typename IdType>
 	class double_buffered_id_mapped_queue {
 	public:
 		using id_type = IdType;
 		using value_type = T;
 
+		static constexpr std::uint32_t null_index = std::numeric_limits<std::uint32_t>::max();
+
 		struct reader {
 			double_buffered_id_mapped_queue* parent;
 
@@ -573,6 +627,13 @@ export namespace gse {
 				const id_type& id
 			) const -> const T*;
 
+			auto try_get(
+				std::uint32_t sparse_index
+			) const -> const T*;
+
+			auto storage(
+			) const -> sparse_span<const T>;
+
 			auto emplace_from_writer(
 				const id_type& id
 			) -> const T*;
@@ -588,7 +649,8 @@ export namespace gse {
 			) -> T*;
 
 			auto activate(
-				const id_type& owner
+				const id_type& owner,
+				std::uint32_t sparse_index
 			) -> bool;
 
 			auto remove(
@@ -602,6 +664,13 @@ export namespace gse {
 				const id_type& id
 			) -> T*;
 
+			auto try_get(
+				std::uint32_t sparse_index
+			) -> T*;
+
+			auto storage(
+			) -> sparse_span<T>;
+
 			auto reader(
 			) -> reader;
 		};
@@ -612,24 +681,82 @@ export namespace gse {
 		) -> std::pair<reader, writer>;
 
 		auto flip(
-		) -> void;
+		) -> std::size_t;
 
 		auto clear(
 		) noexcept -> void;
+
+		auto set_flip_mode(
+			flip_mode mode
+		) -> void;
 	private:
 		struct slot {
 			id_mapped_collection<T, IdType> active;
 			id_mapped_collection<T, IdType> queued;
+			std::vector<std::uint32_t> sparse;
+			std::vector<std::uint32_t> dense_to_sparse;
+
+			auto add_active(
+				const id_type& id,
+				std::uint32_t sparse_index,
+				T object
+			) -> T*;
+
+			auto remove_active(
+				const id_type& id
+			) -> void;
+
+			auto dense_index(
+				std::uint32_t sparse_index
+			) const -> std::optional<std::size_t>;
 
 			auto clone_from(
 				const slot& other
 			) -> void;
 		};
 
+		auto mark_dirty(
+			std::size_t index
+		) -> void;
+
 		double_buffer<slot> m_slots;
+
+		flip_mode m_flip_mode = flip_mode::dirty_only;
+		std::vector<std::uint64_t> m_dirty_words;
+		std::atomic<bool> m_all_dirty = false;
+		std::atomic<bool> m_structure_changed = false;
 	};
 }
 
+template <typename T>
+auto gse::sparse_span<T>::try_get(const std::uint32_t sparse_index) const -> T* {
+	if (sparse_index >= sparse.size() || sparse[sparse_index] == null_index) {
+		return nullptr;
+	}
+	if constexpr (!std::is_const_v<T>) {
+		mark_dirty(sparse[sparse_index]);
+	}
+	return &items[sparse[sparse_index]];
+}
+
+template <typename T>
+auto gse::sparse_span<T>::mark_dirty(const std::size_t index) const -> void {
+	if (index / 64 >= dirty_words.size()) {
+		return;
+	}
+
+	std::atomic_ref(dirty_words[index / 64]).fetch_or(std::uint64_t{ 1 } << (index % 64), std::memory_order_relaxed);
+}
+
+template <typename T>
+auto gse::sparse_span<T>::mark_all_dirty() const -> void {
+	for (std::size_t word = 0; word < dirty_words.size() && word * 64 < items.size(); ++word) {
+		const std::size_t remaining = items.size() - word * 64;
+		const std::uint64_t bits = remaining >= 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << remaining) - 1;
+		std::atomic_ref(dirty_words[word]).fetch_or(bits, std::memory_order_relaxed);
+	}
+}
+
 template <typename T, typename IdType>
 auto gse::double_buffered_id_mapped_queue<T, IdType>::reader::objects() -> std::span<const T> {
 	return parent->m_slots.read().active.items();
@@ -640,6 +767,25 @@ auto gse::double_buffered_id_mapped_queue<T, IdType>::reader::try_get(const id_t
 	return parent->m_slots.read().active.try_get(id);
 }
 
+template <typename T, typename IdType>
+auto gse::double_buffered_id_mapped_queue<T, IdType>::reader::try_get(const std::uint32_t sparse_index) const -> const T* {
+	const auto& read_slot = parent->m_slots.read();
+	if (const auto index = read_slot.dense_index(sparse_index)) {
+		return &read_slot.active.items()[*index];
+	}
+	return nullptr;
+}
+
+template <typename T, typename IdType>
+auto gse::double_buffered_id_mapped_queue<T, IdType>::reader::storage() const -> sparse_span<const T> {
+	const auto& read_slot = parent->m_slots.read();
+	return {
+		.items = read_slot.active.items(),
+		.dense_to_sparse = read_slot.dense_to_sparse,
+		.sparse = read_slot.sparse
+	};
+}
+
 template <typename T, typename IdType>
 auto gse::double_buffered_id_mapped_queue<T, IdType>::reader::emplace_from_writer(const id_type& id) -> const T* {
 	auto& read_slot = const_cast<slot&>(parent->m_slots.read());
@@ -649,8 +795,9 @@ auto gse::double_buffered_id_mapped_queue<T, IdType>::reader::emplace_from_write
 		return existing;
 	}
 
-	if (const auto* src = write_slot.active.try_get(id)) {
-		return read_slot.active.add(id, T(*src));
+	if (const auto index = write_slot.active.index_of(id)) {
+		parent->m_structure_changed.store(true, std::memory_order_relaxed);
+		return read_slot.add_active(id, write_slot.dense_to_sparse[*index], T(write_slot.active.items()[*index]));
 	}
 
 	return nullptr;
@@ -663,9 +810,10 @@ auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::emplace_queued(con
 }
 
 template <typename T, typename IdType>
-auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::activate(const id_type& owner) -> bool {
+auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::activate(const id_type& owner, const std::uint32_t sparse_index) -> bool {
 	if (auto obj = parent->m_slots.write().queued.pop(owner)) {
-		parent->m_slots.write().active.add(owner, std::move(*obj));
+		parent->m_structure_changed.store(true, std::memory_order_relaxed);
+		parent->m_slots.write().add_active(owner, sparse_index, std::move(*obj));
 		return true;
 	}
 	return false;
@@ -673,25 +821,50 @@ auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::activate(const id_
 
 template <typename T, typename IdType>
 auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::remove(const id_type& id) -> void {
+	parent->m_structure_changed.store(true, std::memory_order_relaxed);
 	for (auto& slot : parent->m_slots.buffer()) {
-		slot.active.remove(id);
+		slot.remove_active(id);
 		slot.queued.remove(id);
 	}
 }
 
 template <typename T, typename IdType>
 auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::objects() -> std::span<T> {
+	parent->m_all_dirty.store(true, std::memory_order_relaxed);
 	return parent->m_slots.write().active.items();
 }
 
 template <typename T, typename IdType>
 auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::try_get(const id_type& id) -> T* {
-	if (auto* p = parent->m_slots.write().active.try_get(id)) {
-		return p;
+	auto& active = parent->m_slots.write().active;
+	if (const auto index = active.index_of(id)) {
+		parent->mark_dirty(*index);
+		return &active.items()[*index];
 	}
 	return parent->m_slots.write().queued.try_get(id);
 }
 
+template <typename T, typename IdType>
+auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::try_get(const std::uint32_t sparse_index) -> T* {
+	auto& write_slot = parent->m_slots.write();
+	if (const auto index = write_slot.dense_index(sparse_index)) {
+		parent->mark_dirty(*index);
+		return &write_slot.active.items()[*index];
+	}
+	return nullptr;
+}
+
+template <typename T, typename IdType>
+auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::storage() -> sparse_span<T> {
+	auto& write_slot = parent->m_slots.write();
+	return {
+		.items = write_slot.active.items(),
+		.dense_to_sparse = write_slot.dense_to_sparse,
+		.sparse = write_slot.sparse,
+		.dirty_words = parent->m_flip_mode == flip_mode::dirty_only ? std::span(parent->m_dirty_words) : std::span<std::uint64_t>{}
+	};
+}
+
 template <typename T, typename IdType>
 auto gse::double_buffered_id_mapped_queue<T, IdType>::writer::reader() -> double_buffered_id_mapped_queue::reader {
 	return { parent };
@@ -708,9 +881,40 @@ auto gse::double_buffered_id_mapped_queue<T, IdType>::bind(const std::size_t rea
 }
 
 template <typename T, typename IdType>
-auto gse::double_buffered_id_mapped_queue<T, IdType>::flip() -> void {
+auto gse::double_buffered_id_mapped_queue<T, IdType>::flip() -> std::size_t {
 	m_slots.flip();
-	m_slots.write().clone_from(m_slots.read());
+
+	auto& write_slot = m_slots.write();
+	const auto& read_slot = m_slots.read();
+	const auto source = read_slot.active.items();
+
+	std::size_t copied = 0;
+
+	if (m_flip_mode == flip_mode::full_copy || m_structure_changed.exchange(false, std::memory_order_relaxed) || write_slot.active.size() != source.size()) {
+		write_slot.clone_from(read_slot);
+		copied = source.size();
+	}
+	else if (m_all_dirty.load(std::memory_order_relaxed)) {
+		std::ranges::copy(source, write_slot.active.items().begin());
+		write_slot.queued.clear();
+		copied = source.size();
+	}
+	else {
+		const auto destination = write_slot.active.items();
+		for (const auto& [word_index, word] : m_dirty_words | std::views::enumerate) {
+			for (auto bits = word; bits != 0; bits &= bits - 1) {
+				const auto index = static_cast<std::size_t>(word_index) * 64 + std::countr_zero(bits);
+				destination[index] = source[index];
+				++copied;
+			}
+		}
+		write_slot.queued.clear();
+	}
+
+	m_all_dirty.store(false, std::memory_order_relaxed);
+	m_dirty_words.assign((source.size() + 63) / 64, 0);
+
+	return copied;
 }
 
 template <typename T, typename IdType>
@@ -718,11 +922,80 @@ auto gse::double_buffered_id_mapped_queue<T, IdType>::clear() noexcept -> void {
 	for (auto& slot : m_slots.buffer()) {
 		slot.active.clear();
 		slot.queued.clear();
+		slot.sparse.clear();
+		slot.dense_to_sparse.clear();
+	}
+	m_dirty_words.clear();
+	m_structure_changed.store(true, std::memory_order_relaxed);
+}
+
+template <typename T, typename IdType>
+auto gse::double_buffered_id_mapped_queue<T, IdType>::set_flip_mode(const flip_mode mode) -> void {
+	m_flip_mode = mode;
+	m_structure_changed.store(true, std::memory_order_relaxed);
+}
+
+template <typename T, typename IdType>
+auto gse::double_buffered_id_mapped_queue<T, IdType>::mark_dirty(const std::size_t index) -> void {
+	if (m_flip_mode == flip_mode::full_copy) {
+		return;
+	}
+
+	sparse_span<T>{ .dirty_words = m_dirty_words }.mark_dirty(index);
+}
+
+template <typename T, typename IdType>
+auto gse::double_buffered_id_mapped_queue<T, IdType>::slot::add_active(const id_type& id, const std::uint32_t sparse_index, T object) -> T* {
+	auto* added = active.add(id, std::move(object));
+	if (!added) {
+		return nullptr;
+	}
+
+	if (sparse_index != null_index) {
+		if (sparse_index >= sparse.size()) {
+			sparse.resize(sparse_index + 1, null_index);
+		}
+		sparse[sparse_index] = static_cast<std::uint32_t>(dense_to_sparse.size());
+	}
+	dense_to_sparse.push_back(sparse_index);
+
+	return added;
+}
+
+template <typename T, typename IdType>
+auto gse::double_buffered_id_mapped_queue<T, IdType>::slot::remove_active(const id_type& id) -> void {
+	const auto index = active.index_of(id);
+	if (!index) {
+		return;
+	}
+
+	if (const auto removed = dense_to_sparse[*index]; removed != null_index) {
+		sparse[removed] = null_index;
+	}
+
+	if (const auto moved = dense_to_sparse.back(); *index != dense_to_sparse.size() - 1) {
+		dense_to_sparse[*index] = moved;
+		if (moved != null_index) {
+			sparse[moved] = static_cast<std::uint32_t>(*index);
+		}
+	}
+
+	dense_to_sparse.pop_back();
+	active.remove(id);
+}
+
+template <typename T, typename IdType>
+auto gse::double_buffered_id_mapped_queue<T, IdType>::slot::dense_index(const std::uint32_t sparse_index) const -> std::optional<std::size_t> {
+	if (sparse_index >= sparse.size() || sparse[sparse_index] == null_index) {
+		return std::nullopt;
 	}
+	return sparse[sparse_index];
 }
 
 template <typename T, typename IdType>
 auto gse::double_buffered_id_mapped_queue<T, IdType>::slot::clone_from(const slot& other) -> void {
 	active = other.active;
+	sparse = other.sparse;
+	dense_to_sparse = other.dense_to_sparse;
 	queued.clear();
 }
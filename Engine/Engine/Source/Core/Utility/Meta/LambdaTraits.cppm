@@ -6,6 +6,9 @@ export namespace gse {
     template <typename T>
     class chunk;
 
+    template <typename... Ts>
+    class view;
+
     template <typename T>
     struct chunk_traits {
         static constexpr bool is_chunk = false;
@@ -29,6 +32,30 @@ export namespace gse {
     template <typename T>
     using chunk_element_t = typename chunk_traits<std::remove_cvref_t<T>>::element_type;
 
+    template <typename T>
+    struct view_traits {
+        static constexpr bool is_view = false;
+
+        static auto append_reads(std::vector<std::type_index>&) -> void {}
+        static auto append_writes(std::vector<std::type_index>&) -> void {}
+    };
+
+    template <typename... Ts>
+    struct view_traits<view<Ts...>> {
+        static constexpr bool is_view = true;
+
+        static auto append_reads(std::vector<std::type_index>& result) -> void {
+            ((std::is_const_v<Ts> ? result.push_back(typeid(std::remove_const_t<Ts>)) : void()), ...);
+        }
+
+        static auto append_writes(std::vector<std::type_index>& result) -> void {
+            ((!std::is_const_v<Ts> ? result.push_back(typeid(Ts)) : void()), ...);
+        }
+    };
+
+    template <typename T>
+    constexpr bool is_view_v = view_traits<std::remove_cvref_t<T>>::is_view;
+
     template <typename... Args>
     struct param_info {
         static auto read_types() -> std::vector<std::type_index> {
@@ -36,6 +63,7 @@ export namespace gse {
             ((is_chunk_v<Args> && is_read_chunk_v<Args>
                 ? result.push_back(typeid(chunk_element_t<Args>))
                 : void()), ...);
+            (view_traits<std::remove_cvref_t<Args>>::append_reads(result), ...);
             return result;
         }
 
@@ -44,6 +72,7 @@ export namespace gse {
             ((is_chunk_v<Args> && !is_read_chunk_v<Args>
                 ? result.push_back(typeid(chunk_element_t<Args>))
                 : void()), ...);
+            (view_traits<std::remove_cvref_t<Args>>::append_writes(result), ...);
             return result;
         }
     };
@@ -1,3 +1,9 @@
+module;
+
+#ifndef GSE_TRACE_LEVEL
+#define GSE_TRACE_LEVEL 2
+#endif
+
 export module gse.utility:trace;
 
 import std;
@@ -9,9 +15,31 @@ import :system_clock;
 import :interval_timer;
 
 export namespace gse::trace {
+	enum class level : std::uint8_t {
+		off,
+		coarse,
+		detailed
+	};
+
+	enum class mode : std::uint8_t {
+		full,
+		aggregate
+	};
+
+	constexpr level compiled_level = static_cast<level>(GSE_TRACE_LEVEL);
+
 	struct config {
 		std::size_t per_thread_event_cap = 262144;
 		bool enable_browser_dump = false;
+		level max_level = level::coarse;
+		mode capture = mode::full;
+	};
+
+	struct aggregate {
+		uuid id;
+		std::uint64_t count = 0;
+		time_t<std::uint64_t> total{};
+		time_t<std::uint64_t> max{};
 	};
 
 	auto start(
@@ -42,6 +70,12 @@ export namespace gse::trace {
 		std::uint64_t parent
 	) -> void;
 
+	template <level L, typename F>
+	auto scope(
+		id id,
+		F&& f
+	) -> void;
+
 	auto begin_async(
 		id id,
 		std::uint64_t key
@@ -92,6 +126,9 @@ export namespace gse::trace {
 	auto view(
 	) -> frame_view;
 
+	auto aggregates(
+	) -> std::span<const aggregate>;
+
 	struct thread_pause {
 		thread_pause();
 		~thread_pause();
@@ -113,6 +150,21 @@ export namespace gse::trace {
 
 	auto finalize_paused(
 	) -> bool;
+
+	auto set_level(
+		level l
+	) -> void;
+
+	auto level_enabled(
+		level l
+	) -> bool;
+
+	auto set_mode(
+		mode m
+	) -> void;
+
+	auto current_mode(
+	) -> mode;
 }
 
 namespace gse::trace {
@@ -165,9 +217,22 @@ namespace gse::trace {
 		std::unique_ptr<event[]> m_events = std::make_unique<event[]>(capacity);
 	};
 
+	struct aggregate_slot {
+		std::atomic<bool> occupied{ false };
+		uuid id = 0;
+		std::atomic<std::uint64_t> count{ 0 };
+		std::atomic<std::uint64_t> total_ns{ 0 };
+		std::atomic<std::uint64_t> max_ns{ 0 };
+		std::uint64_t merged_count = 0;
+		std::uint64_t merged_total_ns = 0;
+	};
+
+	constexpr std::size_t aggregate_slot_count = 512;
+
 	struct thread_buffer {
 		scsp_events events;
 		std::vector<std::uint64_t> stack;
+		std::unique_ptr<aggregate_slot[]> totals = std::make_unique<aggregate_slot[]>(aggregate_slot_count);
 		std::uint32_t tid = 0;
 		bool registered = false;
 	};
@@ -176,6 +241,8 @@ namespace gse::trace {
 
 	std::atomic trace_enabled = true;
 	std::atomic finalize_paused_flag = false;
+	std::atomic runtime_level = level::coarse;
+	std::atomic capture_mode = mode::full;
 
 	std::atomic<std::uint64_t> next_eid{ 1024 };
 	std::atomic<std::uint32_t> next_tid{ 0 };
@@ -213,13 +280,14 @@ namespace gse::trace {
 		std::vector<flat_node> flat;
 		std::vector<node> node_pool;
 		std::vector<node> roots;
+		std::vector<aggregate> aggregates;
 	};
 
 	double_buffer<frame_storage> frames;
 	std::unordered_map<std::uint64_t, span_info> global_open_spans;
 
-	std::unordered_set<std::uint64_t> open_parents;
-	std::mutex open_m;
+	std::mutex frame_sink_mutex;
+	std::move_only_function<void(std::span<const event>)> frame_sink;
 
 	auto ensure_tls_registered(
 	) -> void;
@@ -244,10 +312,21 @@ namespace gse::trace {
 
 	auto allocate_span_eid(
 	) -> std::uint64_t;
+
+	auto record_aggregate(
+		uuid id,
+		time_t<std::uint64_t> duration
+	) -> void;
+
+	auto merge_aggregates(
+		frame_storage& fs
+	) -> void;
 }
 
 auto gse::trace::start(const config& cfg) -> void {
 	global_config = cfg;
+	set_level(cfg.max_level);
+	set_mode(cfg.capture);
 
 	ensure_tls_registered();
 	make_tid();
@@ -257,7 +336,7 @@ auto gse::trace::start(const config& cfg) -> void {
 }
 
 auto gse::trace::begin_block(id id, std::uint64_t parent) -> std::uint64_t {
-	if (paused()) return 0;
+	if (paused() || current_mode() == mode::aggregate) return 0;
 
 	ensure_tls_registered();
 
@@ -268,11 +347,6 @@ auto gse::trace::begin_block(id id, std::uint64_t parent) -> std::uint64_t {
 	const auto tid = make_tid();
 	const auto eid = allocate_span_eid();
 
-	{
-		std::scoped_lock lk(open_m);
-		open_parents.insert(eid);
-	}
-
 	emit({
 		.type = event_type::begin,
 		.id = id.number(),
@@ -292,11 +366,6 @@ auto gse::trace::end_block(id id, const std::uint64_t eid, const std::uint64_t p
 
 	ensure_tls_registered();
 
-	{
-		std::scoped_lock lk(open_m);
-		open_parents.erase(eid);
-	}
-
 	emit({
 		.type = event_type::end,
 		.id = id.number(),
@@ -322,6 +391,15 @@ auto gse::trace::scope(id id, F&& f, std::uint64_t parent) -> void {
 
 	ensure_tls_registered();
 
+	if (current_mode() == mode::aggregate) {
+		const auto t0 = system_clock::now<tick_step>();
+		auto guard = make_scope_exit([t0, uid = id.number()] {
+			record_aggregate(uid, system_clock::now<tick_step>() - t0);
+		});
+		std::forward<F>(f)();
+		return;
+	}
+
 	if (parent != 0 && parent < 1024) {
 		parent = 0;
 	}
@@ -335,11 +413,6 @@ auto gse::trace::scope(id id, F&& f, std::uint64_t parent) -> void {
 
 	const auto eid = allocate_span_eid();
 
-	{
-		std::scoped_lock lk(open_m);
-		open_parents.insert(eid);
-	}
-
 	emit({
 		.type = event_type::begin,
 		.id = id.number(),
@@ -352,11 +425,6 @@ auto gse::trace::scope(id id, F&& f, std::uint64_t parent) -> void {
 	tls.stack.push_back(eid);
 
 	auto guard = make_scope_exit([eid, parent, tid, uid = id.number(), need_push_parent] {
-		{
-			std::scoped_lock lk(open_m);
-			open_parents.erase(eid);
-		}
-
 		if (!tls.stack.empty() && tls.stack.back() == eid) {
 			emit({
 				.type = event_type::end,
@@ -376,6 +444,20 @@ auto gse::trace::scope(id id, F&& f, std::uint64_t parent) -> void {
 	std::forward<F>(f)();
 }
 
+template <gse::trace::level L, typename F>
+auto gse::trace::scope(id id, F&& f) -> void {
+	if constexpr (L > compiled_level) {
+		std::forward<F>(f)();
+	}
+	else {
+		if (!level_enabled(L)) {
+			std::forward<F>(f)();
+			return;
+		}
+		scope(id, std::forward<F>(f));
+	}
+}
+
 auto gse::trace::begin_async(id id, const std::uint64_t key) -> void {
 	if (paused()) {
 		return;
@@ -460,9 +542,19 @@ auto gse::trace::finalize_frame() -> void {
 	static interval_timer timer(milliseconds(100.f));
 
 	build_tree(frames.write());
+	merge_aggregates(frames.write());
+
+	{
+		std::lock_guard lock(frame_sink_mutex);
+		if (frame_sink) {
+			frame_sink(frames.write().merged);
+		}
+	}
 
 	if (timer.tick() && !finalize_paused()) {
+		std::ranges::sort(frames.write().aggregates, std::ranges::greater{}, &aggregate::total);
 		frames.flip();
+		frames.write().aggregates.clear();
 	}
 }
 
@@ -510,6 +602,10 @@ auto gse::trace::dump_browser(const std::filesystem::path& path, const frame_vie
 	out << "]}";
 }
 
+auto gse::trace::aggregates() -> std::span<const aggregate> {
+	return frames.read().aggregates;
+}
+
 auto gse::trace::view() -> frame_view {
 	const auto& fs = frames.read();
 	return {
@@ -527,7 +623,7 @@ gse::trace::thread_pause::~thread_pause() {
 }
 
 auto gse::trace::paused() -> bool {
-	return !trace_enabled.load(std::memory_order_relaxed) || tls_pause_depth > 0;
+	return !trace_enabled.load(std::memory_order_relaxed) || tls_pause_depth > 0 || runtime_level.load(std::memory_order_relaxed) == level::off;
 }
 
 auto gse::trace::set_enabled(const bool enable) -> void {
@@ -546,6 +642,22 @@ auto gse::trace::finalize_paused() -> bool {
 	return finalize_paused_flag.load(std::memory_order_relaxed);
 }
 
+auto gse::trace::set_level(const level l) -> void {
+	runtime_level.store(std::min(l, compiled_level), std::memory_order_relaxed);
+}
+
+auto gse::trace::level_enabled(const level l) -> bool {
+	return l <= runtime_level.load(std::memory_order_relaxed);
+}
+
+auto gse::trace::set_mode(const mode m) -> void {
+	capture_mode.store(m, std::memory_order_relaxed);
+}
+
+auto gse::trace::current_mode() -> mode {
+	return capture_mode.load(std::memory_order_relaxed);
+}
+
 auto gse::trace::scsp_events::push(const event& e) noexcept -> void {
 	const std::uint32_t w = m_w.load(std::memory_order_acquire);
 	const std::uint32_t next = (w + 1) & capacity_mask;
@@ -617,21 +729,56 @@ auto gse::trace::emit(const event& e) -> void {
 }
 
 auto gse::trace::current_parent_eid() -> std::uint64_t {
-	while (!tls.stack.empty()) {
-		const auto top = tls.stack.back();
+	return tls.stack.empty() ? 0 : tls.stack.back();
+}
 
-		if (top == 0) {
-			return 0;
-		}
+auto gse::trace::record_aggregate(const uuid id, const time_t<std::uint64_t> duration) -> void {
+	constexpr std::size_t mask = aggregate_slot_count - 1;
+	const std::uint64_t ns = duration.as<nanoseconds>();
 
-		std::scoped_lock lk(open_m);
-		if (open_parents.contains(top)) {
-			return top;
+	for (std::size_t i = std::hash<uuid>{}(id) & mask, probes = 0; probes < aggregate_slot_count; i = (i + 1) & mask, ++probes) {
+		auto& slot = tls.totals[i];
+		if (!slot.occupied.load(std::memory_order::relaxed)) {
+			slot.id = id;
+			slot.occupied.store(true, std::memory_order::release);
 		}
-		tls.stack.pop_back();
+		else if (slot.id != id) {
+			continue;
+		}
+
+		slot.count.store(slot.count.load(std::memory_order::relaxed) + 1, std::memory_order::relaxed);
+		slot.total_ns.store(slot.total_ns.load(std::memory_order::relaxed) + ns, std::memory_order::relaxed);
+
+		auto max = slot.max_ns.load(std::memory_order::relaxed);
+		while (ns > max && !slot.max_ns.compare_exchange_weak(max, ns, std::memory_order::relaxed)) {}
+		return;
 	}
+}
+
+auto gse::trace::merge_aggregates(frame_storage& fs) -> void {
+	std::lock_guard lk(tls_registry_mutex);
+	for (auto* tb : tls_registry) {
+		if (!tb) continue;
+
+		for (std::size_t i = 0; i < aggregate_slot_count; ++i) {
+			auto& slot = tb->totals[i];
+			if (!slot.occupied.load(std::memory_order::acquire)) continue;
 
-	return 0;
+			const auto count = slot.count.load(std::memory_order::relaxed);
+			const auto total_ns = slot.total_ns.load(std::memory_order::relaxed);
+			const auto max_ns = slot.max_ns.exchange(0, std::memory_order::relaxed);
+			if (count == slot.merged_count) continue;
+
+			auto it = std::ranges::find(fs.aggregates, slot.id, &aggregate::id);
+			if (it == fs.aggregates.end()) {
+				it = fs.aggregates.insert(fs.aggregates.end(), aggregate{ .id = slot.id });
+			}
+
+			it->count += count - std::exchange(slot.merged_count, count);
+			it->total += nanoseconds(total_ns - std::exchange(slot.merged_total_ns, total_ns));
+			it->max = std::max(it->max, time_t<std::uint64_t>(nanoseconds(max_ns)));
+		}
+	}
 }
 
 auto gse::trace::build_tree(frame_storage& fs) -> void {
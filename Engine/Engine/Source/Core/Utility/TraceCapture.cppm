@@ -0,0 +1,424 @@
+module;
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+export module gse.utility:trace_capture;
+
+import std;
+
+import :id;
+import :trace;
+
+export namespace gse::trace {
+	struct capture_config {
+		std::filesystem::path path;
+		std::size_t capacity = 256ull * 1024 * 1024;
+		std::size_t name_capacity = 4ull * 1024 * 1024;
+		std::size_t max_pending_frames = 120;
+	};
+
+	auto begin_capture(
+		const capture_config& cfg
+	) -> bool;
+
+	auto end_capture(
+	) -> void;
+
+	auto capturing(
+	) -> bool;
+}
+
+export namespace gse::trace::capture_format {
+	constexpr std::array<char, 8> file_magic = { 'G', 'S', 'T', 'R', 'A', 'C', 'E', '1' };
+	constexpr std::uint32_t record_magic = 0x52465347;
+	constexpr std::uint32_t version = 2;
+
+	struct file_header {
+		std::array<char, 8> magic = file_magic;
+		std::uint32_t version = capture_format::version;
+		std::uint32_t header_size = 0;
+		std::uint64_t capacity = 0;
+		std::uint64_t write_offset = 0;
+		std::uint64_t wrap_offset = 0;
+		std::uint64_t frame_count = 0;
+		std::uint64_t dropped_frames = 0;
+		std::uint64_t name_offset = 0;
+		std::uint64_t name_capacity = 0;
+		std::uint64_t name_size = 0;
+		std::uint64_t name_count = 0;
+		std::uint64_t dropped_names = 0;
+		std::uint64_t ring_offset = 0;
+	};
+
+	struct record_header {
+		std::uint32_t magic = record_magic;
+		std::uint32_t size = 0;
+		std::uint64_t frame_index = 0;
+		std::uint32_t event_count = 0;
+		std::uint32_t padding = 0;
+	};
+
+	struct event_record {
+		std::uint64_t id = 0;
+		std::uint64_t eid = 0;
+		std::uint64_t parent_eid = 0;
+		std::uint64_t ts_ns = 0;
+		double value = 0.0;
+		std::uint32_t tid = 0;
+		std::uint8_t type = 0;
+		std::array<std::uint8_t, 3> padding{};
+	};
+
+	struct name_record {
+		std::uint64_t id = 0;
+		std::uint32_t length = 0;
+		std::uint32_t padding = 0;
+	};
+
+	enum class event_kind : std::uint8_t {
+		begin,
+		end,
+		instant,
+		async_begin,
+		async_end,
+		counter
+	};
+
+	constexpr auto align(const std::size_t size) -> std::size_t {
+		return (size + 7) & ~std::size_t{ 7 };
+	}
+}
+
+namespace gse::trace {
+	class mapped_file {
+	public:
+		auto open(
+			const std::filesystem::path& path,
+			std::size_t size
+		) -> bool;
+
+		auto close(
+		) -> void;
+
+		auto flush(
+		) -> void;
+
+		auto data(
+		) const -> std::byte*;
+
+		auto size(
+		) const -> std::size_t;
+	private:
+		std::byte* m_data = nullptr;
+		std::size_t m_size = 0;
+#ifdef _WIN32
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+#else
+		int m_fd = -1;
+#endif
+	};
+
+	struct capture_state {
+		capture_config config;
+		mapped_file file;
+		capture_format::file_header* header = nullptr;
+		std::byte* names = nullptr;
+		std::byte* ring = nullptr;
+
+		std::mutex pending_mutex;
+		std::condition_variable_any pending_cv;
+		std::deque<std::vector<capture_format::event_record>> pending;
+		std::unordered_set<uuid> named;
+		std::vector<std::byte> scratch;
+
+		std::jthread writer;
+	};
+
+	std::unique_ptr<capture_state> active_capture;
+	std::mutex capture_mutex;
+
+	auto write_names(
+		capture_state& cs,
+		std::span<const capture_format::event_record> events
+	) -> void;
+
+	auto write_frame(
+		capture_state& cs,
+		std::span<const capture_format::event_record> events
+	) -> void;
+}
+
+auto gse::trace::mapped_file::open(const std::filesystem::path& path, const std::size_t size) -> bool {
+#ifdef _WIN32
+	m_file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	const auto high = static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32);
+	const auto low = static_cast<DWORD>(size & 0xFFFFFFFFull);
+	m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, high, low, nullptr);
+	if (!m_mapping) {
+		close();
+		return false;
+	}
+
+	m_data = static_cast<std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+#else
+	m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (m_fd < 0) {
+		return false;
+	}
+
+	if (ftruncate(m_fd, static_cast<off_t>(size)) != 0) {
+		close();
+		return false;
+	}
+
+	void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+	m_data = mapped == MAP_FAILED ? nullptr : static_cast<std::byte*>(mapped);
+#endif
+
+	if (!m_data) {
+		close();
+		return false;
+	}
+
+	m_size = size;
+	return true;
+}
+
+auto gse::trace::mapped_file::close() -> void {
+#ifdef _WIN32
+	if (m_data) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping) {
+		CloseHandle(m_mapping);
+	}
+	if (m_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_file);
+	}
+	m_mapping = nullptr;
+	m_file = INVALID_HANDLE_VALUE;
+#else
+	if (m_data) {
+		munmap(m_data, m_size);
+	}
+	if (m_fd >= 0) {
+		::close(m_fd);
+	}
+	m_fd = -1;
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+auto gse::trace::mapped_file::flush() -> void {
+	if (!m_data) {
+		return;
+	}
+#ifdef _WIN32
+	FlushViewOfFile(m_data, m_size);
+#else
+	msync(m_data, m_size, MS_ASYNC);
+#endif
+}
+
+auto gse::trace::mapped_file::data() const -> std::byte* {
+	return m_data;
+}
+
+auto gse::trace::mapped_file::size() const -> std::size_t {
+	return m_size;
+}
+
+auto gse::trace::begin_capture(const capture_config& cfg) -> bool {
+	end_capture();
+
+	auto cs = std::make_unique<capture_state>();
+	cs->config = cfg;
+
+	const auto header_size = capture_format::align(sizeof(capture_format::file_header));
+	const auto name_capacity = capture_format::align(cfg.name_capacity);
+	const auto capacity = capture_format::align(cfg.capacity);
+
+	if (!cs->file.open(cfg.path, header_size + name_capacity + capacity)) {
+		std::println("Failed to open trace capture file {}", cfg.path.string());
+		return false;
+	}
+
+	cs->header = std::construct_at(reinterpret_cast<capture_format::file_header*>(cs->file.data()));
+	cs->header->header_size = static_cast<std::uint32_t>(header_size);
+	cs->header->capacity = capacity;
+	cs->header->name_offset = header_size;
+	cs->header->name_capacity = name_capacity;
+	cs->header->ring_offset = header_size + name_capacity;
+	cs->names = cs->file.data() + cs->header->name_offset;
+	cs->ring = cs->file.data() + cs->header->ring_offset;
+
+	cs->writer = std::jthread([state = cs.get()](const std::stop_token& stop) {
+		while (true) {
+			std::deque<std::vector<capture_format::event_record>> batch;
+			{
+				std::unique_lock lock(state->pending_mutex);
+				state->pending_cv.wait(lock, stop, [state] {
+					return !state->pending.empty();
+				});
+				batch.swap(state->pending);
+			}
+
+			for (const auto& frame : batch) {
+				write_names(*state, frame);
+				write_frame(*state, frame);
+			}
+
+			if (batch.empty() && stop.stop_requested()) {
+				break;
+			}
+		}
+		state->file.flush();
+	});
+
+	{
+		std::lock_guard lock(frame_sink_mutex);
+		frame_sink = [state = cs.get()](const std::span<const event> events) {
+			std::vector<capture_format::event_record> records;
+			records.reserve(events.size());
+
+			for (const auto& e : events) {
+				records.push_back({
+					.id = e.id,
+					.eid = e.eid,
+					.parent_eid = e.parent_eid,
+					.ts_ns = e.ts.as<nanoseconds>(),
+					.value = e.value,
+					.tid = static_cast<std::uint32_t>(e.tid),
+					.type = static_cast<std::uint8_t>(e.type)
+				});
+			}
+
+			{
+				std::lock_guard pending_lock(state->pending_mutex);
+				if (state->pending.size() >= state->config.max_pending_frames) {
+					std::atomic_ref(state->header->dropped_frames).fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				state->pending.push_back(std::move(records));
+			}
+			state->pending_cv.notify_one();
+		};
+	}
+
+	std::lock_guard lock(capture_mutex);
+	active_capture = std::move(cs);
+	return true;
+}
+
+auto gse::trace::end_capture() -> void {
+	{
+		std::lock_guard lock(frame_sink_mutex);
+		frame_sink = nullptr;
+	}
+
+	std::unique_ptr<capture_state> cs;
+	{
+		std::lock_guard lock(capture_mutex);
+		cs = std::move(active_capture);
+	}
+
+	if (!cs) {
+		return;
+	}
+
+	cs->writer.request_stop();
+	cs->writer.join();
+	cs->file.close();
+}
+
+auto gse::trace::capturing() -> bool {
+	std::lock_guard lock(capture_mutex);
+	return active_capture != nullptr;
+}
+
+auto gse::trace::write_names(capture_state& cs, const std::span<const capture_format::event_record> events) -> void {
+	using namespace capture_format;
+
+	auto& header = *cs.header;
+
+	for (const auto& e : events) {
+		if (cs.named.contains(e.id)) {
+			continue;
+		}
+
+		cs.named.insert(e.id);
+
+		const auto tag = exists(e.id) ? gse::tag(e.id) : std::string_view{};
+		const auto size = align(sizeof(name_record)) + align(tag.size());
+		if (header.name_size + size > header.name_capacity) {
+			++header.dropped_names;
+			continue;
+		}
+
+		const name_record name{
+			.id = e.id,
+			.length = static_cast<std::uint32_t>(tag.size())
+		};
+		std::memcpy(cs.names + header.name_size, &name, sizeof(name));
+		std::memcpy(cs.names + header.name_size + align(sizeof(name)), tag.data(), tag.size());
+		header.name_size += size;
+		++header.name_count;
+	}
+}
+
+auto gse::trace::write_frame(capture_state& cs, const std::span<const capture_format::event_record> events) -> void {
+	using namespace capture_format;
+
+	auto& header = *cs.header;
+	auto& scratch = cs.scratch;
+	scratch.clear();
+
+	auto append = [&scratch](const void* src, const std::size_t size) {
+		const auto offset = scratch.size();
+		scratch.resize(align(offset + size));
+		std::memcpy(scratch.data() + offset, src, size);
+	};
+
+	record_header record{
+		.frame_index = header.frame_count,
+		.event_count = static_cast<std::uint32_t>(events.size())
+	};
+	append(&record, sizeof(record));
+	append(events.data(), events.size_bytes());
+
+	record.size = static_cast<std::uint32_t>(scratch.size());
+	std::memcpy(scratch.data(), &record, sizeof(record));
+
+	if (scratch.size() > header.capacity) {
+		std::atomic_ref(header.dropped_frames).fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	if (header.write_offset + scratch.size() > header.capacity) {
+		header.wrap_offset = header.write_offset;
+		header.write_offset = 0;
+		write_frame(cs, events);
+		return;
+	}
+
+	std::memcpy(cs.ring + header.write_offset, scratch.data(), scratch.size());
+	header.write_offset += scratch.size();
+	if (header.write_offset > header.wrap_offset) {
+		header.wrap_offset = 0;
+	}
+	++header.frame_count;
+}
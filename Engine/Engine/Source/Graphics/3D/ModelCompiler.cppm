@@ -3,6 +3,7 @@ export module gse.graphics:model_compiler;
 import std;
 
 import gse.platform;
+import gse.physics;
 import gse.assert;
 
 import :model;
@@ -10,6 +11,8 @@ import :mesh;
 
 export template<>
 struct gse::asset_compiler<gse::model> {
+    static constexpr std::uint32_t baked_version = 2;
+
     static auto source_extensions() -> std::vector<std::string> {
         return { ".obj" };
     }
@@ -148,9 +151,8 @@ struct gse::asset_compiler<gse::model> {
         }
 
         constexpr uint32_t magic = 0x474D444C;
-        constexpr uint32_t version = 1;
         out_file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
-        out_file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out_file.write(reinterpret_cast<const char*>(&baked_version), sizeof(baked_version));
 
         std::uint64_t mesh_count = built_meshes.size();
         out_file.write(reinterpret_cast<const char*>(&mesh_count), sizeof(mesh_count));
@@ -165,6 +167,21 @@ struct gse::asset_compiler<gse::model> {
             out_file.write(reinterpret_cast<const char*>(vertices.data()), vertex_count * sizeof(vertex));
         }
 
+        const auto hull = physics::convex_hull::create(temp_positions);
+        const std::uint8_t has_hull = hull != nullptr;
+        out_file.write(reinterpret_cast<const char*>(&has_hull), sizeof(has_hull));
+        if (hull) {
+            hull->write(out_file);
+            if (hull->simplification_error() > length{}) {
+                std::println(
+                    "Warning: convex hull of {} hit the {}-vertex budget and is inset by up to {} m",
+                    source.filename().string(),
+                    physics::convex_hull::max_vertices,
+                    hull->simplification_error().as<meters>()
+                );
+            }
+        }
+
         std::println("Model compiled: {}", destination.filename().string());
         return true;
     }
@@ -176,6 +193,15 @@ struct gse::asset_compiler<gse::model> {
         if (!std::filesystem::exists(destination)) {
             return true;
         }
+
+        std::ifstream baked_file(destination, std::ios::binary);
+        std::uint32_t magic = 0, version = 0;
+        baked_file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        baked_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        if (version < baked_version) {
+            return true;
+        }
+
         return std::filesystem::last_write_time(source) >
                std::filesystem::last_write_time(destination);
     }
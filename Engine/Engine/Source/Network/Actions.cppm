@@ -23,6 +23,16 @@ export namespace gse::network {
 		float x, y;
 	};
 
+	auto write_input_frame(
+		bitstream& s,
+		remote_peer& peer,
+		std::uint32_t input_sequence,
+		const actions::state& state,
+		std::span<const std::uint16_t> axes1_ids,
+		std::span<const std::uint16_t> axes2_ids,
+		angle camera_yaw = {}
+	) -> void;
+
 	auto send_input_frame(
 		const udp_socket& socket,
 		remote_peer& peer,
@@ -35,7 +45,7 @@ export namespace gse::network {
 	) -> void;
 }
 
-auto gse::network::send_input_frame(const udp_socket& socket, remote_peer& peer, std::array<std::byte, max_packet_size>& buffer, const std::uint32_t input_sequence, const actions::state& state, const std::span<const std::uint16_t> axes1_ids, const std::span<const std::uint16_t> axes2_ids, const angle camera_yaw) -> void {
+auto gse::network::write_input_frame(bitstream& s, remote_peer& peer, const std::uint32_t input_sequence, const actions::state& state, const std::span<const std::uint16_t> axes1_ids, const std::span<const std::uint16_t> axes2_ids, const angle camera_yaw) -> void {
 	const auto& pm = state.pressed_mask();
 	const auto& rm = state.released_mask();
 	const auto& hm = state.held_mask();
@@ -54,8 +64,6 @@ auto gse::network::send_input_frame(const udp_socket& socket, remote_peer& peer,
 		| std::views::filter([](const auto& p) { return p.x != 0.f || p.y != 0.f; })
 		| std::ranges::to<std::vector>();
 
-	bitstream s(buffer);
-
 	const packet_header ph{
 		.sequence = ++peer.sequence(),
 		.ack = peer.remote_ack_sequence(),
@@ -96,6 +104,11 @@ auto gse::network::send_input_frame(const udp_socket& socket, remote_peer& peer,
 	if (!a2.empty()) {
 		s.write(std::as_bytes(std::span{ a2.data(), a2.size() }));
 	}
+}
+
+auto gse::network::send_input_frame(const udp_socket& socket, remote_peer& peer, std::array<std::byte, max_packet_size>& buffer, const std::uint32_t input_sequence, const actions::state& state, const std::span<const std::uint16_t> axes1_ids, const std::span<const std::uint16_t> axes2_ids, const angle camera_yaw) -> void {
+	bitstream s(buffer);
+	write_input_frame(s, peer, input_sequence, state, axes1_ids, axes2_ids, camera_yaw);
 
 	const packet pkt{
 		.data = reinterpret_cast<std::uint8_t*>(buffer.data()),
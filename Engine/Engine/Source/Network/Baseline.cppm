@@ -0,0 +1,287 @@
+export module gse.network:baseline;
+
+import std;
+
+import gse.math;
+import gse.utility;
+
+export namespace gse::network {
+	struct baseline_key {
+		std::uint16_t type = 0;
+		uuid owner = 0;
+
+		auto operator==(
+			const baseline_key&
+		) const -> bool = default;
+	};
+
+	struct baseline_key_hash {
+		auto operator()(
+			const baseline_key& k
+		) const noexcept -> std::size_t {
+			return std::hash<uuid>{}(k.owner) ^ (static_cast<std::size_t>(k.type) << 48);
+		}
+	};
+
+	constexpr std::uint32_t no_baseline = 0;
+	constexpr std::size_t baseline_history_depth = 32;
+
+	class baseline_store {
+	public:
+		auto acked(
+			const baseline_key& key,
+			std::span<std::byte> out
+		) const -> std::uint32_t;
+
+		auto record(
+			const baseline_key& key,
+			std::span<const std::byte> data,
+			std::uint32_t encoded_against
+		) -> std::uint32_t;
+
+		auto assign(
+			std::uint32_t token,
+			std::uint32_t sequence
+		) -> void;
+
+		auto acknowledge(
+			std::uint32_t ack,
+			std::uint32_t ack_bits
+		) -> void;
+
+		auto forget(
+			const baseline_key& key
+		) -> void;
+
+		auto size(
+		) const -> std::size_t;
+
+		auto pending(
+		) const -> std::size_t;
+	private:
+		struct snapshot {
+			std::uint32_t sequence = 0;
+			std::uint32_t generation = 0;
+			std::vector<std::byte> data;
+		};
+
+		struct pending_snapshot {
+			baseline_key key;
+			snapshot state;
+			std::uint32_t encoded_against = no_baseline;
+			std::uint64_t recorded_ms = 0;
+		};
+
+		auto acked_sequence(
+			std::uint32_t sequence
+		) const -> bool;
+
+		auto promote(
+			pending_snapshot& entry
+		) -> void;
+
+		static constexpr std::uint32_t max_pending_age = 64;
+		static constexpr std::uint64_t max_pending_ms = 2000;
+		static constexpr std::size_t ack_history_size = 1024;
+
+		mutable std::mutex m_mutex;
+		std::unordered_map<baseline_key, snapshot, baseline_key_hash> m_acked;
+		std::unordered_map<baseline_key, std::uint32_t, baseline_key_hash> m_generations;
+		std::unordered_map<std::uint32_t, pending_snapshot> m_pending;
+		std::array<std::uint32_t, ack_history_size> m_ack_history{};
+		std::uint32_t m_next_token = 1;
+	};
+
+	class baseline_history {
+	public:
+		auto store(
+			const baseline_key& key,
+			std::uint32_t sequence,
+			std::span<const std::byte> data
+		) -> void;
+
+		auto find(
+			const baseline_key& key,
+			std::uint32_t sequence
+		) -> std::span<const std::byte>;
+
+		auto forget(
+			const baseline_key& key
+		) -> void;
+	private:
+		struct entry {
+			std::uint32_t sequence = 0;
+			std::vector<std::byte> data;
+		};
+
+		struct history {
+			std::deque<entry> entries;
+			std::uint32_t pinned = no_baseline;
+		};
+
+		std::unordered_map<baseline_key, history, baseline_key_hash> m_histories;
+	};
+}
+
+auto gse::network::baseline_store::acked(const baseline_key& key, const std::span<std::byte> out) const -> std::uint32_t {
+	std::lock_guard lock(m_mutex);
+
+	const auto it = m_acked.find(key);
+	if (it == m_acked.end() || it->second.data.size() != out.size()) {
+		return no_baseline;
+	}
+
+	if (const auto g = m_generations.find(key); g == m_generations.end() || g->second - it->second.generation >= baseline_history_depth - 1) {
+		return no_baseline;
+	}
+
+	std::ranges::copy(it->second.data, out.begin());
+	return it->second.sequence;
+}
+
+auto gse::network::baseline_store::record(const baseline_key& key, const std::span<const std::byte> data, const std::uint32_t encoded_against) -> std::uint32_t {
+	std::lock_guard lock(m_mutex);
+
+	const std::uint32_t token = m_next_token++;
+	if (m_next_token == 0) {
+		m_next_token = 1;
+	}
+
+	m_pending[token] = {
+		.key = key,
+		.state = {
+			.sequence = no_baseline,
+			.generation = ++m_generations[key],
+			.data = { data.begin(), data.end() }
+		},
+		.encoded_against = encoded_against,
+		.recorded_ms = system_clock::now<time_t<std::uint64_t, milliseconds>>().as<milliseconds>()
+	};
+
+	return token;
+}
+
+auto gse::network::baseline_store::assign(const std::uint32_t token, const std::uint32_t sequence) -> void {
+	std::lock_guard lock(m_mutex);
+
+	if (const auto it = m_pending.find(token); it != m_pending.end()) {
+		it->second.state.sequence = sequence;
+		if (acked_sequence(sequence)) {
+			promote(it->second);
+			m_pending.erase(it);
+		}
+	}
+}
+
+auto gse::network::baseline_store::acknowledge(const std::uint32_t ack, const std::uint32_t ack_bits) -> void {
+	if (ack == 0) {
+		return;
+	}
+
+	std::lock_guard lock(m_mutex);
+
+	m_ack_history[ack % ack_history_size] = ack;
+	for (std::uint32_t bits = ack_bits; bits != 0; bits &= bits - 1) {
+		if (const std::uint32_t diff = 1 + std::countr_zero(bits); diff < ack) {
+			m_ack_history[(ack - diff) % ack_history_size] = ack - diff;
+		}
+	}
+
+	const auto now = system_clock::now<time_t<std::uint64_t, milliseconds>>().as<milliseconds>();
+
+	for (auto it = m_pending.begin(); it != m_pending.end();) {
+		auto& entry = it->second;
+		bool expired = now - entry.recorded_ms > max_pending_ms;
+
+		if (entry.state.sequence != no_baseline) {
+			if (acked_sequence(entry.state.sequence)) {
+				promote(entry);
+				expired = true;
+			}
+			else if (entry.state.sequence + max_pending_age < ack) {
+				expired = true;
+			}
+		}
+
+		it = expired ? m_pending.erase(it) : std::next(it);
+	}
+}
+
+auto gse::network::baseline_store::acked_sequence(const std::uint32_t sequence) const -> bool {
+	return sequence != no_baseline && m_ack_history[sequence % ack_history_size] == sequence;
+}
+
+auto gse::network::baseline_store::promote(pending_snapshot& entry) -> void {
+	const auto it = m_acked.find(entry.key);
+	if (entry.encoded_against != no_baseline && (it == m_acked.end() || it->second.sequence < entry.encoded_against)) {
+		return;
+	}
+
+	if (it == m_acked.end()) {
+		m_acked.emplace(entry.key, std::move(entry.state));
+	}
+	else if (it->second.sequence < entry.state.sequence) {
+		it->second = std::move(entry.state);
+	}
+}
+
+auto gse::network::baseline_store::forget(const baseline_key& key) -> void {
+	std::lock_guard lock(m_mutex);
+
+	m_acked.erase(key);
+	m_generations.erase(key);
+	std::erase_if(m_pending, [&](const auto& entry) {
+		return entry.second.key == key;
+	});
+}
+
+auto gse::network::baseline_store::size() const -> std::size_t {
+	std::lock_guard lock(m_mutex);
+	return m_acked.size();
+}
+
+auto gse::network::baseline_store::pending() const -> std::size_t {
+	std::lock_guard lock(m_mutex);
+	return m_pending.size();
+}
+
+auto gse::network::baseline_history::store(const baseline_key& key, const std::uint32_t sequence, const std::span<const std::byte> data) -> void {
+	auto& [entries, pinned] = m_histories[key];
+
+	const auto it = std::ranges::find(entries, sequence, &entry::sequence);
+	if (it != entries.end()) {
+		it->data.assign(data.begin(), data.end());
+		return;
+	}
+
+	entries.push_back({
+		.sequence = sequence,
+		.data = { data.begin(), data.end() }
+	});
+
+	while (entries.size() > baseline_history_depth) {
+		const auto victim = std::ranges::find_if(entries, [pinned](const entry& e) {
+			return e.sequence != pinned;
+		});
+		entries.erase(victim);
+	}
+}
+
+auto gse::network::baseline_history::find(const baseline_key& key, const std::uint32_t sequence) -> std::span<const std::byte> {
+	const auto h = m_histories.find(key);
+	if (h == m_histories.end()) {
+		return {};
+	}
+
+	const auto it = std::ranges::find(h->second.entries, sequence, &entry::sequence);
+	if (it == h->second.entries.end()) {
+		return {};
+	}
+
+	h->second.pinned = sequence;
+	return it->data;
+}
+
+auto gse::network::baseline_history::forget(const baseline_key& key) -> void {
+	m_histories.erase(key);
+}
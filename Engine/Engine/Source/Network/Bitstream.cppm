@@ -31,6 +31,11 @@ export namespace gse::network {
 			std::size_t bytes
 		) -> void;
 
+		auto write_bits(
+			std::uint64_t value,
+			std::size_t count
+		) -> void;
+
 		template <is_trivially_copyable T>
 		auto read(
 		) -> T;
@@ -44,6 +49,10 @@ export namespace gse::network {
 			std::size_t bytes
 		) -> void;
 
+		auto read_bits(
+			std::size_t count
+		) -> std::uint64_t;
+
 		auto bytes_written(
 		) const -> std::size_t;
 
@@ -56,6 +65,13 @@ export namespace gse::network {
 		auto remaining_bytes(
 		) const -> std::size_t;
 
+		auto read_span(
+			std::size_t bytes
+		) -> std::span<const std::byte>;
+
+		auto remaining_span(
+		) const -> std::span<const std::byte>;
+
 		auto good(
 		) const -> bool;
 
@@ -147,6 +163,34 @@ auto gse::network::bitstream::write_bytes(const std::byte* data, const std::size
 	write(std::span(data, bytes));
 }
 
+auto gse::network::bitstream::write_bits(const std::uint64_t value, const std::size_t count) -> void {
+	const bool ok = count <= 64 && can_advance(count);
+
+	assert(
+		ok,
+		std::source_location::current(),
+		"Bitstream overflow id=0x{:04X} need={} have={} head_bits={}", m_cur_msg_id, count, remaining_bits(), m_head_bits
+	);
+
+	if (!ok) {
+		m_error = true;
+		return;
+	}
+
+	for (std::size_t i = 0; i < count; ++i) {
+		const auto byte_index = m_head_bits / 8;
+		const auto bit_index = m_head_bits % 8;
+		const std::byte mask = (std::byte{ 1 } << bit_index);
+		if ((value >> i) & 1u) {
+			m_buffer[byte_index] |= mask;
+		}
+		else {
+			m_buffer[byte_index] &= ~mask;
+		}
+		++m_head_bits;
+	}
+}
+
 template <gse::is_trivially_copyable T>
 auto gse::network::bitstream::read() -> T {
 	T data{};
@@ -190,6 +234,26 @@ auto gse::network::bitstream::read_bytes(std::byte* data, const std::size_t byte
 	read(std::span(data, bytes));
 }
 
+auto gse::network::bitstream::read_bits(const std::size_t count) -> std::uint64_t {
+	if (count > 64 || !can_advance(count)) {
+		std::println("[Network Warning] Incomplete packet read: need {} bits, have {} bits available",
+			count, m_buffer.size() * 8 - m_head_bits);
+		m_error = true;
+		return 0;
+	}
+
+	std::uint64_t value = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		const auto byte_index = m_head_bits / 8;
+		if (const auto bit_index = m_head_bits % 8; (m_buffer[byte_index] & (std::byte{ 1 } << bit_index)) != std::byte{ 0 }) {
+			value |= std::uint64_t{ 1 } << i;
+		}
+		++m_head_bits;
+	}
+
+	return value;
+}
+
 auto gse::network::bitstream::bytes_written() const -> std::size_t {
 	return (m_head_bits + 7) / 8;
 }
@@ -207,6 +271,25 @@ auto gse::network::bitstream::remaining_bytes() const -> std::size_t {
 	return remaining_bits() / 8;
 }
 
+auto gse::network::bitstream::read_span(const std::size_t bytes) -> std::span<const std::byte> {
+	if (m_head_bits % 8 != 0 || !can_advance(bytes * 8)) {
+		m_error = true;
+		return {};
+	}
+
+	const auto out = std::span<const std::byte>(m_buffer).subspan(m_head_bits / 8, bytes);
+	m_head_bits += bytes * 8;
+	return out;
+}
+
+auto gse::network::bitstream::remaining_span() const -> std::span<const std::byte> {
+	if (m_head_bits % 8 != 0) {
+		return {};
+	}
+
+	return std::span<const std::byte>(m_buffer).subspan(std::min(m_head_bits / 8, m_buffer.size()));
+}
+
 auto gse::network::bitstream::good() const -> bool {
 	return !m_error;
 }
@@ -11,8 +11,10 @@ import :actions;
 import :socket;
 import :remote_peer;
 import :message;
+import :message_batch;
 import :packet_header;
 import :bitstream;
+import :packet_buffer;
 import :connection;
 import :ping_pong;
 import :notify_scene_change;
@@ -22,8 +24,10 @@ import :server_info;
 export namespace gse::network {
 	struct replication_message {
 		std::uint16_t id;
-		std::vector<std::byte> payload;
+		packet_slice payload;
 		std::uint32_t sequence;
+		std::uint32_t server_time;
+		std::uint64_t received_time;
 	};
 
 	using inbox_message = std::variant<
@@ -32,7 +36,8 @@ export namespace gse::network {
 		pong,
 		notify_scene_change,
 		replication_message,
-		server_info_response
+		server_info_response,
+		input_ack
 	>;
 
 	class client {
@@ -75,14 +80,28 @@ export namespace gse::network {
 			std::span<const std::uint16_t> axis1_ids,
 			std::span<const std::uint16_t> axis2_ids,
 			angle camera_yaw = {}
-		) -> void;
+		) -> std::uint32_t;
 
+		auto input_sequence(
+		) const -> std::uint32_t;
 	private:
 		auto send_ack(
 		) -> void;
+
+		auto handle_message(
+			bitstream& stream,
+			std::uint16_t id,
+			const packet_buffer& source
+		) -> void;
+
 		udp_socket m_socket;
 		remote_peer m_server;
+		std::uint32_t m_packet_sequence = 0;
+		std::uint32_t m_packet_server_time = 0;
+		std::uint64_t m_packet_received_time = 0;
+		std::uint32_t m_received_since_ack = 0;
 		std::atomic<state> m_state = state::disconnected;
+		packet_buffer m_receive_buffer = packet_buffer::acquire();
 
 		time_t<std::uint32_t> m_timeout;
 		time_t<std::uint32_t> m_retry;
@@ -96,10 +115,11 @@ export namespace gse::network {
 		std::jthread m_thread;
 		std::atomic<bool> m_running{ false };
 
-		std::uint32_t m_input_sequence = 0;
+		std::atomic<std::uint32_t> m_input_sequence = 0;
 		clock m_input_clock;
 
 		struct input_snapshot {
+			std::uint32_t sequence = 0;
 			actions::state state;
 			std::vector<std::uint16_t> axis1_ids;
 			std::vector<std::uint16_t> axis2_ids;
@@ -187,17 +207,23 @@ auto gse::network::client::tick() -> void {
 		}
 	}
 
-	std::array<std::byte, max_packet_size> buffer;
-	while (const auto received = m_socket.receive_data(buffer)) {
+	while (const auto received = m_socket.receive_data(m_receive_buffer.data())) {
 		if (received->from.ip != m_server.addr().ip ||
 			received->from.port != m_server.addr().port) {
 			continue;
 		}
 
-		const std::span received_data(buffer.data(), received->bytes_read);
-		bitstream stream(received_data);
+		auto incoming = std::move(m_receive_buffer);
+		incoming.resize(received->bytes_read);
 
-		if (const auto header = stream.read<packet_header>(); header.sequence > m_server.remote_ack_sequence()) {
+		auto stream = bitstream::reader(incoming.bytes());
+
+		const auto header = stream.read<packet_header>();
+		m_packet_sequence = header.sequence;
+		m_packet_server_time = header.server_time;
+		m_packet_received_time = current_time_ms();
+
+		if (header.sequence > m_server.remote_ack_sequence()) {
 			if (const std::uint32_t diff = header.sequence - m_server.remote_ack_sequence(); diff < 32) {
 				m_server.remote_ack_bitfield() <<= diff;
 				m_server.remote_ack_bitfield() |= (1 << (diff - 1));
@@ -213,63 +239,23 @@ auto gse::network::client::tick() -> void {
 			}
 		}
 
-		const auto id = message_id(stream);
-		bool handled_internally = false;
-
-		match_message(stream, id)
-			.if_is<connection_accepted>([&](const connection_accepted&) {
-				std::println("Client: Connected to {}:{}", m_server.addr().ip, m_server.addr().port);
-				m_state = state::connected;
-				send_ack();
-				{
-					std::lock_guard lk(m_inbox_mutex);
-					m_inbox.emplace_back(connection_accepted{});
-				}
-				handled_internally = true;
-			})
-			.else_if_is<ping>([&](const ping& m) {
-				send(pong{ .sequence = m.sequence });
-				std::lock_guard lk(m_inbox_mutex);
-				m_inbox.emplace_back(m);
-				handled_internally = true;
-			})
-			.else_if_is<pong>([&](const pong& m) {
-				std::lock_guard lk(m_inbox_mutex);
-				m_inbox.emplace_back(m);
-				handled_internally = true;
-			})
-			.else_if_is<notify_scene_change>([&](const notify_scene_change& m) {
-				send_ack();
-				{
-					std::lock_guard lk(m_inbox_mutex);
-					m_inbox.emplace_back(m);
-				}
-				handled_internally = true;
-			})
-			.else_if_is<server_info_response>([&](const server_info_response& m) {
-				std::lock_guard lk(m_inbox_mutex);
-				m_inbox.emplace_back(m);
-				handled_internally = true;
-			});
+		if (current == state::connected && ++m_received_since_ack >= 16) {
+			send_ack();
+		}
 
-			if (!handled_internally) {
-				std::vector<std::byte> payload;
-
-				if (const auto remaining = stream.remaining_bytes(); remaining > 0) {
-					payload.resize(remaining);
-					stream.read_bytes(payload.data(), remaining);
-					
-					std::lock_guard lk(m_inbox_mutex);
-					m_inbox.emplace_back(replication_message{
-						.id = id,
-						.payload = std::move(payload),
-						.sequence = m_server.remote_ack_sequence()
-					});
-				}
-			}
+		if (const auto id = message_id(stream); id == message_id(std::type_identity<message_batch>{})) {
+			for_each_batched(stream, [&](bitstream& entry, const std::uint16_t entry_id) {
+				handle_message(entry, entry_id, incoming);
+			});
 		}
+		else {
+			handle_message(stream, id, incoming);
+		}
+
+		m_receive_buffer = incoming.use_count() == 1 ? std::move(incoming) : packet_buffer::acquire();
+	}
 
-		if (current == state::connected) {
+	if (current == state::connected) {
 		if (m_input_clock.elapsed<std::uint32_t>() > milliseconds(16u)) {
 			std::optional<input_snapshot> next;
 
@@ -287,17 +273,19 @@ auto gse::network::client::tick() -> void {
 			}
 
 			if (m_has_last_input) {
+				std::array<std::byte, max_packet_size> buffer;
 				send_input_frame(
 					m_socket,
 					m_server,
 					buffer,
-					++m_input_sequence,
+					m_last_input.sequence,
 					m_last_input.state,
 					m_last_input.axis1_ids,
 					m_last_input.axis2_ids,
 					m_last_input.camera_yaw
 				);
 				m_input_clock.reset();
+				m_received_since_ack = 0;
 
 				// Clear transient pressed/released bits after first transmission
 				// to prevent re-sending stale key presses on retransmits
@@ -309,6 +297,67 @@ auto gse::network::client::tick() -> void {
 	}
 }
 
+auto gse::network::client::handle_message(bitstream& stream, const std::uint16_t id, const packet_buffer& source) -> void {
+	bool handled_internally = false;
+
+	match_message(stream, id)
+		.if_is<connection_accepted>([&](const connection_accepted&) {
+			std::println("Client: Connected to {}:{}", m_server.addr().ip, m_server.addr().port);
+			m_state = state::connected;
+			send_ack();
+			{
+				std::lock_guard lk(m_inbox_mutex);
+				m_inbox.emplace_back(connection_accepted{});
+			}
+			handled_internally = true;
+		})
+		.else_if_is<ping>([&](const ping& m) {
+			send(pong{ .sequence = m.sequence });
+			std::lock_guard lk(m_inbox_mutex);
+			m_inbox.emplace_back(m);
+			handled_internally = true;
+		})
+		.else_if_is<pong>([&](const pong& m) {
+			std::lock_guard lk(m_inbox_mutex);
+			m_inbox.emplace_back(m);
+			handled_internally = true;
+		})
+		.else_if_is<notify_scene_change>([&](const notify_scene_change& m) {
+			send_ack();
+			{
+				std::lock_guard lk(m_inbox_mutex);
+				m_inbox.emplace_back(m);
+			}
+			handled_internally = true;
+		})
+		.else_if_is<server_info_response>([&](const server_info_response& m) {
+			std::lock_guard lk(m_inbox_mutex);
+			m_inbox.emplace_back(m);
+			handled_internally = true;
+		})
+		.else_if_is<input_ack>([&](const input_ack& m) {
+			std::lock_guard lk(m_inbox_mutex);
+			m_inbox.emplace_back(m);
+			handled_internally = true;
+		});
+
+	if (!handled_internally) {
+		if (const auto payload = stream.remaining_span(); !payload.empty()) {
+			std::lock_guard lk(m_inbox_mutex);
+			m_inbox.emplace_back(replication_message{
+				.id = id,
+				.payload = {
+					.owner = source,
+					.bytes = payload
+				},
+				.sequence = m_packet_sequence,
+				.server_time = m_packet_server_time,
+				.received_time = m_packet_received_time
+			});
+		}
+	}
+}
+
 auto gse::network::client::current_state() const -> state {
 	return m_state.load(std::memory_order_relaxed);
 }
@@ -333,6 +382,7 @@ auto gse::network::client::send(const T& msg) -> void {
 	};
 
 	(void)m_socket.send_data(pkt, m_server.addr());
+	m_received_since_ack = 0;
 }
 
 auto gse::network::client::drain(const std::function<void(inbox_message&)>& on_receive) -> void {
@@ -347,15 +397,23 @@ auto gse::network::client::drain(const std::function<void(inbox_message&)>& on_r
 	}
 }
 
-auto gse::network::client::push_input(const actions::state& s, std::span<const std::uint16_t> axis1_ids, std::span<const std::uint16_t> axis2_ids, const angle camera_yaw) -> void {
+auto gse::network::client::push_input(const actions::state& s, std::span<const std::uint16_t> axis1_ids, std::span<const std::uint16_t> axis2_ids, const angle camera_yaw) -> std::uint32_t {
 	input_snapshot snap;
+	snap.sequence = m_input_sequence.fetch_add(1, std::memory_order_acq_rel) + 1;
 	snap.state = s;
 	snap.axis1_ids.assign(axis1_ids.begin(), axis1_ids.end());
 	snap.axis2_ids.assign(axis2_ids.begin(), axis2_ids.end());
 	snap.camera_yaw = camera_yaw;
 
+	const auto sequence = snap.sequence;
+
 	std::lock_guard lk(m_input_mutex);
 	m_next_input.emplace(std::move(snap));
+	return sequence;
+}
+
+auto gse::network::client::input_sequence() const -> std::uint32_t {
+	return m_input_sequence.load(std::memory_order_acquire);
 }
 
 auto gse::network::client::send_ack() -> void {
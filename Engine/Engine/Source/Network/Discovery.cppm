@@ -16,8 +16,8 @@ export namespace gse::network {
         address addr;
         std::string name;
         std::string map;
-        std::uint8_t players{};
-        std::uint8_t max_players{};
+        std::uint16_t players{};
+        std::uint16_t max_players{};
         std::uint32_t build{};
     };
 
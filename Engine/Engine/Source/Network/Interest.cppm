@@ -0,0 +1,260 @@
+export module gse.network:interest;
+
+import std;
+
+import gse.utility;
+import gse.math;
+import gse.physics;
+
+import :socket;
+import :registry_sync;
+
+export namespace gse::network {
+	struct interest_config {
+		length cell_size = meters(32.f);
+		length radius = meters(96.f);
+		length hysteresis = meters(16.f);
+	};
+
+	struct interest_viewer {
+		address addr;
+		std::optional<vec3<length>> position;
+	};
+
+	class interest_manager {
+	public:
+		explicit interest_manager(
+			const interest_config& config = {}
+		);
+
+		auto update(
+			registry& reg,
+			std::span<const interest_viewer> viewers
+		) -> void;
+
+		auto relevant(
+			const address& addr,
+			id entity
+		) const -> bool;
+
+		auto entered(
+			const address& addr,
+			id entity
+		) const -> bool;
+
+		auto entered(
+			const address& addr
+		) const -> std::span<const id>;
+
+		auto left(
+			const address& addr
+		) const -> std::span<const id>;
+
+		auto viewer_distance(
+			const address& addr,
+			id entity
+		) const -> length;
+
+		auto reset(
+			const address& addr
+		) -> void;
+
+		auto forget(
+			const address& addr
+		) -> void;
+
+		auto tracked_entities(
+		) const -> std::size_t;
+	private:
+		using cell_key = std::uint64_t;
+
+		struct peer_interest {
+			std::unordered_set<id> relevant;
+			std::unordered_set<id> entered_set;
+			std::vector<id> entered;
+			std::vector<id> left;
+			std::optional<vec3f> center;
+		};
+
+		struct tracked_entity {
+			id owner;
+			vec3f position;
+		};
+
+		auto cell_of(
+			const vec3f& position
+		) const -> std::array<std::int32_t, 3>;
+
+		static auto key_of(
+			const std::array<std::int32_t, 3>& cell
+		) -> cell_key;
+
+		interest_config m_config;
+		std::vector<tracked_entity> m_spatial;
+		std::unordered_map<id, std::size_t> m_spatial_index;
+		std::vector<id> m_global;
+		std::unordered_map<cell_key, std::vector<std::size_t>> m_cells;
+		std::map<address, peer_interest> m_peers;
+	};
+}
+
+gse::network::interest_manager::interest_manager(const interest_config& config) : m_config(config) {}
+
+auto gse::network::interest_manager::update(registry& reg, const std::span<const interest_viewer> viewers) -> void {
+	m_spatial.clear();
+	m_spatial_index.clear();
+	m_global.clear();
+	m_cells.clear();
+
+	for (const auto& mc : reg.linked_objects_read<physics::motion_component>()) {
+		const auto& p = mc.current_position;
+		const vec3f position(p.x().as<meters>(), p.y().as<meters>(), p.z().as<meters>());
+
+		m_spatial_index.emplace(mc.owner_id(), m_spatial.size());
+		m_cells[key_of(cell_of(position))].push_back(m_spatial.size());
+		m_spatial.push_back({ .owner = mc.owner_id(), .position = position });
+	}
+
+	std::unordered_set<id> seen_global;
+	for_each_networked_component([&]<typename C>() {
+		for (const auto& c : reg.linked_objects_read<C>()) {
+			if (!m_spatial_index.contains(c.owner_id()) && seen_global.insert(c.owner_id()).second) {
+				m_global.push_back(c.owner_id());
+			}
+		}
+	});
+
+	const float radius = m_config.radius.as<meters>();
+	const float keep_radius = radius + m_config.hysteresis.as<meters>();
+	const auto reach = static_cast<std::int32_t>(std::ceil(keep_radius / m_config.cell_size.as<meters>()));
+
+	std::erase_if(m_peers, [&](const auto& entry) {
+		return std::ranges::none_of(viewers, [&](const interest_viewer& v) {
+			return v.addr == entry.first;
+		});
+	});
+
+	for (const auto& [addr, position] : viewers) {
+		auto& peer = m_peers[addr];
+		peer.center.reset();
+
+		std::unordered_set<id> next;
+		next.reserve(peer.relevant.size() + m_global.size());
+		next.insert(m_global.begin(), m_global.end());
+
+		if (!position) {
+			for (const auto& e : m_spatial) {
+				next.insert(e.owner);
+			}
+		}
+		else {
+			const vec3f center(position->x().as<meters>(), position->y().as<meters>(), position->z().as<meters>());
+			peer.center = center;
+			const auto origin = cell_of(center);
+
+			for (std::int32_t x = -reach; x <= reach; ++x) {
+				for (std::int32_t y = -reach; y <= reach; ++y) {
+					for (std::int32_t z = -reach; z <= reach; ++z) {
+						const auto it = m_cells.find(key_of({ origin[0] + x, origin[1] + y, origin[2] + z }));
+						if (it == m_cells.end()) {
+							continue;
+						}
+
+						for (const auto index : it->second) {
+							const auto& [owner, p] = m_spatial[index];
+							const float d = distance(p, center);
+							if (d <= radius || (d <= keep_radius && peer.relevant.contains(owner))) {
+								next.insert(owner);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		peer.entered.clear();
+		peer.entered_set.clear();
+		peer.left.clear();
+
+		for (const auto& e : next) {
+			if (!peer.relevant.contains(e)) {
+				peer.entered.push_back(e);
+				peer.entered_set.insert(e);
+			}
+		}
+
+		for (const auto& e : peer.relevant) {
+			if (!next.contains(e) && (m_spatial_index.contains(e) || seen_global.contains(e))) {
+				peer.left.push_back(e);
+			}
+		}
+
+		peer.relevant = std::move(next);
+	}
+
+	trace::counter(find_or_generate_id("network.interest.tracked"), static_cast<double>(m_spatial.size() + m_global.size()));
+}
+
+auto gse::network::interest_manager::relevant(const address& addr, const id entity) const -> bool {
+	const auto it = m_peers.find(addr);
+	return it != m_peers.end() && it->second.relevant.contains(entity);
+}
+
+auto gse::network::interest_manager::entered(const address& addr, const id entity) const -> bool {
+	const auto it = m_peers.find(addr);
+	return it != m_peers.end() && it->second.entered_set.contains(entity);
+}
+
+auto gse::network::interest_manager::entered(const address& addr) const -> std::span<const id> {
+	const auto it = m_peers.find(addr);
+	if (it == m_peers.end()) {
+		return {};
+	}
+	return it->second.entered;
+}
+
+auto gse::network::interest_manager::left(const address& addr) const -> std::span<const id> {
+	const auto it = m_peers.find(addr);
+	if (it == m_peers.end()) {
+		return {};
+	}
+	return it->second.left;
+}
+
+auto gse::network::interest_manager::viewer_distance(const address& addr, const id entity) const -> length {
+	const auto peer = m_peers.find(addr);
+	const auto it = m_spatial_index.find(entity);
+	if (peer == m_peers.end() || !peer->second.center || it == m_spatial_index.end()) {
+		return {};
+	}
+
+	return meters(distance(m_spatial[it->second].position, *peer->second.center));
+}
+
+auto gse::network::interest_manager::reset(const address& addr) -> void {
+	m_peers[addr] = {};
+}
+
+auto gse::network::interest_manager::forget(const address& addr) -> void {
+	m_peers.erase(addr);
+}
+
+auto gse::network::interest_manager::tracked_entities() const -> std::size_t {
+	return m_spatial.size() + m_global.size();
+}
+
+auto gse::network::interest_manager::cell_of(const vec3f& position) const -> std::array<std::int32_t, 3> {
+	const float size = m_config.cell_size.as<meters>();
+	return {
+		static_cast<std::int32_t>(std::floor(position.x() / size)),
+		static_cast<std::int32_t>(std::floor(position.y() / size)),
+		static_cast<std::int32_t>(std::floor(position.z() / size))
+	};
+}
+
+auto gse::network::interest_manager::key_of(const std::array<std::int32_t, 3>& cell) -> cell_key {
+	constexpr std::uint64_t mask = (std::uint64_t{ 1 } << 21) - 1;
+	return (static_cast<std::uint64_t>(cell[0]) & mask)
+		| ((static_cast<std::uint64_t>(cell[1]) & mask) << 21)
+		| ((static_cast<std::uint64_t>(cell[2]) & mask) << 42);
+}
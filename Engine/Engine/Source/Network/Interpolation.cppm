@@ -0,0 +1,237 @@
+export module gse.network:interpolation;
+
+import std;
+
+import gse.utility;
+import gse.math;
+
+export namespace gse::network {
+	struct interpolation_config {
+		time_t<float, seconds> min_delay = milliseconds(33.f);
+		time_t<float, seconds> max_delay = milliseconds(300.f);
+		time_t<float, seconds> max_extrapolation = milliseconds(120.f);
+		float jitter_multiplier = 3.f;
+		float delay_adapt_rate = 0.05f;
+	};
+
+	struct entity_snapshot {
+		std::uint32_t server_time = 0;
+		vec3<length> position;
+		vec3<velocity> velocity;
+		quat orientation = quat(1.f, 0.f, 0.f, 0.f);
+	};
+
+	class interpolation_buffer {
+	public:
+		explicit interpolation_buffer(
+			const interpolation_config& config = {}
+		);
+
+		auto observe(
+			std::uint32_t server_time,
+			std::uint64_t received_time
+		) -> void;
+
+		auto push(
+			id entity,
+			const entity_snapshot& snapshot
+		) -> void;
+
+		auto forget(
+			id entity
+		) -> void;
+
+		auto clear(
+		) -> void;
+
+		auto playout_time(
+			std::uint64_t local_time
+		) const -> double;
+
+		auto sample(
+			id entity,
+			double time
+		) -> std::optional<entity_snapshot>;
+
+		template <typename F>
+		auto for_each(
+			double time,
+			F&& f
+		) -> void;
+
+		auto delay(
+		) const -> time_t<float, seconds>;
+
+		auto jitter(
+		) const -> time_t<float, seconds>;
+	private:
+		struct timed_snapshot {
+			std::int64_t time = 0;
+			entity_snapshot state;
+		};
+
+		auto unwrap(
+			std::uint32_t server_time
+		) const -> std::int64_t;
+
+		static constexpr std::size_t max_snapshots = 32;
+
+		interpolation_config m_config;
+		std::unordered_map<id, std::deque<timed_snapshot>> m_entities;
+
+		bool m_synced = false;
+		std::uint32_t m_last_server_time = 0;
+		std::int64_t m_server_clock = 0;
+		std::uint64_t m_last_received_time = 0;
+		double m_transit = 0.0;
+		float m_jitter = 0.f;
+		float m_interval = 0.f;
+		float m_delay = 0.f;
+	};
+}
+
+gse::network::interpolation_buffer::interpolation_buffer(const interpolation_config& config) : m_config(config), m_delay(config.min_delay.as<milliseconds>()) {}
+
+auto gse::network::interpolation_buffer::observe(const std::uint32_t server_time, const std::uint64_t received_time) -> void {
+	if (server_time == 0) {
+		return;
+	}
+
+	if (!m_synced) {
+		m_synced = true;
+		m_server_clock = server_time;
+		m_transit = static_cast<double>(received_time) - static_cast<double>(m_server_clock);
+		m_last_server_time = server_time;
+		m_last_received_time = received_time;
+		return;
+	}
+
+	const auto sent_delta = static_cast<std::int32_t>(server_time - m_last_server_time);
+	if (sent_delta <= 0) {
+		return;
+	}
+
+	m_server_clock += sent_delta;
+	const double transit = static_cast<double>(received_time) - static_cast<double>(m_server_clock);
+
+	const auto received_delta = static_cast<float>(static_cast<std::int64_t>(received_time - m_last_received_time));
+	const float d = std::abs(received_delta - static_cast<float>(sent_delta));
+
+	m_jitter += (d - m_jitter) / 16.f;
+	m_interval += (static_cast<float>(sent_delta) - m_interval) / 16.f;
+	m_transit += (transit - m_transit) / 16.0;
+
+	m_last_server_time = server_time;
+	m_last_received_time = received_time;
+
+	const float target = std::clamp(
+		m_interval + m_config.jitter_multiplier * m_jitter,
+		m_config.min_delay.as<milliseconds>(),
+		m_config.max_delay.as<milliseconds>()
+	);
+
+	m_delay += (target - m_delay) * m_config.delay_adapt_rate;
+}
+
+auto gse::network::interpolation_buffer::push(const id entity, const entity_snapshot& snapshot) -> void {
+	auto& history = m_entities[entity];
+	const auto time = unwrap(snapshot.server_time);
+
+	const auto it = std::ranges::find_if(history | std::views::reverse, [&](const timed_snapshot& s) {
+		return s.time <= time;
+	});
+
+	if (it != history.rend() && it->time == time) {
+		it->state = snapshot;
+		return;
+	}
+
+	history.insert(it.base(), { .time = time, .state = snapshot });
+
+	if (history.size() > max_snapshots) {
+		history.pop_front();
+	}
+}
+
+auto gse::network::interpolation_buffer::forget(const id entity) -> void {
+	m_entities.erase(entity);
+}
+
+auto gse::network::interpolation_buffer::clear() -> void {
+	m_entities.clear();
+	m_synced = false;
+	m_jitter = 0.f;
+	m_interval = 0.f;
+	m_delay = m_config.min_delay.as<milliseconds>();
+}
+
+auto gse::network::interpolation_buffer::playout_time(const std::uint64_t local_time) const -> double {
+	return static_cast<double>(local_time) - m_transit - static_cast<double>(m_delay);
+}
+
+auto gse::network::interpolation_buffer::sample(const id entity, const double time) -> std::optional<entity_snapshot> {
+	const auto it = m_entities.find(entity);
+	if (it == m_entities.end() || it->second.empty()) {
+		return std::nullopt;
+	}
+
+	auto& history = it->second;
+
+	const auto offset = [&](const timed_snapshot& s) {
+		return static_cast<float>(time - static_cast<double>(s.time));
+	};
+
+	while (history.size() > 2 && offset(history[1]) >= 0.f) {
+		history.pop_front();
+	}
+
+	const auto& from = history.front();
+
+	if (offset(from) <= 0.f) {
+		return from.state;
+	}
+
+	if (history.size() == 1 || offset(history[1]) > 0.f) {
+		const auto& last = history.back();
+		const auto ahead = std::min(offset(last), m_config.max_extrapolation.as<milliseconds>());
+
+		auto out = last.state;
+		out.position += last.state.velocity * milliseconds(ahead);
+		return out;
+	}
+
+	const auto& to = history[1];
+	const float span = static_cast<float>(to.time - from.time);
+	const float t = std::clamp(offset(from) / span, 0.f, 1.f);
+
+	return entity_snapshot{
+		.server_time = from.state.server_time,
+		.position = lerp(from.state.position, to.state.position, t),
+		.velocity = lerp(from.state.velocity, to.state.velocity, t),
+		.orientation = slerp(from.state.orientation, to.state.orientation, t)
+	};
+}
+
+template <typename F>
+auto gse::network::interpolation_buffer::for_each(const double time, F&& f) -> void {
+	for (const auto& entity : m_entities | std::views::keys) {
+		if (const auto state = sample(entity, time)) {
+			std::invoke(f, entity, *state);
+		}
+	}
+}
+
+auto gse::network::interpolation_buffer::delay() const -> time_t<float, seconds> {
+	return milliseconds(m_delay);
+}
+
+auto gse::network::interpolation_buffer::jitter() const -> time_t<float, seconds> {
+	return milliseconds(m_jitter);
+}
+
+auto gse::network::interpolation_buffer::unwrap(const std::uint32_t server_time) const -> std::int64_t {
+	if (!m_synced) {
+		return server_time;
+	}
+	return m_server_clock + static_cast<std::int32_t>(server_time - m_last_server_time);
+}
@@ -0,0 +1,215 @@
+export module gse.network:link_conditioner;
+
+import std;
+
+import gse.utility;
+import gse.math;
+
+import :socket;
+import :packet_buffer;
+
+export namespace gse::network {
+	struct link_conditions {
+		time_t<float, seconds> latency = milliseconds(0.f);
+		time_t<float, seconds> jitter = milliseconds(0.f);
+		float loss = 0.f;
+		float reorder = 0.f;
+		std::size_t bandwidth = 0;
+		time_t<float, seconds> max_queue_delay = milliseconds(500.f);
+	};
+
+	struct link_stats {
+		std::size_t packets = 0;
+		std::size_t bytes = 0;
+		std::size_t lost = 0;
+		std::size_t throttled = 0;
+		std::size_t reordered = 0;
+	};
+
+	class link_conditioner {
+	public:
+		explicit link_conditioner(
+			udp_socket& socket,
+			const link_conditions& outgoing = {},
+			const link_conditions& incoming = {},
+			std::uint32_t seed = 0x5EED
+		);
+
+		auto send_data(
+			const packet& packet,
+			const address& address
+		) -> socket_state;
+
+		auto receive_data(
+			std::span<std::byte> buffer
+		) -> std::optional<udp_socket::receive_result>;
+
+		auto pump(
+		) -> void;
+
+		auto outgoing_stats(
+		) const -> const link_stats&;
+
+		auto incoming_stats(
+		) const -> const link_stats&;
+
+		auto socket(
+		) const -> udp_socket&;
+	private:
+		struct delayed_packet {
+			double due = 0.0;
+			std::uint64_t order = 0;
+			packet_buffer buffer;
+			address addr;
+		};
+
+		struct later {
+			auto operator()(
+				const delayed_packet& a,
+				const delayed_packet& b
+			) const -> bool {
+				return a.due != b.due ? a.due > b.due : a.order > b.order;
+			}
+		};
+
+		struct direction {
+			link_conditions conditions;
+			link_stats stats;
+			std::priority_queue<delayed_packet, std::vector<delayed_packet>, later> queue;
+			double link_free = 0.0;
+		};
+
+		static auto now(
+		) -> double;
+
+		auto admit(
+			direction& d,
+			std::span<const std::byte> data,
+			const address& addr
+		) -> bool;
+
+		udp_socket* m_socket;
+		direction m_outgoing;
+		direction m_incoming;
+		std::mt19937 m_rng;
+		std::uint64_t m_order = 0;
+	};
+}
+
+gse::network::link_conditioner::link_conditioner(udp_socket& socket, const link_conditions& outgoing, const link_conditions& incoming, const std::uint32_t seed)
+	: m_socket(std::addressof(socket)), m_rng(seed) {
+	m_outgoing.conditions = outgoing;
+	m_incoming.conditions = incoming;
+}
+
+auto gse::network::link_conditioner::send_data(const packet& packet, const address& address) -> socket_state {
+	(void)admit(m_outgoing, std::as_bytes(std::span(packet.data, packet.size)), address);
+	pump();
+	return socket_state::sending;
+}
+
+auto gse::network::link_conditioner::receive_data(const std::span<std::byte> buffer) -> std::optional<udp_socket::receive_result> {
+	pump();
+
+	if (m_incoming.queue.empty() || m_incoming.queue.top().due > now()) {
+		return std::nullopt;
+	}
+
+	auto next = std::move(const_cast<delayed_packet&>(m_incoming.queue.top()));
+	m_incoming.queue.pop();
+
+	const auto bytes = next.buffer.bytes();
+	const auto size = std::min(bytes.size(), buffer.size());
+	std::memcpy(buffer.data(), bytes.data(), size);
+
+	return udp_socket::receive_result{
+		.bytes_read = size,
+		.from = std::move(next.addr)
+	};
+}
+
+auto gse::network::link_conditioner::pump() -> void {
+	const double t = now();
+
+	while (!m_outgoing.queue.empty() && m_outgoing.queue.top().due <= t) {
+		const auto& top = m_outgoing.queue.top();
+		const auto bytes = top.buffer.bytes();
+		const packet p{
+			.data = reinterpret_cast<std::uint8_t*>(const_cast<std::byte*>(bytes.data())),
+			.size = bytes.size()
+		};
+		(void)m_socket->send_data(p, top.addr);
+		m_outgoing.queue.pop();
+	}
+
+	auto scratch = packet_buffer::acquire();
+	while (const auto received = m_socket->receive_data(scratch.data())) {
+		(void)admit(m_incoming, scratch.data().first(received->bytes_read), received->from);
+	}
+}
+
+auto gse::network::link_conditioner::outgoing_stats() const -> const link_stats& {
+	return m_outgoing.stats;
+}
+
+auto gse::network::link_conditioner::incoming_stats() const -> const link_stats& {
+	return m_incoming.stats;
+}
+
+auto gse::network::link_conditioner::socket() const -> udp_socket& {
+	return *m_socket;
+}
+
+auto gse::network::link_conditioner::now() -> double {
+	return system_clock::now<time_t<double, seconds>>().as<seconds>();
+}
+
+auto gse::network::link_conditioner::admit(direction& d, const std::span<const std::byte> data, const address& addr) -> bool {
+	const auto& c = d.conditions;
+	std::uniform_real_distribution chance(0.f, 1.f);
+
+	d.stats.packets++;
+	d.stats.bytes += data.size();
+
+	if (c.loss > 0.f && chance(m_rng) < c.loss) {
+		d.stats.lost++;
+		return false;
+	}
+
+	const double t = now();
+	double due = t + c.latency.as<seconds>();
+
+	if (c.jitter.as<seconds>() > 0.f) {
+		std::uniform_real_distribution spread(-c.jitter.as<seconds>(), c.jitter.as<seconds>());
+		due = std::max(t, due + spread(m_rng));
+	}
+
+	if (c.bandwidth > 0) {
+		const double start = std::max(t, d.link_free);
+		if (start - t > c.max_queue_delay.as<seconds>()) {
+			d.stats.throttled++;
+			return false;
+		}
+		d.link_free = start + static_cast<double>(data.size()) / static_cast<double>(c.bandwidth);
+		due = std::max(due, d.link_free);
+	}
+
+	if (c.reorder > 0.f && chance(m_rng) < c.reorder) {
+		due += std::max(c.jitter.as<seconds>(), 0.01f) * 2.0;
+		d.stats.reordered++;
+	}
+
+	auto buffer = packet_buffer::acquire();
+	const auto size = std::min(data.size(), buffer.data().size());
+	std::memcpy(buffer.data().data(), data.data(), size);
+	buffer.resize(size);
+
+	d.queue.push({
+		.due = due,
+		.order = m_order++,
+		.buffer = std::move(buffer),
+		.addr = addr
+	});
+
+	return true;
+}
@@ -2,6 +2,8 @@ export module gse.network:input_frame;
 
 import std;
 
+import gse.math;
+
 import :message;
 
 export namespace gse::network {
@@ -27,6 +29,26 @@ export namespace gse::network {
         bitstream& s,
         std::type_identity<input_frame_header>
 	) -> input_frame_header;
+
+    struct input_ack {
+        std::uint32_t input_sequence = 0;
+        vec3<length> position;
+        vec3<velocity> velocity;
+    };
+
+    constexpr auto message_id(
+        std::type_identity<input_ack>
+    ) -> std::uint16_t;
+
+    auto encode(
+        bitstream& s,
+        const input_ack& ack
+    ) -> void;
+
+    auto decode(
+        bitstream& s,
+        std::type_identity<input_ack>
+    ) -> input_ack;
 }
 
 constexpr auto gse::network::message_id(std::type_identity<input_frame_header>) -> std::uint16_t {
@@ -39,4 +61,22 @@ auto gse::network::encode(bitstream& s, const input_frame_header& header) -> voi
 
 auto gse::network::decode(bitstream& s, std::type_identity<input_frame_header>) -> input_frame_header {
 	return s.read<input_frame_header>();
-}
\ No newline at end of file
+}
+
+constexpr auto gse::network::message_id(std::type_identity<input_ack>) -> std::uint16_t {
+    return 0x0008;
+}
+
+auto gse::network::encode(bitstream& s, const input_ack& ack) -> void {
+	s.write(ack.input_sequence);
+	s.write(ack.position);
+	s.write(ack.velocity);
+}
+
+auto gse::network::decode(bitstream& s, std::type_identity<input_ack>) -> input_ack {
+	return {
+		.input_sequence = s.read<std::uint32_t>(),
+		.position = s.read<vec3<length>>(),
+		.velocity = s.read<vec3<velocity>>()
+	};
+}
@@ -0,0 +1,78 @@
+export module gse.network:message_batch;
+
+import std;
+
+import :message;
+import :bitstream;
+import :packet_header;
+
+export namespace gse::network {
+	struct message_batch {
+	};
+
+	constexpr auto message_id(
+		std::type_identity<message_batch>
+	) -> std::uint16_t;
+
+	constexpr std::size_t batch_length_size = sizeof(std::uint16_t);
+
+	constexpr std::size_t max_batched_message_size = max_packet_size - sizeof(packet_header) - sizeof(std::uint16_t) - batch_length_size;
+
+	template <is_message T>
+	auto encode_batched(
+		const T& msg,
+		std::vector<std::byte>& out
+	) -> bool;
+
+	template <typename F>
+	auto for_each_batched(
+		bitstream& s,
+		F&& f
+	) -> std::size_t;
+}
+
+constexpr auto gse::network::message_id(std::type_identity<message_batch>) -> std::uint16_t {
+	return 0x0007;
+}
+
+template <gse::network::is_message T>
+auto gse::network::encode_batched(const T& msg, std::vector<std::byte>& out) -> bool {
+	std::array<std::byte, max_batched_message_size> buffer;
+	bitstream stream(buffer);
+	write(stream, msg);
+
+	if (stream.error()) {
+		return false;
+	}
+
+	const auto length = static_cast<std::uint16_t>(stream.bytes_written());
+	const auto offset = out.size();
+	out.resize(offset + batch_length_size + length);
+	std::memcpy(out.data() + offset, &length, batch_length_size);
+	std::memcpy(out.data() + offset + batch_length_size, buffer.data(), length);
+	return true;
+}
+
+template <typename F>
+auto gse::network::for_each_batched(bitstream& s, F&& f) -> std::size_t {
+	std::size_t count = 0;
+
+	while (s.remaining_bytes() >= batch_length_size) {
+		const auto length = s.read<std::uint16_t>();
+		if (length == 0 || length > s.remaining_bytes()) {
+			break;
+		}
+
+		const auto bytes = s.read_span(length);
+		if (bytes.empty()) {
+			break;
+		}
+
+		auto entry = bitstream::reader(bytes);
+		const auto id = message_id(entry);
+		std::invoke(f, entry, id);
+		++count;
+	}
+
+	return count;
+}
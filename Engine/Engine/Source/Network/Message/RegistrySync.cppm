@@ -4,6 +4,9 @@ import std;
 
 import :message;
 import :bitstream;
+import :baseline;
+import :quantize;
+import :priority;
 
 import gse.physics;
 import gse.graphics;
@@ -35,15 +38,57 @@ export namespace gse::network {
 	consteval auto component_code_remove(
 	) -> std::uint16_t;
 
+	template <typename T>
+	consteval auto component_code_delta(
+	) -> std::uint16_t;
+
+	template <>
+	struct net_schema<physics::motion_component_net> {
+		using net = physics::motion_component_net;
+		using fields = std::tuple<
+			quantize::field<&net::current_position, quantize::bounded_vec<-4096.f, 4096.f, 1.f / 512.f>>,
+			quantize::field<&net::current_velocity, quantize::bounded_vec<-256.f, 256.f, 1.f / 256.f>>,
+			quantize::field<&net::mass, quantize::logarithmic<1e-3f, 1e6f, 16>>,
+			quantize::field<&net::orientation, quantize::smallest_three<11>>,
+			quantize::field<&net::angular_velocity, quantize::bounded_vec<-64.f, 64.f, 1.f / 256.f>>,
+			quantize::field<&net::moment_of_inertia, quantize::logarithmic<1e-6f, 1e8f, 16>>,
+			quantize::field<&net::affected_by_gravity, quantize::boolean>,
+			quantize::field<&net::airborne, quantize::boolean>,
+			quantize::field<&net::position_locked, quantize::boolean>
+		>;
+	};
+
+	template <>
+	struct net_schema<render_component_net> {
+		using net = render_component_net;
+		using fields = std::tuple<
+			quantize::field<&net::models, quantize::handle_list>,
+			quantize::field<&net::model_count, quantize::bounded<0.f, static_cast<float>(net::max_models), 1.f>>,
+			quantize::field<&net::skinned_models, quantize::handle_list>,
+			quantize::field<&net::skinned_model_count, quantize::bounded<0.f, static_cast<float>(net::max_models), 1.f>>,
+			quantize::field<&net::render, quantize::boolean>,
+			quantize::field<&net::render_bounding_boxes, quantize::boolean>
+		>;
+	};
+
+	template <>
+	struct net_schema<player_controller_net> {
+		using fields = std::tuple<
+			quantize::field<&player_controller_net::controlled_entity_id, quantize::full_id>
+		>;
+	};
+
 	template <typename T>
 	struct message_tag {
 		static constexpr std::uint16_t upsert_id = component_code_upsert<T>();
 		static constexpr std::uint16_t remove_id = component_code_remove<T>();
+		static constexpr std::uint16_t delta_id = component_code_delta<T>();
 	};
 
 	template <typename T>
 	struct component_upsert {
 		id owner_id;
+		std::uint32_t owner_index = 0;
 		T::network_data_t data;
 	};
 
@@ -67,6 +112,7 @@ export namespace gse::network {
 	template <typename T>
 	struct component_remove {
 		id owner_id;
+		std::uint32_t owner_index = 0;
 	};
 
 	template <typename T>
@@ -86,11 +132,61 @@ export namespace gse::network {
 		std::type_identity<component_remove<T>>
 	) -> component_remove<T>;
 
+	template <typename T>
+	struct component_delta {
+		using data_t = T::network_data_t;
+		static constexpr std::size_t field_count = net_field_count<data_t>;
+
+		id owner_id;
+		std::uint32_t owner_index = 0;
+		std::uint32_t baseline_sequence = no_baseline;
+		std::bitset<field_count> changed;
+		data_t data{};
+	};
+
+	template <typename T>
+	constexpr auto message_id(
+		std::type_identity<component_delta<T>>
+	) -> std::uint16_t;
+
+	template <typename T>
+	auto encode(
+		bitstream& s,
+		const component_delta<T>& m
+	) -> void;
+
+	template <typename T>
+	auto decode(
+		bitstream& s,
+		std::type_identity<component_delta<T>>
+	) -> component_delta<T>;
+
+	template <typename T>
+	auto make_component_delta(
+		id owner_id,
+		std::uint32_t owner_index,
+		std::uint32_t baseline_sequence,
+		const typename T::network_data_t& baseline,
+		const typename T::network_data_t& current
+	) -> component_delta<T>;
+
+	template <typename T>
+	auto apply_component_delta(
+		const component_delta<T>& m,
+		const typename T::network_data_t& baseline
+	) -> T::network_data_t;
+
+	template <typename T>
+	auto baseline_key_of(
+		id owner_id
+	) -> baseline_key;
+
 	auto match_and_apply_components(
 		bitstream& s,
 		std::uint16_t id,
 		auto&& on_upsert, 
-		auto&& on_remove  
+		auto&& on_remove,
+		auto&& on_delta
 	) -> bool;
 
 	constexpr auto networked_types = std::tuple<
@@ -99,6 +195,13 @@ export namespace gse::network {
 		std::type_identity<player_controller>
 	>{};
 
+	template <typename T>
+	consteval auto networked_index(
+	) -> std::size_t;
+
+	template <>
+	constexpr float priority_weight<player_controller> = 8.f;
+
 	template <typename F>
 	auto for_each_networked_component(
 		F&& f
@@ -149,6 +252,11 @@ consteval auto gse::network::component_code_remove() -> std::uint16_t {
 	return static_cast<std::uint16_t>(stable_code(component_name<T>()) ^ 0x5A5Au);
 }
 
+template <typename T>
+consteval auto gse::network::component_code_delta() -> std::uint16_t {
+	return static_cast<std::uint16_t>(stable_code(component_name<T>()) ^ 0xA5A5u);
+}
+
 template <typename T>
 constexpr auto gse::network::message_id(std::type_identity<component_upsert<T>>) -> std::uint16_t {
 	static_assert(std::is_trivially_copyable_v<typename T::network_data_t>);
@@ -157,16 +265,18 @@ constexpr auto gse::network::message_id(std::type_identity<component_upsert<T>>)
 
 template <typename T>
 auto gse::network::encode(bitstream& s, const component_upsert<T>& m) -> void {
-	s.write(m.owner_id);
-	s.write(std::as_bytes(std::span{ &m.data, 1 }));
+	quantize::varint::write(s, m.owner_index);
+	quantize::full_id::write(s, m.owner_id);
+	write_net_data(s, m.data);
 }
 
 template <typename T>
 auto gse::network::decode(bitstream& s, std::type_identity<component_upsert<T>>) -> component_upsert<T> {
-	return {
-		.owner_id = s.read<id>(),
-		.data = s.read<typename T::network_data_t>()
-	};
+	component_upsert<T> m;
+	quantize::varint::read(s, m.owner_index);
+	quantize::full_id::read(s, m.owner_id);
+	m.data = read_net_data<typename T::network_data_t>(s);
+	return m;
 }
 
 template <typename T>
@@ -176,16 +286,128 @@ constexpr auto gse::network::message_id(std::type_identity<component_remove<T>>)
 
 template <typename T>
 auto gse::network::encode(bitstream& s, const component_remove<T>& m) -> void {
-	s.write(m.owner_id);
+	quantize::varint::write(s, m.owner_index);
 }
 
 template <typename T>
 auto gse::network::decode(bitstream& s, std::type_identity<component_remove<T>>) -> component_remove<T> {
+	component_remove<T> m;
+	quantize::varint::read(s, m.owner_index);
+	return m;
+}
+
+template <typename T>
+constexpr auto gse::network::message_id(std::type_identity<component_delta<T>>) -> std::uint16_t {
+	return message_tag<T>::delta_id;
+}
+
+template <typename T>
+auto gse::network::encode(bitstream& s, const component_delta<T>& m) -> void {
+	using data_t = component_delta<T>::data_t;
+	constexpr std::size_t n = component_delta<T>::field_count;
+
+	quantize::varint::write(s, m.owner_index);
+	s.write(m.baseline_sequence);
+	if (m.baseline_sequence == no_baseline) {
+		quantize::full_id::write(s, m.owner_id);
+	}
+
+	for (std::size_t base = 0; base < n; base += 64) {
+		const std::size_t count = std::min<std::size_t>(64, n - base);
+		std::uint64_t bits = 0;
+		for (std::size_t i = 0; i < count; ++i) {
+			bits |= static_cast<std::uint64_t>(m.changed[base + i]) << i;
+		}
+		s.write_bits(bits, count);
+	}
+
+	for_each_net_field<data_t>([&]<typename Field>(const std::size_t i, Field) {
+		if (m.changed[i]) {
+			Field::write(s, m.data);
+		}
+	});
+}
+
+template <typename T>
+auto gse::network::decode(bitstream& s, std::type_identity<component_delta<T>>) -> component_delta<T> {
+	using data_t = component_delta<T>::data_t;
+	constexpr std::size_t n = component_delta<T>::field_count;
+
+	component_delta<T> m;
+	quantize::varint::read(s, m.owner_index);
+	m.baseline_sequence = s.read<std::uint32_t>();
+	if (m.baseline_sequence == no_baseline) {
+		quantize::full_id::read(s, m.owner_id);
+	}
+
+	for (std::size_t base = 0; base < n; base += 64) {
+		const std::size_t count = std::min<std::size_t>(64, n - base);
+		const std::uint64_t bits = s.read_bits(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			m.changed[base + i] = ((bits >> i) & 1u) != 0;
+		}
+	}
+
+	for_each_net_field<data_t>([&]<typename Field>(const std::size_t i, Field) {
+		if (m.changed[i]) {
+			Field::read(s, m.data);
+		}
+	});
+
+	return m;
+}
+
+template <typename T>
+auto gse::network::make_component_delta(const id owner_id, const std::uint32_t owner_index, const std::uint32_t baseline_sequence, const typename T::network_data_t& baseline, const typename T::network_data_t& current) -> component_delta<T> {
+	using data_t = T::network_data_t;
+
+	component_delta<T> m{
+		.owner_id = owner_id,
+		.owner_index = owner_index,
+		.baseline_sequence = baseline_sequence,
+		.data = current
+	};
+
+	for_each_net_field<data_t>([&]<typename Field>(const std::size_t i, Field) {
+		m.changed[i] = !Field::equal(baseline, current);
+	});
+
+	return m;
+}
+
+template <typename T>
+auto gse::network::apply_component_delta(const component_delta<T>& m, const typename T::network_data_t& baseline) -> T::network_data_t {
+	using data_t = T::network_data_t;
+
+	data_t out = baseline;
+	for_each_net_field<data_t>([&]<typename Field>(const std::size_t i, Field) {
+		if (m.changed[i]) {
+			Field::copy(out, m.data);
+		}
+	});
+
+	return out;
+}
+
+template <typename T>
+auto gse::network::baseline_key_of(const id owner_id) -> baseline_key {
 	return {
-		.owner_id = s.read<id>()
+		.type = message_tag<T>::upsert_id,
+		.owner = owner_id.number()
 	};
 }
 
+template <typename T>
+consteval auto gse::network::networked_index() -> std::size_t {
+	using types = std::remove_const_t<decltype(networked_types)>;
+
+	return []<std::size_t... I>(std::index_sequence<I...>) {
+		std::size_t index = sizeof...(I);
+		((std::is_same_v<typename std::tuple_element_t<I, types>::type, T> ? (index = I, true) : false) || ...);
+		return index;
+	}(std::make_index_sequence<std::tuple_size_v<types>>{});
+}
+
 template <typename F>
 auto gse::network::for_each_networked_component(F&& f) -> void {
 	std::apply(
@@ -196,7 +418,7 @@ auto gse::network::for_each_networked_component(F&& f) -> void {
 	);
 }
 
-auto gse::network::match_and_apply_components(bitstream& s, std::uint16_t id, auto&& on_upsert, auto&& on_remove) -> bool {
+auto gse::network::match_and_apply_components(bitstream& s, std::uint16_t id, auto&& on_upsert, auto&& on_remove, auto&& on_delta) -> bool {
 	bool handled = false;
 
 	auto handle = [&]<class Ti>(Ti) {
@@ -206,6 +428,7 @@ auto gse::network::match_and_apply_components(bitstream& s, std::uint16_t id, au
 		
 		if (!handled) handled |= try_decode<component_upsert<c>>(s, id, on_upsert);
 		if (!handled) handled |= try_decode<component_remove<c>>(s, id, on_remove);
+		if (!handled) handled |= try_decode<component_delta<c>>(s, id, on_delta);
 	};
 
 	std::apply(
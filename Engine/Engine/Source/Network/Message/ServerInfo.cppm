@@ -24,8 +24,8 @@ export namespace gse::network {
 	) -> server_info_request;
 
 	struct server_info_response {
-		std::uint8_t players{};
-		std::uint8_t max_players{};
+		std::uint16_t players{};
+		std::uint16_t max_players{};
 	};
 
 	constexpr auto message_id(
@@ -41,6 +41,47 @@ export namespace gse::network {
 		bitstream& stream,
 		std::type_identity<server_info_response>
 	) -> server_info_response;
+
+	struct server_stats_request {
+	};
+
+	constexpr auto message_id(
+		std::type_identity<server_stats_request>
+	) -> std::uint16_t;
+
+	auto encode(
+		bitstream& stream,
+		const server_stats_request&
+	) -> void;
+
+	auto decode(
+		bitstream& stream,
+		std::type_identity<server_stats_request>
+	) -> server_stats_request;
+
+	struct server_stats_response {
+		std::uint64_t ticks{};
+		std::uint64_t tick_time_us{};
+		std::uint64_t update_time_us{};
+		std::uint64_t dropped_incoming{};
+		std::uint64_t dropped_outgoing{};
+		std::uint64_t packets_sent{};
+		std::uint64_t bytes_sent{};
+	};
+
+	constexpr auto message_id(
+		std::type_identity<server_stats_response>
+	) -> std::uint16_t;
+
+	auto encode(
+		bitstream& stream,
+		const server_stats_response& msg
+	) -> void;
+
+	auto decode(
+		bitstream& stream,
+		std::type_identity<server_stats_response>
+	) -> server_stats_response;
 }
 
 constexpr auto gse::network::message_id(std::type_identity<server_info_request>) -> std::uint16_t {
@@ -65,7 +106,44 @@ auto gse::network::encode(bitstream& stream, const server_info_response& msg) ->
 
 auto gse::network::decode(bitstream& stream, std::type_identity<server_info_response>) -> server_info_response {
 	return {
-		.players = stream.read<std::uint8_t>(),
-		.max_players = stream.read<std::uint8_t>()
+		.players = stream.read<std::uint16_t>(),
+		.max_players = stream.read<std::uint16_t>()
+	};
+}
+
+constexpr auto gse::network::message_id(std::type_identity<server_stats_request>) -> std::uint16_t {
+	return 0x0009;
+}
+
+auto gse::network::encode(bitstream&, const server_stats_request&) -> void {
+}
+
+auto gse::network::decode(bitstream&, std::type_identity<server_stats_request>) -> server_stats_request {
+	return {};
+}
+
+constexpr auto gse::network::message_id(std::type_identity<server_stats_response>) -> std::uint16_t {
+	return 0x000A;
+}
+
+auto gse::network::encode(bitstream& stream, const server_stats_response& msg) -> void {
+	stream.write(msg.ticks);
+	stream.write(msg.tick_time_us);
+	stream.write(msg.update_time_us);
+	stream.write(msg.dropped_incoming);
+	stream.write(msg.dropped_outgoing);
+	stream.write(msg.packets_sent);
+	stream.write(msg.bytes_sent);
+}
+
+auto gse::network::decode(bitstream& stream, std::type_identity<server_stats_response>) -> server_stats_response {
+	return {
+		.ticks = stream.read<std::uint64_t>(),
+		.tick_time_us = stream.read<std::uint64_t>(),
+		.update_time_us = stream.read<std::uint64_t>(),
+		.dropped_incoming = stream.read<std::uint64_t>(),
+		.dropped_outgoing = stream.read<std::uint64_t>(),
+		.packets_sent = stream.read<std::uint64_t>(),
+		.bytes_sent = stream.read<std::uint64_t>()
 	};
 }
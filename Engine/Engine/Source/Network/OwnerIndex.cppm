@@ -0,0 +1,75 @@
+export module gse.network:owner_index;
+
+import std;
+
+import gse.utility;
+
+export namespace gse::network {
+	class owner_index_table {
+	public:
+		auto index_of(
+			const id& owner
+		) -> std::uint32_t;
+
+		auto find(
+			const id& owner
+		) const -> std::optional<std::uint32_t>;
+
+		auto size(
+		) const -> std::size_t;
+	private:
+		std::unordered_map<id, std::uint32_t> m_indices;
+		std::uint32_t m_next = 0;
+	};
+
+	class owner_index_map {
+	public:
+		auto define(
+			std::uint32_t index,
+			const id& owner
+		) -> void;
+
+		auto resolve(
+			std::uint32_t index
+		) const -> id;
+
+		auto clear(
+		) -> void;
+	private:
+		std::unordered_map<std::uint32_t, id> m_owners;
+	};
+}
+
+auto gse::network::owner_index_table::index_of(const id& owner) -> std::uint32_t {
+	const auto [it, inserted] = m_indices.try_emplace(owner, m_next);
+	if (inserted) {
+		++m_next;
+	}
+	return it->second;
+}
+
+auto gse::network::owner_index_table::find(const id& owner) const -> std::optional<std::uint32_t> {
+	if (const auto it = m_indices.find(owner); it != m_indices.end()) {
+		return it->second;
+	}
+	return std::nullopt;
+}
+
+auto gse::network::owner_index_table::size() const -> std::size_t {
+	return m_indices.size();
+}
+
+auto gse::network::owner_index_map::define(const std::uint32_t index, const id& owner) -> void {
+	m_owners[index] = owner;
+}
+
+auto gse::network::owner_index_map::resolve(const std::uint32_t index) const -> id {
+	if (const auto it = m_owners.find(index); it != m_owners.end()) {
+		return it->second;
+	}
+	return {};
+}
+
+auto gse::network::owner_index_map::clear() -> void {
+	m_owners.clear();
+}
@@ -0,0 +1,231 @@
+export module gse.network:packet_buffer;
+
+import std;
+
+import :packet_header;
+
+namespace gse::network {
+	class packet_pool;
+
+	struct packet_slot {
+		std::atomic<std::uint32_t> refs = 0;
+		std::uint32_t size = 0;
+		packet_pool* pool = nullptr;
+		packet_slot* next = nullptr;
+		alignas(16) std::array<std::byte, max_packet_size> data;
+	};
+}
+
+export namespace gse::network {
+	class packet_buffer {
+	public:
+		packet_buffer() = default;
+
+		packet_buffer(
+			const packet_buffer& other
+		);
+
+		packet_buffer(
+			packet_buffer&& other
+		) noexcept;
+
+		auto operator=(
+			const packet_buffer& other
+		) -> packet_buffer&;
+
+		auto operator=(
+			packet_buffer&& other
+		) noexcept -> packet_buffer&;
+
+		~packet_buffer();
+
+		static auto acquire(
+		) -> packet_buffer;
+
+		auto data(
+		) const -> std::span<std::byte>;
+
+		auto bytes(
+		) const -> std::span<const std::byte>;
+
+		auto size(
+		) const -> std::size_t;
+
+		auto resize(
+			std::size_t size
+		) -> void;
+
+		auto use_count(
+		) const -> std::uint32_t;
+
+		explicit operator bool(
+		) const;
+	private:
+		explicit packet_buffer(
+			packet_slot* slot
+		);
+
+		auto release(
+		) -> void;
+
+		packet_slot* m_slot = nullptr;
+
+		friend class packet_pool;
+	};
+
+	struct packet_slice {
+		packet_buffer owner;
+		std::span<const std::byte> bytes;
+	};
+
+	class packet_pool {
+	public:
+		static auto shared(
+		) -> packet_pool&;
+
+		auto acquire(
+		) -> packet_buffer;
+
+		auto allocated(
+		) const -> std::size_t;
+
+		auto available(
+		) const -> std::size_t;
+	private:
+		friend class packet_buffer;
+
+		static constexpr std::size_t slab_size = 256;
+
+		auto release(
+			packet_slot* slot
+		) -> void;
+
+		mutable std::mutex m_mutex;
+		std::vector<std::unique_ptr<packet_slot[]>> m_slabs;
+		packet_slot* m_free = nullptr;
+		std::size_t m_available = 0;
+	};
+}
+
+gse::network::packet_buffer::packet_buffer(packet_slot* slot) : m_slot(slot) {}
+
+gse::network::packet_buffer::packet_buffer(const packet_buffer& other) : m_slot(other.m_slot) {
+	if (m_slot) {
+		m_slot->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+gse::network::packet_buffer::packet_buffer(packet_buffer&& other) noexcept : m_slot(std::exchange(other.m_slot, nullptr)) {}
+
+auto gse::network::packet_buffer::operator=(const packet_buffer& other) -> packet_buffer& {
+	if (this != &other) {
+		release();
+		m_slot = other.m_slot;
+		if (m_slot) {
+			m_slot->refs.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	return *this;
+}
+
+auto gse::network::packet_buffer::operator=(packet_buffer&& other) noexcept -> packet_buffer& {
+	if (this != &other) {
+		release();
+		m_slot = std::exchange(other.m_slot, nullptr);
+	}
+	return *this;
+}
+
+gse::network::packet_buffer::~packet_buffer() {
+	release();
+}
+
+auto gse::network::packet_buffer::acquire() -> packet_buffer {
+	return packet_pool::shared().acquire();
+}
+
+auto gse::network::packet_buffer::data() const -> std::span<std::byte> {
+	if (!m_slot) {
+		return {};
+	}
+	return m_slot->data;
+}
+
+auto gse::network::packet_buffer::bytes() const -> std::span<const std::byte> {
+	if (!m_slot) {
+		return {};
+	}
+	return std::span<const std::byte>(m_slot->data).first(m_slot->size);
+}
+
+auto gse::network::packet_buffer::size() const -> std::size_t {
+	return m_slot ? m_slot->size : 0;
+}
+
+auto gse::network::packet_buffer::resize(const std::size_t size) -> void {
+	if (m_slot) {
+		m_slot->size = static_cast<std::uint32_t>(std::min<std::size_t>(size, max_packet_size));
+	}
+}
+
+auto gse::network::packet_buffer::use_count() const -> std::uint32_t {
+	return m_slot ? m_slot->refs.load(std::memory_order_relaxed) : 0;
+}
+
+gse::network::packet_buffer::operator bool() const {
+	return m_slot != nullptr;
+}
+
+auto gse::network::packet_buffer::release() -> void {
+	if (m_slot && m_slot->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		m_slot->pool->release(m_slot);
+	}
+	m_slot = nullptr;
+}
+
+auto gse::network::packet_pool::shared() -> packet_pool& {
+	static packet_pool pool;
+	return pool;
+}
+
+auto gse::network::packet_pool::acquire() -> packet_buffer {
+	std::lock_guard lock(m_mutex);
+
+	if (!m_free) {
+		auto slab = std::make_unique<packet_slot[]>(slab_size);
+		for (std::size_t i = 0; i < slab_size; ++i) {
+			slab[i].pool = this;
+			slab[i].next = m_free;
+			m_free = &slab[i];
+		}
+		m_slabs.push_back(std::move(slab));
+		m_available += slab_size;
+	}
+
+	packet_slot* slot = m_free;
+	m_free = slot->next;
+	--m_available;
+
+	slot->next = nullptr;
+	slot->size = 0;
+	slot->refs.store(1, std::memory_order_relaxed);
+
+	return packet_buffer(slot);
+}
+
+auto gse::network::packet_pool::allocated() const -> std::size_t {
+	std::lock_guard lock(m_mutex);
+	return m_slabs.size() * slab_size;
+}
+
+auto gse::network::packet_pool::available() const -> std::size_t {
+	std::lock_guard lock(m_mutex);
+	return m_available;
+}
+
+auto gse::network::packet_pool::release(packet_slot* slot) -> void {
+	std::lock_guard lock(m_mutex);
+	slot->next = m_free;
+	m_free = slot;
+	++m_available;
+}
@@ -7,6 +7,7 @@ export namespace gse {
 		std::uint32_t sequence = 0;
 		std::uint32_t ack = 0;
 		std::uint32_t ack_bits = 0;
+		std::uint32_t server_time = 0;
 	};
 
 	constexpr std::uint32_t max_packet_size = 1200;
@@ -0,0 +1,154 @@
+export module gse.network:prediction;
+
+import std;
+
+import gse.math;
+
+import :input_frame;
+
+export namespace gse::network {
+	struct prediction_config {
+		length tolerance = meters(0.01f);
+		length snap_distance = meters(2.f);
+		float correction_rate = 0.25f;
+	};
+
+	struct predicted_state {
+		std::uint32_t sequence = 0;
+		vec3<length> position;
+		vec3<velocity> velocity;
+	};
+
+	struct prediction_correction {
+		vec3<length> position;
+		vec3<velocity> velocity;
+	};
+
+	class prediction_buffer {
+	public:
+		explicit prediction_buffer(
+			const prediction_config& config = {}
+		);
+
+		auto record(
+			std::uint32_t sequence,
+			const vec3<length>& position,
+			const vec3<velocity>& velocity
+		) -> void;
+
+		auto reconcile(
+			const input_ack& ack
+		) -> bool;
+
+		auto take_correction(
+		) -> prediction_correction;
+
+		auto reset(
+		) -> void;
+
+		auto last_acked(
+		) const -> std::uint32_t;
+
+		auto pending_error(
+		) const -> length;
+	private:
+		static constexpr std::size_t capacity = 128;
+
+		auto find(
+			std::uint32_t sequence
+		) -> predicted_state*;
+
+		prediction_config m_config;
+		std::array<predicted_state, capacity> m_states{};
+		std::uint32_t m_latest = 0;
+		std::uint32_t m_last_acked = 0;
+		prediction_correction m_pending;
+		bool m_snap = false;
+	};
+}
+
+gse::network::prediction_buffer::prediction_buffer(const prediction_config& config) : m_config(config) {}
+
+auto gse::network::prediction_buffer::record(const std::uint32_t sequence, const vec3<length>& position, const vec3<velocity>& velocity) -> void {
+	if (sequence == 0 || sequence <= m_last_acked) {
+		return;
+	}
+
+	m_states[sequence % capacity] = {
+		.sequence = sequence,
+		.position = position + m_pending.position,
+		.velocity = velocity + m_pending.velocity
+	};
+	m_latest = std::max(m_latest, sequence);
+}
+
+auto gse::network::prediction_buffer::reconcile(const input_ack& ack) -> bool {
+	if (ack.input_sequence <= m_last_acked) {
+		return false;
+	}
+
+	m_last_acked = ack.input_sequence;
+
+	const auto* predicted = find(ack.input_sequence);
+	if (!predicted) {
+		return false;
+	}
+
+	const auto position_error = ack.position - predicted->position;
+	const auto velocity_error = ack.velocity - predicted->velocity;
+
+	if (magnitude(position_error) < m_config.tolerance) {
+		return false;
+	}
+
+	for (std::uint32_t s = ack.input_sequence + 1; s <= m_latest && s - ack.input_sequence < capacity; ++s) {
+		if (auto* later = find(s)) {
+			later->position += position_error;
+			later->velocity += velocity_error;
+		}
+	}
+
+	m_pending.position += position_error;
+	m_pending.velocity += velocity_error;
+	m_snap = m_snap || magnitude(m_pending.position) > m_config.snap_distance;
+
+	return true;
+}
+
+auto gse::network::prediction_buffer::take_correction() -> prediction_correction {
+	if (m_snap || magnitude(m_pending.position) < m_config.tolerance) {
+		m_snap = false;
+		return std::exchange(m_pending, {});
+	}
+
+	const prediction_correction step{
+		.position = m_pending.position * m_config.correction_rate,
+		.velocity = m_pending.velocity * m_config.correction_rate
+	};
+
+	m_pending.position -= step.position;
+	m_pending.velocity -= step.velocity;
+
+	return step;
+}
+
+auto gse::network::prediction_buffer::reset() -> void {
+	m_states = {};
+	m_latest = 0;
+	m_last_acked = 0;
+	m_pending = {};
+	m_snap = false;
+}
+
+auto gse::network::prediction_buffer::last_acked() const -> std::uint32_t {
+	return m_last_acked;
+}
+
+auto gse::network::prediction_buffer::pending_error() const -> length {
+	return magnitude(m_pending.position);
+}
+
+auto gse::network::prediction_buffer::find(const std::uint32_t sequence) -> predicted_state* {
+	auto& state = m_states[sequence % capacity];
+	return state.sequence == sequence ? &state : nullptr;
+}
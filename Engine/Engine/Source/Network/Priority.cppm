@@ -0,0 +1,128 @@
+export module gse.network:priority;
+
+import std;
+
+import gse.utility;
+import gse.math;
+
+export namespace gse::network {
+	template <typename T>
+	constexpr float priority_weight = 1.f;
+
+	struct priority_config {
+		std::size_t bytes_per_tick = 6 * 1024;
+		length distance_falloff = meters(24.f);
+		float entered_boost = 4.f;
+	};
+
+	class priority_scheduler {
+	public:
+		explicit priority_scheduler(
+			const priority_config& config = {}
+		);
+
+		auto mark(
+			id entity,
+			std::uint32_t types,
+			float weight,
+			bool entered = false
+		) -> void;
+
+		auto drop(
+			id entity
+		) -> void;
+
+		auto clear(
+		) -> void;
+
+		template <typename F>
+		auto accumulate(
+			F&& distance_of
+		) -> void;
+
+		auto order(
+		) const -> std::vector<id>;
+
+		auto take(
+			id entity
+		) -> std::uint32_t;
+
+		auto pending(
+		) const -> std::size_t;
+
+		auto budget(
+		) const -> std::size_t;
+	private:
+		struct pending_entity {
+			std::uint32_t types = 0;
+			float weight = 0.f;
+			float priority = 0.f;
+		};
+
+		priority_config m_config;
+		std::unordered_map<id, pending_entity> m_pending;
+	};
+}
+
+gse::network::priority_scheduler::priority_scheduler(const priority_config& config) : m_config(config) {}
+
+auto gse::network::priority_scheduler::mark(const id entity, const std::uint32_t types, const float weight, const bool entered) -> void {
+	auto& p = m_pending[entity];
+	p.types |= types;
+	p.weight = std::max(p.weight, entered ? weight * m_config.entered_boost : weight);
+}
+
+auto gse::network::priority_scheduler::drop(const id entity) -> void {
+	m_pending.erase(entity);
+}
+
+auto gse::network::priority_scheduler::clear() -> void {
+	m_pending.clear();
+}
+
+template <typename F>
+auto gse::network::priority_scheduler::accumulate(F&& distance_of) -> void {
+	const float falloff = m_config.distance_falloff.as<meters>();
+
+	for (auto& [entity, p] : m_pending) {
+		const float d = std::invoke(distance_of, entity).template as<meters>();
+		p.priority += p.weight / (1.f + d / falloff);
+	}
+}
+
+auto gse::network::priority_scheduler::order() const -> std::vector<id> {
+	std::vector<std::pair<float, id>> ranked;
+	ranked.reserve(m_pending.size());
+
+	for (const auto& [entity, p] : m_pending) {
+		ranked.emplace_back(p.priority, entity);
+	}
+
+	std::ranges::sort(ranked, std::greater{}, &std::pair<float, id>::first);
+
+	std::vector<id> out;
+	out.reserve(ranked.size());
+	for (const auto& entity : ranked | std::views::values) {
+		out.push_back(entity);
+	}
+	return out;
+}
+
+auto gse::network::priority_scheduler::take(const id entity) -> std::uint32_t {
+	const auto it = m_pending.find(entity);
+	if (it == m_pending.end()) {
+		return 0;
+	}
+
+	const auto types = it->second.types;
+	m_pending.erase(it);
+	return types;
+}
+
+auto gse::network::priority_scheduler::pending() const -> std::size_t {
+	return m_pending.size();
+}
+
+auto gse::network::priority_scheduler::budget() const -> std::size_t {
+	return m_config.bytes_per_tick;
+}
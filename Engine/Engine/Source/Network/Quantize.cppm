@@ -0,0 +1,640 @@
+export module gse.network:quantize;
+
+import std;
+
+import gse.utility;
+import gse.math;
+
+import :bitstream;
+
+export namespace gse::network::quantize {
+	template <typename V>
+	auto to_raw(
+		const V& v
+	) -> float;
+
+	template <typename V>
+	auto from_raw(
+		float raw
+	) -> V;
+
+	template <float Min, float Max, float Precision>
+	struct bounded {
+		static constexpr std::uint64_t steps = static_cast<std::uint64_t>((static_cast<double>(Max) - Min) / Precision + 0.5);
+		static constexpr std::size_t bits = std::bit_width(steps);
+
+		static auto quantize(
+			float v
+		) -> std::uint64_t;
+
+		static auto dequantize(
+			std::uint64_t q
+		) -> float;
+
+		template <typename V>
+		static auto write(
+			bitstream& s,
+			const V& v
+		) -> void;
+
+		template <typename V>
+		static auto read(
+			bitstream& s,
+			V& v
+		) -> void;
+
+		template <typename V>
+		static auto equal(
+			const V& a,
+			const V& b
+		) -> bool;
+	};
+
+	template <float Min, float Max, float Precision>
+	struct bounded_vec {
+		using scalar = bounded<Min, Max, Precision>;
+
+		template <typename V>
+		static auto write(
+			bitstream& s,
+			const V& v
+		) -> void;
+
+		template <typename V>
+		static auto read(
+			bitstream& s,
+			V& v
+		) -> void;
+
+		template <typename V>
+		static auto equal(
+			const V& a,
+			const V& b
+		) -> bool;
+	};
+
+	template <std::size_t Bits>
+	struct smallest_three {
+		static constexpr float range = 0.70710678f;
+		static constexpr std::uint64_t max_value = (std::uint64_t{ 1 } << Bits) - 1;
+
+		struct encoded {
+			std::uint8_t largest = 0;
+			std::array<std::uint64_t, 3> components{};
+
+			auto operator==(
+				const encoded&
+			) const -> bool = default;
+		};
+
+		static auto encode(
+			const quat& q
+		) -> encoded;
+
+		static auto write(
+			bitstream& s,
+			const quat& q
+		) -> void;
+
+		static auto read(
+			bitstream& s,
+			quat& q
+		) -> void;
+
+		static auto equal(
+			const quat& a,
+			const quat& b
+		) -> bool;
+	};
+
+	struct boolean {
+		static auto write(
+			bitstream& s,
+			bool v
+		) -> void;
+
+		static auto read(
+			bitstream& s,
+			bool& v
+		) -> void;
+
+		static auto equal(
+			bool a,
+			bool b
+		) -> bool;
+	};
+
+	struct varint {
+		template <std::unsigned_integral V>
+		static auto write(
+			bitstream& s,
+			V v
+		) -> void;
+
+		template <std::unsigned_integral V>
+		static auto read(
+			bitstream& s,
+			V& v
+		) -> void;
+
+		template <std::unsigned_integral V>
+		static auto equal(
+			V a,
+			V b
+		) -> bool;
+	};
+
+	template <float Min, float Max, std::size_t Bits>
+	struct logarithmic {
+		static constexpr std::uint64_t max_value = (std::uint64_t{ 1 } << Bits) - 1;
+
+		static auto quantize(
+			float v
+		) -> std::uint64_t;
+
+		static auto dequantize(
+			std::uint64_t q
+		) -> float;
+
+		template <typename V>
+		static auto write(
+			bitstream& s,
+			const V& v
+		) -> void;
+
+		template <typename V>
+		static auto read(
+			bitstream& s,
+			V& v
+		) -> void;
+
+		template <typename V>
+		static auto equal(
+			const V& a,
+			const V& b
+		) -> bool;
+	};
+
+	struct full_id {
+		static auto write(
+			bitstream& s,
+			const id& v
+		) -> void;
+
+		static auto read(
+			bitstream& s,
+			id& v
+		) -> void;
+
+		static auto equal(
+			const id& a,
+			const id& b
+		) -> bool;
+	};
+
+	struct handle_list {
+		template <typename V>
+		static auto write(
+			bitstream& s,
+			const V& v
+		) -> void;
+
+		template <typename V>
+		static auto read(
+			bitstream& s,
+			V& v
+		) -> void;
+
+		template <typename V>
+		static auto equal(
+			const V& a,
+			const V& b
+		) -> bool;
+	};
+
+	struct raw {
+		template <is_trivially_copyable V>
+		static auto write(
+			bitstream& s,
+			const V& v
+		) -> void;
+
+		template <is_trivially_copyable V>
+		static auto read(
+			bitstream& s,
+			V& v
+		) -> void;
+
+		template <is_trivially_copyable V>
+		static auto equal(
+			const V& a,
+			const V& b
+		) -> bool;
+	};
+
+	template <auto Member, typename Codec>
+	struct field;
+
+	template <typename Owner, typename V, V Owner::* Member, typename Codec>
+	struct field<Member, Codec> {
+		using owner_type = Owner;
+
+		static auto write(
+			bitstream& s,
+			const Owner& o
+		) -> void {
+			Codec::write(s, o.*Member);
+		}
+
+		static auto read(
+			bitstream& s,
+			Owner& o
+		) -> void {
+			Codec::read(s, o.*Member);
+		}
+
+		static auto equal(
+			const Owner& a,
+			const Owner& b
+		) -> bool {
+			return Codec::equal(a.*Member, b.*Member);
+		}
+
+		static auto copy(
+			Owner& dst,
+			const Owner& src
+		) -> void {
+			dst.*Member = src.*Member;
+		}
+	};
+
+	template <typename T, std::size_t Index>
+	struct word_field {
+		static constexpr std::size_t offset = Index * sizeof(std::uint32_t);
+		static constexpr std::size_t size = std::min(sizeof(std::uint32_t), sizeof(T) - offset);
+
+		static auto write(
+			bitstream& s,
+			const T& o
+		) -> void {
+			s.write_bytes(reinterpret_cast<const std::byte*>(&o) + offset, size);
+		}
+
+		static auto read(
+			bitstream& s,
+			T& o
+		) -> void {
+			s.read_bytes(reinterpret_cast<std::byte*>(&o) + offset, size);
+		}
+
+		static auto equal(
+			const T& a,
+			const T& b
+		) -> bool {
+			return std::memcmp(reinterpret_cast<const std::byte*>(&a) + offset, reinterpret_cast<const std::byte*>(&b) + offset, size) == 0;
+		}
+
+		static auto copy(
+			T& dst,
+			const T& src
+		) -> void {
+			std::memcpy(reinterpret_cast<std::byte*>(&dst) + offset, reinterpret_cast<const std::byte*>(&src) + offset, size);
+		}
+	};
+}
+
+export namespace gse::network {
+	template <typename T>
+	struct net_schema;
+
+	template <typename T>
+	concept has_net_schema = requires { typename net_schema<T>::fields; };
+
+	template <typename T>
+	struct net_fields {
+		using type = decltype([]<std::size_t... I>(std::index_sequence<I...>) {
+			return std::tuple<quantize::word_field<T, I>...>{};
+		}(std::make_index_sequence<(sizeof(T) + 3) / 4>{}));
+	};
+
+	template <has_net_schema T>
+	struct net_fields<T> {
+		using type = net_schema<T>::fields;
+	};
+
+	template <typename T>
+	using net_fields_t = net_fields<T>::type;
+
+	template <typename T>
+	constexpr std::size_t net_field_count = std::tuple_size_v<net_fields_t<T>>;
+
+	template <typename T, typename F>
+	auto for_each_net_field(
+		F&& f
+	) -> void;
+
+	template <typename T>
+	auto write_net_data(
+		bitstream& s,
+		const T& data
+	) -> void;
+
+	template <typename T>
+	auto read_net_data(
+		bitstream& s
+	) -> T;
+}
+
+template <typename V>
+auto gse::network::quantize::to_raw(const V& v) -> float {
+	if constexpr (std::is_arithmetic_v<V>) {
+		return static_cast<float>(v);
+	}
+	else {
+		return static_cast<float>(std::bit_cast<typename V::value_type>(v));
+	}
+}
+
+template <typename V>
+auto gse::network::quantize::from_raw(const float raw) -> V {
+	if constexpr (std::is_arithmetic_v<V>) {
+		return static_cast<V>(raw);
+	}
+	else {
+		return std::bit_cast<V>(static_cast<typename V::value_type>(raw));
+	}
+}
+
+template <float Min, float Max, float Precision>
+auto gse::network::quantize::bounded<Min, Max, Precision>::quantize(const float v) -> std::uint64_t {
+	const double clamped = std::clamp(static_cast<double>(v), static_cast<double>(Min), static_cast<double>(Max));
+	return std::min(steps, static_cast<std::uint64_t>(std::llround((clamped - Min) / Precision)));
+}
+
+template <float Min, float Max, float Precision>
+auto gse::network::quantize::bounded<Min, Max, Precision>::dequantize(const std::uint64_t q) -> float {
+	return static_cast<float>(std::min(static_cast<double>(Min) + static_cast<double>(q) * Precision, static_cast<double>(Max)));
+}
+
+template <float Min, float Max, float Precision>
+template <typename V>
+auto gse::network::quantize::bounded<Min, Max, Precision>::write(bitstream& s, const V& v) -> void {
+	s.write_bits(quantize(to_raw(v)), bits);
+}
+
+template <float Min, float Max, float Precision>
+template <typename V>
+auto gse::network::quantize::bounded<Min, Max, Precision>::read(bitstream& s, V& v) -> void {
+	v = from_raw<V>(dequantize(s.read_bits(bits)));
+}
+
+template <float Min, float Max, float Precision>
+template <typename V>
+auto gse::network::quantize::bounded<Min, Max, Precision>::equal(const V& a, const V& b) -> bool {
+	return quantize(to_raw(a)) == quantize(to_raw(b));
+}
+
+template <float Min, float Max, float Precision>
+template <typename V>
+auto gse::network::quantize::bounded_vec<Min, Max, Precision>::write(bitstream& s, const V& v) -> void {
+	for (const auto c : v.as_storage_span()) {
+		scalar::write(s, c);
+	}
+}
+
+template <float Min, float Max, float Precision>
+template <typename V>
+auto gse::network::quantize::bounded_vec<Min, Max, Precision>::read(bitstream& s, V& v) -> void {
+	for (auto& c : v.as_storage_span()) {
+		scalar::read(s, c);
+	}
+}
+
+template <float Min, float Max, float Precision>
+template <typename V>
+auto gse::network::quantize::bounded_vec<Min, Max, Precision>::equal(const V& a, const V& b) -> bool {
+	return std::ranges::equal(a.as_storage_span(), b.as_storage_span(), [](const auto x, const auto y) {
+		return scalar::equal(x, y);
+	});
+}
+
+template <std::size_t Bits>
+auto gse::network::quantize::smallest_three<Bits>::encode(const quat& q) -> encoded {
+	const auto c = q.as_storage_span();
+
+	std::size_t largest = 0;
+	for (std::size_t i = 1; i < 4; ++i) {
+		if (std::abs(c[i]) > std::abs(c[largest])) {
+			largest = i;
+		}
+	}
+
+	const float sign = c[largest] < 0.f ? -1.f : 1.f;
+
+	encoded out{ .largest = static_cast<std::uint8_t>(largest) };
+	std::size_t j = 0;
+	for (std::size_t i = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+		const float v = std::clamp(c[i] * sign, -range, range);
+		out.components[j++] = static_cast<std::uint64_t>(std::lround((v + range) / (2.f * range) * static_cast<float>(max_value)));
+	}
+
+	return out;
+}
+
+template <std::size_t Bits>
+auto gse::network::quantize::smallest_three<Bits>::write(bitstream& s, const quat& q) -> void {
+	const auto e = encode(q);
+	s.write_bits(e.largest, 2);
+	for (const auto c : e.components) {
+		s.write_bits(c, Bits);
+	}
+}
+
+template <std::size_t Bits>
+auto gse::network::quantize::smallest_three<Bits>::read(bitstream& s, quat& q) -> void {
+	const auto largest = static_cast<std::size_t>(s.read_bits(2));
+
+	std::array<float, 4> c{};
+	float sum = 0.f;
+	for (std::size_t i = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+		const auto bits = s.read_bits(Bits);
+		c[i] = static_cast<float>(bits) / static_cast<float>(max_value) * (2.f * range) - range;
+		sum += c[i] * c[i];
+	}
+	c[largest] = std::sqrt(std::max(0.f, 1.f - sum));
+
+	q = quat(c[0], c[1], c[2], c[3]);
+}
+
+template <std::size_t Bits>
+auto gse::network::quantize::smallest_three<Bits>::equal(const quat& a, const quat& b) -> bool {
+	return encode(a) == encode(b);
+}
+
+auto gse::network::quantize::boolean::write(bitstream& s, const bool v) -> void {
+	s.write_bits(v ? 1u : 0u, 1);
+}
+
+auto gse::network::quantize::boolean::read(bitstream& s, bool& v) -> void {
+	v = s.read_bits(1) != 0;
+}
+
+auto gse::network::quantize::boolean::equal(const bool a, const bool b) -> bool {
+	return a == b;
+}
+
+template <std::unsigned_integral V>
+auto gse::network::quantize::varint::write(bitstream& s, V v) -> void {
+	do {
+		const auto group = static_cast<std::uint64_t>(v & 0x7Fu);
+		v >>= 7;
+		s.write_bits(group | (v != 0 ? 0x80u : 0u), 8);
+	} while (v != 0);
+}
+
+template <std::unsigned_integral V>
+auto gse::network::quantize::varint::read(bitstream& s, V& v) -> void {
+	std::uint64_t out = 0;
+	for (std::size_t shift = 0; shift < 64 && s.good(); shift += 7) {
+		const auto group = s.read_bits(8);
+		out |= (group & 0x7Fu) << shift;
+		if ((group & 0x80u) == 0) {
+			break;
+		}
+	}
+	v = static_cast<V>(out);
+}
+
+template <std::unsigned_integral V>
+auto gse::network::quantize::varint::equal(const V a, const V b) -> bool {
+	return a == b;
+}
+
+template <float Min, float Max, std::size_t Bits>
+auto gse::network::quantize::logarithmic<Min, Max, Bits>::quantize(const float v) -> std::uint64_t {
+	const double clamped = std::clamp(static_cast<double>(v), static_cast<double>(Min), static_cast<double>(Max));
+	const double log_min = std::log(static_cast<double>(Min));
+	const double t = (std::log(clamped) - log_min) / (std::log(static_cast<double>(Max)) - log_min);
+	return std::min(max_value, static_cast<std::uint64_t>(std::llround(t * static_cast<double>(max_value))));
+}
+
+template <float Min, float Max, std::size_t Bits>
+auto gse::network::quantize::logarithmic<Min, Max, Bits>::dequantize(const std::uint64_t q) -> float {
+	const double t = static_cast<double>(std::min(q, max_value)) / static_cast<double>(max_value);
+	const double log_min = std::log(static_cast<double>(Min));
+	return static_cast<float>(std::exp(log_min + t * (std::log(static_cast<double>(Max)) - log_min)));
+}
+
+template <float Min, float Max, std::size_t Bits>
+template <typename V>
+auto gse::network::quantize::logarithmic<Min, Max, Bits>::write(bitstream& s, const V& v) -> void {
+	s.write_bits(quantize(to_raw(v)), Bits);
+}
+
+template <float Min, float Max, std::size_t Bits>
+template <typename V>
+auto gse::network::quantize::logarithmic<Min, Max, Bits>::read(bitstream& s, V& v) -> void {
+	v = from_raw<V>(dequantize(s.read_bits(Bits)));
+}
+
+template <float Min, float Max, std::size_t Bits>
+template <typename V>
+auto gse::network::quantize::logarithmic<Min, Max, Bits>::equal(const V& a, const V& b) -> bool {
+	return quantize(to_raw(a)) == quantize(to_raw(b));
+}
+
+auto gse::network::quantize::full_id::write(bitstream& s, const id& v) -> void {
+	s.write_bits(v.number(), 64);
+}
+
+auto gse::network::quantize::full_id::read(bitstream& s, id& v) -> void {
+	v = generate_temp_id(s.read_bits(64));
+}
+
+auto gse::network::quantize::full_id::equal(const id& a, const id& b) -> bool {
+	return a.number() == b.number();
+}
+
+template <typename V>
+auto gse::network::quantize::handle_list::write(bitstream& s, const V& v) -> void {
+	const auto used = std::ranges::find_if(v, [](const auto& h) { return !h.id().exists(); }) - v.begin();
+	varint::write(s, static_cast<std::uint32_t>(used));
+	for (std::ptrdiff_t i = 0; i < used; ++i) {
+		full_id::write(s, v[i].id());
+	}
+}
+
+template <typename V>
+auto gse::network::quantize::handle_list::read(bitstream& s, V& v) -> void {
+	std::uint32_t used = 0;
+	varint::read(s, used);
+	used = std::min<std::uint32_t>(used, static_cast<std::uint32_t>(v.size()));
+
+	v = {};
+	for (std::uint32_t i = 0; i < used; ++i) {
+		id resource_id;
+		full_id::read(s, resource_id);
+		v[i] = typename V::value_type(resource_id, nullptr);
+	}
+}
+
+template <typename V>
+auto gse::network::quantize::handle_list::equal(const V& a, const V& b) -> bool {
+	return std::ranges::equal(a, b, [](const auto& x, const auto& y) {
+		return x.id() == y.id();
+	});
+}
+
+template <gse::is_trivially_copyable V>
+auto gse::network::quantize::raw::write(bitstream& s, const V& v) -> void {
+	s.write(v);
+}
+
+template <gse::is_trivially_copyable V>
+auto gse::network::quantize::raw::read(bitstream& s, V& v) -> void {
+	v = s.read<V>();
+}
+
+template <gse::is_trivially_copyable V>
+auto gse::network::quantize::raw::equal(const V& a, const V& b) -> bool {
+	return std::memcmp(&a, &b, sizeof(V)) == 0;
+}
+
+template <typename T, typename F>
+auto gse::network::for_each_net_field(F&& f) -> void {
+	[&]<std::size_t... I>(std::index_sequence<I...>) {
+		(f(I, std::tuple_element_t<I, net_fields_t<T>>{}), ...);
+	}(std::make_index_sequence<net_field_count<T>>{});
+}
+
+template <typename T>
+auto gse::network::write_net_data(bitstream& s, const T& data) -> void {
+	if constexpr (has_net_schema<T>) {
+		for_each_net_field<T>([&]<typename Field>(std::size_t, Field) {
+			Field::write(s, data);
+		});
+	}
+	else {
+		s.write(data);
+	}
+}
+
+template <typename T>
+auto gse::network::read_net_data(bitstream& s) -> T {
+	if constexpr (has_net_schema<T>) {
+		T data{};
+		for_each_net_field<T>([&]<typename Field>(std::size_t, Field) {
+			Field::read(s, data);
+		});
+		return data;
+	}
+	else {
+		return s.read<T>();
+	}
+}
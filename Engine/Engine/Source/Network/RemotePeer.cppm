@@ -3,6 +3,9 @@ export module gse.network:remote_peer;
 import std;
 
 import :socket;
+import :baseline;
+import :priority;
+import :owner_index;
 
 import gse.math;
 import gse.utility;
@@ -19,6 +22,11 @@ export namespace gse::network {
 		return system_clock::now<time_t<std::uint64_t, milliseconds>>().as<milliseconds>();
 	}
 
+	inline auto session_time_ms() -> std::uint32_t {
+		static const std::uint64_t start = current_time_ms();
+		return std::max<std::uint32_t>(static_cast<std::uint32_t>(current_time_ms() - start), 1);
+	}
+
 	class remote_peer {
 	public:
 		explicit remote_peer(const address& addr);
@@ -52,6 +60,15 @@ export namespace gse::network {
 		auto pending_reliable_count(
 		) const -> std::size_t;
 
+		auto baselines(
+		) -> baseline_store&;
+
+		auto priorities(
+		) -> priority_scheduler&;
+
+		auto owner_indices(
+		) -> owner_index_table&;
+
 	private:
 		address m_address;
 
@@ -61,6 +78,10 @@ export namespace gse::network {
 
 		std::vector<pending_reliable_message> m_pending_reliable;
 		std::uint32_t m_last_processed_ack = 0;
+
+		std::unique_ptr<baseline_store> m_baselines = std::make_unique<baseline_store>();
+		std::unique_ptr<priority_scheduler> m_priorities = std::make_unique<priority_scheduler>();
+		std::unique_ptr<owner_index_table> m_owner_indices = std::make_unique<owner_index_table>();
 	};
 }
 
@@ -109,6 +130,7 @@ auto gse::network::remote_peer::process_acks(const std::uint32_t ack, const std:
 		return false;
 	});
 
+	m_baselines->acknowledge(ack, ack_bits);
 	m_last_processed_ack = std::max(m_last_processed_ack, ack);
 }
 
@@ -127,4 +149,16 @@ auto gse::network::remote_peer::messages_to_resend(const std::uint32_t retry_int
 
 auto gse::network::remote_peer::pending_reliable_count() const -> std::size_t {
 	return m_pending_reliable.size();
-}
\ No newline at end of file
+}
+
+auto gse::network::remote_peer::baselines() -> baseline_store& {
+	return *m_baselines;
+}
+
+auto gse::network::remote_peer::priorities() -> priority_scheduler& {
+	return *m_priorities;
+}
+
+auto gse::network::remote_peer::owner_indices() -> owner_index_table& {
+	return *m_owner_indices;
+}
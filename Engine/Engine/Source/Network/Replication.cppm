@@ -10,103 +10,163 @@ import :message;
 import :bitstream;
 import :packet_header;
 import :remote_peer;
+import :baseline;
+import :owner_index;
+import :interest;
 
 export namespace gse::network {
     template <typename T>
-    auto broadcast_component_deltas(
+    auto send_component_delta(
         auto& send_fn,
-        registry& reg,
-        const std::unordered_map<address, remote_peer>& peers
-    ) -> void;
+        id owner_id,
+        const typename T::network_data_t& data,
+        const address& addr,
+        remote_peer& peer,
+        bool delta_encoding
+    ) -> std::size_t;
 
-    auto replicate_deltas(
+    template <typename T>
+    auto collect_component_changes(
         auto& send_fn,
         registry& reg,
-        const std::unordered_map<address, remote_peer>& peers
+        std::unordered_map<address, remote_peer>& peers,
+        const interest_manager& interest
     ) -> void;
 
-    template <typename T>
-    auto snapshot_components_to(
+    auto send_prioritized(
         auto& send_fn,
         registry& reg,
-        const address& addr
-    ) -> void;
+        const address& addr,
+        remote_peer& peer,
+        const interest_manager& interest,
+        bool delta_encoding
+    ) -> std::size_t;
 
-    auto replicate_snapshot_to(
+    auto replicate_deltas(
         auto& send_fn,
         registry& reg,
-        const address& addr
+        std::unordered_map<address, remote_peer>& peers,
+        const interest_manager& interest,
+        bool delta_encoding
     ) -> void;
 }
 
 template <typename T>
-auto gse::network::broadcast_component_deltas(auto& send_fn, registry& reg, const std::unordered_map<address, remote_peer>& peers) -> void {
-    for (const auto& eid : reg.drain_component_adds<T>()) {
-        if (auto* c = reg.try_linked_object_read<T>(eid)) {
-            component_upsert<T> m{
-            	.owner_id = eid,
-            	.data = c->networked_data()
-            };
-
-            for (const auto& addr : peers | std::views::keys) {
-                send_fn(m, addr);
+auto gse::network::send_component_delta(auto& send_fn, const id owner_id, const typename T::network_data_t& data, const address& addr, remote_peer& peer, const bool delta_encoding) -> std::size_t {
+    const auto key = baseline_key_of<T>(owner_id);
+
+    typename T::network_data_t baseline{};
+    const auto baseline_sequence = delta_encoding ? peer.baselines().acked(key, std::as_writable_bytes(std::span{ &baseline, 1 })) : no_baseline;
+
+    const auto m = make_component_delta<T>(owner_id, peer.owner_indices().index_of(owner_id), baseline_sequence, baseline, data);
+    const auto token = peer.baselines().record(key, std::as_bytes(std::span{ &data, 1 }), baseline_sequence);
+
+    return send_fn(m, addr, token);
+}
+
+template <typename T>
+auto gse::network::collect_component_changes(auto& send_fn, registry& reg, std::unordered_map<address, remote_peer>& peers, const interest_manager& interest) -> void {
+    constexpr std::uint32_t type_bit = 1u << networked_index<T>();
+
+    for (auto& [addr, peer] : peers) {
+        for (const auto& eid : interest.left(addr)) {
+            peer.priorities().drop(eid);
+            if (reg.try_linked_object_read<T>(eid)) {
+                peer.baselines().forget(baseline_key_of<T>(eid));
+                if (const auto index = peer.owner_indices().find(eid)) {
+                    send_fn(component_remove<T>{ .owner_id = eid, .owner_index = *index }, addr);
+                }
+            }
+        }
+
+        for (const auto& eid : interest.entered(addr)) {
+            if (reg.try_linked_object_read<T>(eid)) {
+                peer.baselines().forget(baseline_key_of<T>(eid));
+                peer.priorities().mark(eid, type_bit, priority_weight<T>, true);
             }
         }
     }
 
-    for (const auto& eid : reg.drain_component_updates<T>()) {
-        if (auto* c = reg.try_linked_object_read<T>(eid)) {
-            component_upsert<T> m{ .owner_id = eid, .data = c->networked_data() };
-            for (const auto& addr : peers | std::views::keys) {
-                send_fn(m, addr);
+    auto mark_changed = [&](const id eid) {
+        for (auto& [addr, peer] : peers) {
+            if (interest.relevant(addr, eid) && !interest.entered(addr, eid)) {
+                peer.priorities().mark(eid, type_bit, priority_weight<T>);
             }
         }
+    };
+
+    for (const auto& eid : reg.drain_component_adds<T>()) {
+        mark_changed(eid);
+    }
+
+    for (const auto& eid : reg.drain_component_updates<T>()) {
+        mark_changed(eid);
     }
 
     for (const auto& eid : reg.drain_component_removes<T>()) {
-        component_remove<T> m{
-        	.owner_id = eid
-        };
-        for (const auto& addr : peers | std::views::keys) {
-            send_fn(m, addr);
+        for (auto& [addr, peer] : peers) {
+            peer.baselines().forget(baseline_key_of<T>(eid));
+            if (const auto index = peer.owner_indices().find(eid)) {
+                send_fn(component_remove<T>{ .owner_id = eid, .owner_index = *index }, addr);
+            }
         }
     }
 }
 
-auto gse::network::replicate_deltas(auto& send_fn, registry& reg, const std::unordered_map<address, remote_peer>& peers) -> void {
-    if (peers.empty()) {
-        return;
-    }
-
-    task::group group;
+auto gse::network::send_prioritized(auto& send_fn, registry& reg, const address& addr, remote_peer& peer, const interest_manager& interest, const bool delta_encoding) -> std::size_t {
+    auto& scheduler = peer.priorities();
 
-    for_each_networked_component([&]<typename C>() {
-        group.post([&send_fn, &reg, &peers] {
-        	broadcast_component_deltas<C>(send_fn, reg, peers);
-        });
+    scheduler.accumulate([&](const id eid) {
+        return interest.viewer_distance(addr, eid);
     });
-}
 
-template <typename T>
-auto gse::network::snapshot_components_to(auto& send_fn, registry& reg, const address& addr) -> void {
-    std::size_t count = 0;
-
-    for (const auto& c : reg.linked_objects_write<T>()) {
-        component_upsert<T> m{
-            .owner_id = c.owner_id(),
-            .data = c.networked_data()
-        };
-        send_fn(m, addr);
-        ++count;
+    std::size_t spent = 0;
+
+    for (const auto& eid : scheduler.order()) {
+        if (spent >= scheduler.budget()) {
+            break;
+        }
+
+        const auto types = scheduler.take(eid);
+        const auto handle = reg.handle(eid);
+        if (!handle) {
+            continue;
+        }
+
+        for_each_networked_component([&]<typename C>() {
+            if ((types & (1u << networked_index<C>())) == 0) {
+                return;
+            }
+            if (auto* c = reg.try_linked_object_read<C>(*handle)) {
+                spent += send_component_delta<C>(send_fn, eid, c->networked_data(), addr, peer, delta_encoding);
+            }
+        });
     }
+
+    return spent;
 }
 
-auto gse::network::replicate_snapshot_to(auto& send_fn, registry& reg, const address& addr) -> void {
-    task::group group;
+auto gse::network::replicate_deltas(auto& send_fn, registry& reg, std::unordered_map<address, remote_peer>& peers, const interest_manager& interest, const bool delta_encoding) -> void {
+    if (peers.empty()) {
+        return;
+    }
 
     for_each_networked_component([&]<typename C>() {
-        group.post([&] {
-            snapshot_components_to<C>(send_fn, reg, addr);
-        });
+        collect_component_changes<C>(send_fn, reg, peers, interest);
     });
+
+    std::atomic<std::size_t> pending = 0;
+
+    {
+        task::group group;
+
+        for (auto& [addr, peer] : peers) {
+            group.post([&send_fn, &reg, &addr, &peer, &interest, &pending, delta_encoding] {
+                send_prioritized(send_fn, reg, addr, peer, interest, delta_encoding);
+                pending.fetch_add(peer.priorities().pending(), std::memory_order_relaxed);
+            });
+        }
+    }
+
+    trace::counter(find_or_generate_id("network.replication.deferred"), static_cast<double>(pending.load(std::memory_order_relaxed)));
 }
@@ -0,0 +1,123 @@
+export module gse.network:send_queue;
+
+import std;
+
+import :bitstream;
+import :message;
+import :message_batch;
+import :packet_header;
+import :packet_buffer;
+import :remote_peer;
+
+export namespace gse::network {
+	class send_queue {
+	public:
+		template <is_message T>
+		auto push(
+			const T& msg,
+			std::uint32_t baseline_token = 0
+		) -> std::size_t;
+
+		template <typename F>
+		auto flush(
+			remote_peer& peer,
+			F&& emit
+		) -> std::size_t;
+
+		auto pending_messages(
+		) const -> std::size_t;
+
+		auto pending_bytes(
+		) const -> std::size_t;
+	private:
+		mutable std::mutex m_mutex;
+		std::vector<std::byte> m_pending;
+		std::vector<std::byte> m_flushing;
+		std::vector<std::uint32_t> m_tokens;
+		std::vector<std::uint32_t> m_flushing_tokens;
+	};
+}
+
+template <gse::network::is_message T>
+auto gse::network::send_queue::push(const T& msg, const std::uint32_t baseline_token) -> std::size_t {
+	thread_local std::vector<std::byte> scratch;
+	scratch.clear();
+
+	if (!encode_batched(msg, scratch)) {
+		return 0;
+	}
+
+	std::lock_guard lock(m_mutex);
+	m_pending.insert(m_pending.end(), scratch.begin(), scratch.end());
+	m_tokens.push_back(baseline_token);
+	return scratch.size();
+}
+
+template <typename F>
+auto gse::network::send_queue::flush(remote_peer& peer, F&& emit) -> std::size_t {
+	{
+		std::lock_guard lock(m_mutex);
+		if (m_tokens.empty()) {
+			return 0;
+		}
+		m_flushing.swap(m_pending);
+		m_flushing_tokens.swap(m_tokens);
+		m_pending.clear();
+		m_tokens.clear();
+	}
+
+	std::size_t packets = 0;
+	std::size_t cursor = 0;
+	std::size_t message = 0;
+
+	const auto server_time = session_time_ms();
+
+	while (cursor < m_flushing.size()) {
+		const packet_header header{
+			.sequence = ++peer.sequence(),
+			.ack = peer.remote_ack_sequence(),
+			.ack_bits = peer.remote_ack_bitfield(),
+			.server_time = server_time
+		};
+
+		auto buffer = packet_buffer::acquire();
+		bitstream stream(buffer.data());
+		stream.write(header);
+		stream.write(message_id(std::type_identity<message_batch>{}));
+
+		while (cursor < m_flushing.size()) {
+			std::uint16_t length = 0;
+			std::memcpy(&length, m_flushing.data() + cursor, batch_length_size);
+
+			const std::size_t entry_size = batch_length_size + length;
+			if (entry_size > stream.remaining_bytes()) {
+				break;
+			}
+
+			stream.write_bytes(m_flushing.data() + cursor, entry_size);
+			cursor += entry_size;
+
+			if (const auto token = m_flushing_tokens[message++]; token != 0) {
+				peer.baselines().assign(token, header.sequence);
+			}
+		}
+
+		buffer.resize(stream.bytes_written());
+		std::invoke(emit, std::move(buffer));
+		++packets;
+	}
+
+	m_flushing.clear();
+	m_flushing_tokens.clear();
+	return packets;
+}
+
+auto gse::network::send_queue::pending_messages() const -> std::size_t {
+	std::lock_guard lock(m_mutex);
+	return m_tokens.size();
+}
+
+auto gse::network::send_queue::pending_bytes() const -> std::size_t {
+	std::lock_guard lock(m_mutex);
+	return m_pending.size();
+}
@@ -1,8 +1,22 @@
 module;
 
 #include <iostream>
+
+#ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+#endif
 
 #undef assert
 
@@ -14,6 +28,7 @@ import gse.assert;
 import gse.math;
 
 namespace gse::network {
+#ifdef _WIN32
 	struct winsock_initializer {
 		winsock_initializer() {
 			WSADATA wsa_data;
@@ -28,6 +43,13 @@ namespace gse::network {
 	};
 
 	static winsock_initializer g_winsock_init;
+
+	using native_socket = SOCKET;
+	using socket_length = int;
+#else
+	using native_socket = int;
+	using socket_length = socklen_t;
+#endif
 }
 
 export namespace gse::network {
@@ -43,6 +65,18 @@ export namespace gse::network {
 		auto operator<=>(const address&) const = default;
 	};
 
+	struct datagram {
+		std::span<std::byte> buffer;
+		std::size_t size = 0;
+		address addr;
+	};
+
+	struct socket_options {
+		bool reuse_port = false;
+		std::size_t receive_buffer_size = 0;
+		std::size_t send_buffer_size = 0;
+	};
+
 	enum struct socket_state {
 		ready,
 		sending,
@@ -63,7 +97,8 @@ export namespace gse::network {
 		~udp_socket();
 
 		auto bind(
-			const address& address
+			const address& address,
+			const socket_options& options = {}
 		) -> bool;
 
 		auto local_address(
@@ -83,6 +118,14 @@ export namespace gse::network {
 			std::span<std::byte> buffer
 		) const -> std::optional<receive_result>;
 
+		auto receive_batch(
+			std::span<datagram> slots
+		) const -> std::size_t;
+
+		auto send_batch(
+			std::span<const datagram> datagrams
+		) const -> std::size_t;
+
 		auto wait_readable(
 			time_t<std::uint32_t> timeout
 		) const -> wait_result;
@@ -93,88 +136,199 @@ export namespace gse::network {
 		auto valid(
 		) const -> bool;
 	private:
+		static constexpr std::size_t max_batch = 64;
+
+		auto close(
+		) -> void;
+
 		std::uint64_t m_socket_id;
 		address m_local_address;
+#ifdef __linux__
+		int m_epoll_id = -1;
+#endif
+	};
+}
+
+namespace gse::network {
+	constexpr std::uint64_t invalid_socket = std::numeric_limits<std::uint64_t>::max();
+
+	auto native(
+		std::uint64_t socket_id
+	) -> native_socket;
+
+	auto last_error(
+	) -> int;
+
+	auto would_block(
+		int error
+	) -> bool;
+
+	auto close_native(
+		std::uint64_t socket_id
+	) -> void;
+
+	auto to_address(
+		const sockaddr_in& addr
+	) -> address;
+
+	auto to_sockaddr(
+		const address& address
+	) -> sockaddr_in;
+}
+
+auto gse::network::native(const std::uint64_t socket_id) -> native_socket {
+	return static_cast<native_socket>(socket_id);
+}
+
+auto gse::network::last_error() -> int {
+#ifdef _WIN32
+	return WSAGetLastError();
+#else
+	return errno;
+#endif
+}
+
+auto gse::network::would_block(const int error) -> bool {
+#ifdef _WIN32
+	return error == WSAEWOULDBLOCK;
+#else
+	return error == EAGAIN || error == EWOULDBLOCK;
+#endif
+}
+
+auto gse::network::close_native(const std::uint64_t socket_id) -> void {
+#ifdef _WIN32
+	closesocket(native(socket_id));
+#else
+	::close(native(socket_id));
+#endif
+}
+
+auto gse::network::to_address(const sockaddr_in& addr) -> address {
+	std::array<char, INET_ADDRSTRLEN> ip{};
+	inet_ntop(AF_INET, &addr.sin_addr, ip.data(), ip.size());
+
+	return {
+		.ip = ip.data(),
+		.port = ntohs(addr.sin_port)
 	};
 }
 
-gse::network::udp_socket::udp_socket() : m_socket_id(INVALID_SOCKET) {
-	m_socket_id = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-	assert(m_socket_id != INVALID_SOCKET, std::source_location::current(), "Failed to create socket.");
+auto gse::network::to_sockaddr(const address& address) -> sockaddr_in {
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(address.port);
+	inet_pton(AF_INET, address.ip.c_str(), &addr.sin_addr);
+	return addr;
+}
+
+gse::network::udp_socket::udp_socket() : m_socket_id(invalid_socket) {
+	m_socket_id = static_cast<std::uint64_t>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+	assert(m_socket_id != invalid_socket, std::source_location::current(), "Failed to create socket.");
 }
 
 gse::network::udp_socket::~udp_socket() {
-	if (m_socket_id != INVALID_SOCKET) {
-		closesocket(m_socket_id);
+	close();
+}
+
+auto gse::network::udp_socket::close() -> void {
+	if (m_socket_id != invalid_socket) {
+		close_native(m_socket_id);
+		m_socket_id = invalid_socket;
+	}
+
+#ifdef __linux__
+	if (m_epoll_id >= 0) {
+		::close(m_epoll_id);
+		m_epoll_id = -1;
 	}
+#endif
 }
 
-auto gse::network::udp_socket::bind(const address& address) -> bool {
-	if (m_socket_id == INVALID_SOCKET) {
+auto gse::network::udp_socket::bind(const address& address, const socket_options& options) -> bool {
+	if (m_socket_id == invalid_socket) {
 		return false;
 	}
 
 	// Allow address reuse to avoid TIME_WAIT issues
 	int opt = 1;
-	setsockopt(m_socket_id, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
+	setsockopt(native(m_socket_id), SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&opt), sizeof(opt));
 
-	sockaddr_in addr {
-		.sin_family = AF_INET,
-		.sin_port = htons(address.port),
-		.sin_addr = {}
-	};
+#ifdef SO_REUSEPORT
+	if (options.reuse_port) {
+		setsockopt(native(m_socket_id), SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<const char*>(&opt), sizeof(opt));
+	}
+#endif
 
-	inet_pton(AF_INET, address.ip.c_str(), &addr.sin_addr);
+	if (options.receive_buffer_size > 0) {
+		const int size = static_cast<int>(options.receive_buffer_size);
+		setsockopt(native(m_socket_id), SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&size), sizeof(size));
+	}
+
+	if (options.send_buffer_size > 0) {
+		const int size = static_cast<int>(options.send_buffer_size);
+		setsockopt(native(m_socket_id), SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&size), sizeof(size));
+	}
+
+	const sockaddr_in addr = to_sockaddr(address);
 
-	if (::bind(m_socket_id, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR) {
-		const int err = WSAGetLastError();
-		std::println(std::cerr, "Failed to bind socket: error {}", err);
-		closesocket(m_socket_id);
-		m_socket_id = INVALID_SOCKET;
+	if (::bind(native(m_socket_id), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+		std::println(std::cerr, "Failed to bind socket: error {}", last_error());
+		close();
 		return false;
 	}
 
 	// Retrieve the actual bound address (important when port 0 was requested)
 	sockaddr_in bound_addr{};
-	int bound_addr_len = sizeof(bound_addr);
-	if (getsockname(m_socket_id, reinterpret_cast<sockaddr*>(&bound_addr), &bound_addr_len) == 0) {
-		m_local_address.ip = inet_ntoa(bound_addr.sin_addr);
-		m_local_address.port = ntohs(bound_addr.sin_port);
+	socket_length bound_addr_len = sizeof(bound_addr);
+	if (getsockname(native(m_socket_id), reinterpret_cast<sockaddr*>(&bound_addr), &bound_addr_len) == 0) {
+		m_local_address = to_address(bound_addr);
 	}
 
+#ifdef _WIN32
 	u_long mode = 1;
-	if (ioctlsocket(m_socket_id, FIONBIO, &mode) == SOCKET_ERROR) {
+	const bool non_blocking = ioctlsocket(native(m_socket_id), FIONBIO, &mode) != SOCKET_ERROR;
+#else
+	const int flags = fcntl(native(m_socket_id), F_GETFL, 0);
+	const bool non_blocking = flags >= 0 && fcntl(native(m_socket_id), F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+
+	if (!non_blocking) {
 		std::println(std::cerr, "Failed to set non-blocking mode");
-		closesocket(m_socket_id);
-		m_socket_id = INVALID_SOCKET;
+		close();
+		return false;
+	}
+
+#ifdef __linux__
+	m_epoll_id = epoll_create1(EPOLL_CLOEXEC);
+	epoll_event ev{};
+	ev.events = EPOLLIN;
+	if (m_epoll_id < 0 || epoll_ctl(m_epoll_id, EPOLL_CTL_ADD, native(m_socket_id), &ev) != 0) {
+		std::println(std::cerr, "Failed to register socket with epoll: error {}", last_error());
+		close();
 		return false;
 	}
+#endif
 
 	return true;
 }
 
 auto gse::network::udp_socket::local_address() const -> std::optional<address> {
-	if (m_socket_id == INVALID_SOCKET || m_local_address.port == 0) {
+	if (m_socket_id == invalid_socket || m_local_address.port == 0) {
 		return std::nullopt;
 	}
 	return m_local_address;
 }
 
 auto gse::network::udp_socket::valid() const -> bool {
-	return m_socket_id != INVALID_SOCKET;
+	return m_socket_id != invalid_socket;
 }
 
 auto gse::network::udp_socket::send_data(const packet& packet, const address& address) const -> socket_state {
-	sockaddr_in addr {
-		.sin_family = AF_INET,
-		.sin_port = htons(address.port),
-		.sin_addr = {}
-	};
-
-	inet_pton(AF_INET, address.ip.c_str(), &addr.sin_addr);
+	const sockaddr_in addr = to_sockaddr(address);
 
-	if (const auto result = sendto(m_socket_id, reinterpret_cast<const char*>(packet.data), packet.size, 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)); result == SOCKET_ERROR) {
-		std::println(std::cerr, "Socket: sendto failed, error {}", WSAGetLastError());
+	if (const auto result = sendto(native(m_socket_id), reinterpret_cast<const char*>(packet.data), static_cast<int>(packet.size), 0, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)); result < 0) {
+		std::println(std::cerr, "Socket: sendto failed, error {}", last_error());
 		return socket_state::error;
 	}
 
@@ -183,10 +337,10 @@ auto gse::network::udp_socket::send_data(const packet& packet, const address& ad
 
 auto gse::network::udp_socket::receive_data(std::span<std::byte> buffer) const -> std::optional<receive_result> {
 	sockaddr_in addr;
-	int addr_len = sizeof(addr);
+	socket_length addr_len = sizeof(addr);
 
-	const int result = ::recvfrom(
-		m_socket_id,
+	const auto result = ::recvfrom(
+		native(m_socket_id),
 		reinterpret_cast<char*>(buffer.data()),
 		static_cast<int>(buffer.size()),
 		0,
@@ -194,30 +348,143 @@ auto gse::network::udp_socket::receive_data(std::span<std::byte> buffer) const -
 		&addr_len
 	);
 
-	if (result == SOCKET_ERROR) {
-		if (const int err = WSAGetLastError(); err == WSAEWOULDBLOCK) {
-			return std::nullopt;
-		}
-
+	if (result < 0) {
 		return std::nullopt;
 	}
 
 	return receive_result{
 		.bytes_read = static_cast<std::size_t>(result),
-		.from = {
-			.ip = inet_ntoa(addr.sin_addr),
-			.port = ntohs(addr.sin_port)
-		}
+		.from = to_address(addr)
 	};
 }
 
+auto gse::network::udp_socket::receive_batch(const std::span<datagram> slots) const -> std::size_t {
+#ifdef __linux__
+	const std::size_t n = std::min(slots.size(), max_batch);
+
+	std::array<mmsghdr, max_batch> messages{};
+	std::array<iovec, max_batch> vectors{};
+	std::array<sockaddr_in, max_batch> from{};
+
+	for (std::size_t i = 0; i < n; ++i) {
+		vectors[i] = {
+			.iov_base = slots[i].buffer.data(),
+			.iov_len = slots[i].buffer.size()
+		};
+		messages[i].msg_hdr.msg_name = &from[i];
+		messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		messages[i].msg_hdr.msg_iov = &vectors[i];
+		messages[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	const int received = recvmmsg(native(m_socket_id), messages.data(), static_cast<unsigned int>(n), MSG_DONTWAIT, nullptr);
+	if (received <= 0) {
+		return 0;
+	}
+
+	for (int i = 0; i < received; ++i) {
+		slots[i].size = messages[i].msg_len;
+		slots[i].addr = to_address(from[i]);
+	}
+
+	return static_cast<std::size_t>(received);
+#else
+	std::size_t count = 0;
+	for (auto& slot : slots) {
+		const auto received = receive_data(slot.buffer);
+		if (!received) {
+			break;
+		}
+		slot.size = received->bytes_read;
+		slot.addr = received->from;
+		++count;
+	}
+	return count;
+#endif
+}
+
+auto gse::network::udp_socket::send_batch(const std::span<const datagram> datagrams) const -> std::size_t {
+#ifdef __linux__
+	std::size_t sent = 0;
+
+	std::array<mmsghdr, max_batch> messages{};
+	std::array<iovec, max_batch> vectors{};
+	std::array<sockaddr_in, max_batch> to{};
+
+	while (sent < datagrams.size()) {
+		const std::size_t n = std::min(datagrams.size() - sent, max_batch);
+
+		for (std::size_t i = 0; i < n; ++i) {
+			const auto& d = datagrams[sent + i];
+			to[i] = to_sockaddr(d.addr);
+			vectors[i] = {
+				.iov_base = d.buffer.data(),
+				.iov_len = d.size
+			};
+			messages[i] = {};
+			messages[i].msg_hdr.msg_name = &to[i];
+			messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			messages[i].msg_hdr.msg_iov = &vectors[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		const int result = sendmmsg(native(m_socket_id), messages.data(), static_cast<unsigned int>(n), 0);
+		if (result <= 0) {
+			if (const int err = last_error(); !would_block(err)) {
+				std::println(std::cerr, "Socket: sendmmsg failed, error {}", err);
+			}
+			break;
+		}
+
+		sent += static_cast<std::size_t>(result);
+	}
+
+	return sent;
+#else
+	std::size_t sent = 0;
+	for (const auto& d : datagrams) {
+		const packet p{
+			.data = reinterpret_cast<std::uint8_t*>(d.buffer.data()),
+			.size = d.size
+		};
+		if (send_data(p, d.addr) == socket_state::error) {
+			break;
+		}
+		++sent;
+	}
+	return sent;
+#endif
+}
+
 auto gse::network::udp_socket::wait_readable(const time_t<std::uint32_t> timeout) const -> wait_result {
+	const int timeout_ms = static_cast<int>(timeout.as<milliseconds>());
+
+#ifdef _WIN32
 	WSAPOLLFD pfd{
-		.fd = static_cast<SOCKET>(m_socket_id),
+		.fd = native(m_socket_id),
 		.events = POLLRDNORM | POLLERR | POLLHUP
 	};
 
-	const int rv = WSAPoll(&pfd, 1, static_cast<int>(timeout.as<milliseconds>()));
+	const int rv = WSAPoll(&pfd, 1, timeout_ms);
+#elif defined(__linux__)
+	if (m_epoll_id < 0) {
+		return wait_result::error;
+	}
+
+	epoll_event ev{};
+	const int rv = epoll_wait(m_epoll_id, &ev, 1, timeout_ms);
+	if (rv > 0) {
+		return ev.events & (EPOLLERR | EPOLLHUP) ? wait_result::error : wait_result::ready;
+	}
+#else
+	pollfd pfd{
+		.fd = native(m_socket_id),
+		.events = POLLIN
+	};
+
+	const int rv = poll(&pfd, 1, timeout_ms);
+#endif
+
 	if (rv == 0) {
 		return wait_result::timeout;
 	}
@@ -225,12 +492,14 @@ auto gse::network::udp_socket::wait_readable(const time_t<std::uint32_t> timeout
 		return wait_result::error;
 	}
 
+#ifndef __linux__
 	if (pfd.revents & (POLLERR | POLLHUP)) {
 		return wait_result::error;
 	}
 	if (pfd.revents & (POLLRDNORM | POLLPRI | POLLIN)) {
 		return wait_result::ready;
 	}
+#endif
 
 	return wait_result::timeout;
 }
@@ -238,5 +507,3 @@ auto gse::network::udp_socket::wait_readable(const time_t<std::uint32_t> timeout
 auto gse::network::udp_socket::id() const -> std::uint64_t {
 	return m_socket_id;
 }
-
-
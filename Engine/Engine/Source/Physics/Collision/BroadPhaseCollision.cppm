@@ -0,0 +1,500 @@
+export module gse.physics:broad_phase_collision;
+
+import std;
+
+import gse.math;
+import gse.utility;
+
+import :bounding_box;
+
+export namespace gse::physics {
+	enum class broad_phase_mode {
+		brute_force,
+		dynamic_tree
+	};
+
+	struct broad_phase_pair {
+		std::uint32_t a = 0;
+		std::uint32_t b = 0;
+
+		auto operator<=>(const broad_phase_pair&) const = default;
+	};
+
+	struct broad_phase_stats {
+		broad_phase_mode mode = broad_phase_mode::dynamic_tree;
+		std::uint32_t proxy_count = 0;
+		std::uint32_t candidate_pairs = 0;
+		time_t<float, seconds> time = {};
+	};
+
+	class dynamic_aabb_tree {
+	public:
+		explicit dynamic_aabb_tree(
+			length fat_margin = meters(0.1f)
+		);
+
+		auto begin_update(
+		) -> void;
+
+		auto update(
+			id owner,
+			const aabb& bounds,
+			std::uint32_t user_index
+		) -> void;
+
+		auto end_update(
+		) -> void;
+
+		auto remove(
+			id owner
+		) -> void;
+
+		auto clear(
+		) -> void;
+
+		auto find_pairs(
+			std::span<const aabb> bounds,
+			length margin,
+			std::vector<broad_phase_pair>& out,
+			std::span<const std::uint8_t> awake = {}
+		) const -> void;
+
+		template <typename F>
+		auto query(
+			const aabb& bounds,
+			F&& fn
+		) const -> void;
+
+		auto proxy_count(
+		) const -> std::size_t;
+
+		auto height(
+		) const -> std::int32_t;
+	private:
+		static constexpr std::uint32_t null_node = std::numeric_limits<std::uint32_t>::max();
+
+		struct node {
+			aabb bounds;
+			std::uint32_t parent = null_node;
+			std::uint32_t left = null_node;
+			std::uint32_t right = null_node;
+			std::int32_t height = -1;
+			std::uint32_t user_index = 0;
+			std::uint64_t stamp = 0;
+			id owner;
+
+			auto leaf() const -> bool { return left == null_node; }
+		};
+
+		auto allocate_node(
+		) -> std::uint32_t;
+
+		auto free_node(
+			std::uint32_t index
+		) -> void;
+
+		auto insert_leaf(
+			std::uint32_t leaf
+		) -> void;
+
+		auto remove_leaf(
+			std::uint32_t leaf
+		) -> void;
+
+		auto balance(
+			std::uint32_t index
+		) -> std::uint32_t;
+
+		auto refit_ancestors(
+			std::uint32_t index
+		) -> void;
+
+		std::vector<node> m_nodes;
+		std::uint32_t m_root = null_node;
+		std::uint32_t m_free_list = null_node;
+		std::unordered_map<id, std::uint32_t> m_proxies;
+		std::uint64_t m_stamp = 0;
+		length m_fat_margin;
+	};
+}
+
+namespace gse::physics {
+	auto merge(
+		const aabb& a,
+		const aabb& b
+	) -> aabb;
+
+	auto contains(
+		const aabb& outer,
+		const aabb& inner
+	) -> bool;
+
+	auto surface_area(
+		const aabb& box
+	) -> float;
+
+	auto fatten(
+		const aabb& box,
+		length margin
+	) -> aabb;
+}
+
+gse::physics::dynamic_aabb_tree::dynamic_aabb_tree(const length fat_margin) : m_fat_margin(fat_margin) {}
+
+auto gse::physics::dynamic_aabb_tree::begin_update() -> void {
+	++m_stamp;
+}
+
+auto gse::physics::dynamic_aabb_tree::update(const id owner, const aabb& bounds, const std::uint32_t user_index) -> void {
+	if (const auto it = m_proxies.find(owner); it != m_proxies.end()) {
+		auto& n = m_nodes[it->second];
+		n.stamp = m_stamp;
+		n.user_index = user_index;
+
+		if (contains(n.bounds, bounds)) {
+			return;
+		}
+
+		remove_leaf(it->second);
+		m_nodes[it->second].bounds = fatten(bounds, m_fat_margin);
+		insert_leaf(it->second);
+		return;
+	}
+
+	const auto leaf = allocate_node();
+	auto& n = m_nodes[leaf];
+	n.bounds = fatten(bounds, m_fat_margin);
+	n.user_index = user_index;
+	n.stamp = m_stamp;
+	n.owner = owner;
+	n.height = 0;
+
+	insert_leaf(leaf);
+	m_proxies.emplace(owner, leaf);
+}
+
+auto gse::physics::dynamic_aabb_tree::end_update() -> void {
+	for (auto it = m_proxies.begin(); it != m_proxies.end(); ) {
+		if (m_nodes[it->second].stamp != m_stamp) {
+			remove_leaf(it->second);
+			free_node(it->second);
+			it = m_proxies.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+auto gse::physics::dynamic_aabb_tree::remove(const id owner) -> void {
+	const auto it = m_proxies.find(owner);
+	if (it == m_proxies.end()) return;
+
+	remove_leaf(it->second);
+	free_node(it->second);
+	m_proxies.erase(it);
+}
+
+auto gse::physics::dynamic_aabb_tree::clear() -> void {
+	m_nodes.clear();
+	m_proxies.clear();
+	m_root = null_node;
+	m_free_list = null_node;
+}
+
+auto gse::physics::dynamic_aabb_tree::find_pairs(const std::span<const aabb> bounds, const length margin, std::vector<broad_phase_pair>& out, const std::span<const std::uint8_t> awake) const -> void {
+	out.clear();
+	if (m_root == null_node) return;
+
+	std::vector<std::uint32_t> stack;
+	stack.reserve(64);
+
+	for (const auto& proxy : m_nodes) {
+		if (proxy.height != 0 || proxy.stamp != m_stamp) continue;
+		if (proxy.user_index >= bounds.size()) continue;
+		if (!awake.empty() && !awake[proxy.user_index]) continue;
+
+		const auto& tight = bounds[proxy.user_index];
+
+		stack.clear();
+		stack.push_back(m_root);
+		while (!stack.empty()) {
+			const auto& n = m_nodes[stack.back()];
+			stack.pop_back();
+
+			if (!n.bounds.overlaps(proxy.bounds, margin)) continue;
+
+			if (!n.leaf()) {
+				stack.push_back(n.left);
+				stack.push_back(n.right);
+				continue;
+			}
+
+			if (n.user_index == proxy.user_index || n.user_index >= bounds.size()) continue;
+
+			const bool n_awake = awake.empty() || awake[n.user_index];
+			if (n_awake && n.user_index < proxy.user_index) continue;
+			if (!tight.overlaps(bounds[n.user_index], margin)) continue;
+
+			out.push_back({ std::min(proxy.user_index, n.user_index), std::max(proxy.user_index, n.user_index) });
+		}
+	}
+
+	std::ranges::sort(out);
+}
+
+template <typename F>
+auto gse::physics::dynamic_aabb_tree::query(const aabb& bounds, F&& fn) const -> void {
+	if (m_root == null_node) return;
+
+	std::vector<std::uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(m_root);
+
+	while (!stack.empty()) {
+		const auto& n = m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (!n.bounds.overlaps(bounds)) continue;
+
+		if (n.leaf()) {
+			if constexpr (std::is_same_v<std::invoke_result_t<F&, std::uint32_t>, bool>) {
+				if (!fn(n.user_index)) return;
+			}
+			else {
+				fn(n.user_index);
+			}
+			continue;
+		}
+
+		stack.push_back(n.left);
+		stack.push_back(n.right);
+	}
+}
+
+auto gse::physics::dynamic_aabb_tree::proxy_count() const -> std::size_t {
+	return m_proxies.size();
+}
+
+auto gse::physics::dynamic_aabb_tree::height() const -> std::int32_t {
+	return m_root == null_node ? 0 : m_nodes[m_root].height;
+}
+
+auto gse::physics::dynamic_aabb_tree::allocate_node() -> std::uint32_t {
+	if (m_free_list != null_node) {
+		const auto index = m_free_list;
+		m_free_list = m_nodes[index].parent;
+		m_nodes[index] = {};
+		return index;
+	}
+
+	m_nodes.emplace_back();
+	return static_cast<std::uint32_t>(m_nodes.size() - 1);
+}
+
+auto gse::physics::dynamic_aabb_tree::free_node(const std::uint32_t index) -> void {
+	m_nodes[index] = {};
+	m_nodes[index].parent = m_free_list;
+	m_free_list = index;
+}
+
+auto gse::physics::dynamic_aabb_tree::insert_leaf(const std::uint32_t leaf) -> void {
+	if (m_root == null_node) {
+		m_root = leaf;
+		m_nodes[leaf].parent = null_node;
+		return;
+	}
+
+	const auto leaf_bounds = m_nodes[leaf].bounds;
+	std::uint32_t index = m_root;
+
+	while (!m_nodes[index].leaf()) {
+		const auto& n = m_nodes[index];
+		const float area = surface_area(n.bounds);
+		const float combined_area = surface_area(merge(n.bounds, leaf_bounds));
+
+		const float cost = 2.f * combined_area;
+		const float inheritance_cost = 2.f * (combined_area - area);
+
+		auto descend_cost = [&](const std::uint32_t child) {
+			const auto& c = m_nodes[child];
+			const float merged = surface_area(merge(leaf_bounds, c.bounds));
+			if (c.leaf()) {
+				return merged + inheritance_cost;
+			}
+			return merged - surface_area(c.bounds) + inheritance_cost;
+		};
+
+		const float cost_left = descend_cost(n.left);
+		const float cost_right = descend_cost(n.right);
+
+		if (cost < cost_left && cost < cost_right) {
+			break;
+		}
+
+		index = cost_left < cost_right ? n.left : n.right;
+	}
+
+	const std::uint32_t sibling = index;
+	const std::uint32_t old_parent = m_nodes[sibling].parent;
+	const std::uint32_t new_parent = allocate_node();
+
+	m_nodes[new_parent].parent = old_parent;
+	m_nodes[new_parent].bounds = merge(leaf_bounds, m_nodes[sibling].bounds);
+	m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+	m_nodes[new_parent].left = sibling;
+	m_nodes[new_parent].right = leaf;
+	m_nodes[sibling].parent = new_parent;
+	m_nodes[leaf].parent = new_parent;
+
+	if (old_parent != null_node) {
+		if (m_nodes[old_parent].left == sibling) {
+			m_nodes[old_parent].left = new_parent;
+		}
+		else {
+			m_nodes[old_parent].right = new_parent;
+		}
+	}
+	else {
+		m_root = new_parent;
+	}
+
+	refit_ancestors(m_nodes[leaf].parent);
+}
+
+auto gse::physics::dynamic_aabb_tree::remove_leaf(const std::uint32_t leaf) -> void {
+	if (leaf == m_root) {
+		m_root = null_node;
+		return;
+	}
+
+	const std::uint32_t parent = m_nodes[leaf].parent;
+	const std::uint32_t grand_parent = m_nodes[parent].parent;
+	const std::uint32_t sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+	if (grand_parent != null_node) {
+		if (m_nodes[grand_parent].left == parent) {
+			m_nodes[grand_parent].left = sibling;
+		}
+		else {
+			m_nodes[grand_parent].right = sibling;
+		}
+		m_nodes[sibling].parent = grand_parent;
+		free_node(parent);
+		refit_ancestors(grand_parent);
+	}
+	else {
+		m_root = sibling;
+		m_nodes[sibling].parent = null_node;
+		free_node(parent);
+	}
+
+	m_nodes[leaf].parent = null_node;
+}
+
+auto gse::physics::dynamic_aabb_tree::refit_ancestors(std::uint32_t index) -> void {
+	while (index != null_node) {
+		index = balance(index);
+
+		auto& n = m_nodes[index];
+		const auto& left = m_nodes[n.left];
+		const auto& right = m_nodes[n.right];
+
+		n.height = 1 + std::max(left.height, right.height);
+		n.bounds = merge(left.bounds, right.bounds);
+
+		index = n.parent;
+	}
+}
+
+auto gse::physics::dynamic_aabb_tree::balance(const std::uint32_t a_index) -> std::uint32_t {
+	auto& a = m_nodes[a_index];
+	if (a.leaf() || a.height < 2) {
+		return a_index;
+	}
+
+	const std::uint32_t b_index = a.left;
+	const std::uint32_t c_index = a.right;
+	const std::int32_t skew = m_nodes[c_index].height - m_nodes[b_index].height;
+
+	auto rotate_up = [&](const std::uint32_t up_index, const std::uint32_t other_index, const bool up_is_right) {
+		auto& up = m_nodes[up_index];
+		const std::uint32_t f_index = up.left;
+		const std::uint32_t g_index = up.right;
+
+		up.left = a_index;
+		up.parent = m_nodes[a_index].parent;
+		m_nodes[a_index].parent = up_index;
+
+		if (up.parent != null_node) {
+			if (m_nodes[up.parent].left == a_index) {
+				m_nodes[up.parent].left = up_index;
+			}
+			else {
+				m_nodes[up.parent].right = up_index;
+			}
+		}
+		else {
+			m_root = up_index;
+		}
+
+		const bool f_taller = m_nodes[f_index].height > m_nodes[g_index].height;
+		const std::uint32_t keep_index = f_taller ? f_index : g_index;
+		const std::uint32_t move_index = f_taller ? g_index : f_index;
+
+		up.right = keep_index;
+		if (up_is_right) {
+			m_nodes[a_index].right = move_index;
+		}
+		else {
+			m_nodes[a_index].left = move_index;
+		}
+		m_nodes[move_index].parent = a_index;
+
+		m_nodes[a_index].bounds = merge(m_nodes[other_index].bounds, m_nodes[move_index].bounds);
+		m_nodes[a_index].height = 1 + std::max(m_nodes[other_index].height, m_nodes[move_index].height);
+
+		up.bounds = merge(m_nodes[a_index].bounds, m_nodes[keep_index].bounds);
+		up.height = 1 + std::max(m_nodes[a_index].height, m_nodes[keep_index].height);
+
+		return up_index;
+	};
+
+	if (skew > 1) {
+		return rotate_up(c_index, b_index, true);
+	}
+	if (skew < -1) {
+		return rotate_up(b_index, c_index, false);
+	}
+
+	return a_index;
+}
+
+auto gse::physics::merge(const aabb& a, const aabb& b) -> aabb {
+	return {
+		.max = max(a.max, b.max),
+		.min = min(a.min, b.min)
+	};
+}
+
+auto gse::physics::contains(const aabb& outer, const aabb& inner) -> bool {
+	return
+		outer.min.x() <= inner.min.x() && outer.min.y() <= inner.min.y() && outer.min.z() <= inner.min.z() &&
+		outer.max.x() >= inner.max.x() && outer.max.y() >= inner.max.y() && outer.max.z() >= inner.max.z();
+}
+
+auto gse::physics::surface_area(const aabb& box) -> float {
+	const auto d = box.max - box.min;
+	const float x = d.x().as<meters>();
+	const float y = d.y().as<meters>();
+	const float z = d.z().as<meters>();
+	return 2.f * (x * y + y * z + z * x);
+}
+
+auto gse::physics::fatten(const aabb& box, const length margin) -> aabb {
+	const vec3<length> pad(margin);
+	return {
+		.max = box.max + pad,
+		.min = box.min - pad
+	};
+}
@@ -3,11 +3,13 @@ export module gse.physics:collision_component;
 import std;
 
 import :bounding_box;
+import :convex_hull;
+import :mesh_collider;
 
 import gse.utility;
 
 export namespace gse::physics {
-	enum class shape_type : std::uint8_t { box, sphere, capsule };
+	enum class shape_type : std::uint8_t { box, sphere, capsule, convex_hull, triangle_mesh, heightfield };
 
 	struct collision_component_data {
 		bounding_box bounding_box;
@@ -15,8 +17,15 @@ export namespace gse::physics {
 		shape_type shape = shape_type::box;
 		length shape_radius = {};
 		length shape_half_height = {};
+		std::shared_ptr<const convex_hull> hull;
+		std::shared_ptr<const triangle_mesh> mesh;
+		std::shared_ptr<const heightfield> field;
 		bool resolve_collisions = true;
 	};
 
 	using collision_component = component<collision_component_data>;
+
+	constexpr auto is_mesh_shape(const shape_type type) -> bool {
+		return type == shape_type::triangle_mesh || type == shape_type::heightfield;
+	}
 }
@@ -0,0 +1,439 @@
+export module gse.physics:convex_hull;
+
+import std;
+
+import gse.assert;
+import gse.math;
+
+import :bounding_box;
+import :contact_manifold;
+import :mesh_collider;
+
+export namespace gse::physics {
+	struct hull_hit {
+		length distance = {};
+		vec3f normal;
+	};
+
+	class convex_hull {
+	public:
+		struct face {
+			vec3f normal;
+			length distance = {};
+			std::uint32_t first = 0;
+			std::uint32_t count = 0;
+		};
+
+		static auto create(
+			std::span<const vec3<length>> points,
+			std::size_t vertex_budget = max_vertices
+		) -> std::shared_ptr<const convex_hull>;
+
+		static auto load(
+			const std::filesystem::path& baked_model_path
+		) -> std::shared_ptr<const convex_hull>;
+
+		auto write(
+			std::ostream& out
+		) const -> void;
+
+		auto support(
+			const vec3f& direction
+		) const -> const vec3<length>&;
+
+		auto best_face(
+			const vec3f& direction
+		) const -> std::uint32_t;
+
+		auto face_vertices(
+			std::uint32_t face_index
+		) const -> std::vector<vec3<length>>;
+
+		auto raycast(
+			const vec3<length>& origin,
+			const vec3f& direction,
+			length max_distance
+		) const -> std::optional<hull_hit>;
+
+		auto vertices(
+		) const -> std::span<const vec3<length>>;
+
+		auto faces(
+		) const -> std::span<const face>;
+
+		auto bounds(
+		) const -> const aabb&;
+
+		auto collider_size(
+		) const -> vec3<length>;
+
+		auto simplification_error(
+		) const -> length;
+
+		static constexpr std::size_t max_vertices = 128;
+		static_assert(2 * max_vertices - 4 < feature_side_none, "Hull face and side ids must fit in a feature_id.");
+	private:
+		std::vector<vec3<length>> m_vertices;
+		std::vector<std::uint32_t> m_face_indices;
+		std::vector<face> m_faces;
+		aabb m_bounds;
+		length m_simplification_error = {};
+	};
+}
+
+namespace gse::physics {
+	struct hull_triangle {
+		std::array<std::uint32_t, 3> v;
+		vec3f normal;
+		float distance = 0.f;
+		bool alive = true;
+	};
+
+	auto weld_points(
+		std::span<const vec3<length>> points,
+		float cell
+	) -> std::vector<vec3f>;
+
+	auto make_hull_triangle(
+		std::span<const vec3f> points,
+		std::uint32_t a,
+		std::uint32_t b,
+		std::uint32_t c
+	) -> hull_triangle;
+}
+
+auto gse::physics::weld_points(const std::span<const vec3<length>> points, const float cell) -> std::vector<vec3f> {
+	struct key_hash {
+		auto operator()(const std::array<std::int64_t, 3>& k) const noexcept -> std::size_t {
+			std::size_t seed = std::hash<std::int64_t>{}(k[0]);
+			seed ^= std::hash<std::int64_t>{}(k[1]) + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+			seed ^= std::hash<std::int64_t>{}(k[2]) + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+			return seed;
+		}
+	};
+
+	std::unordered_set<std::array<std::int64_t, 3>, key_hash> seen;
+	std::vector<vec3f> welded;
+	welded.reserve(points.size());
+
+	for (const auto& point : points) {
+		const vec3f p = to_meters(point);
+		const std::array key = {
+			static_cast<std::int64_t>(std::llround(p.x() / cell)),
+			static_cast<std::int64_t>(std::llround(p.y() / cell)),
+			static_cast<std::int64_t>(std::llround(p.z() / cell))
+		};
+		if (seen.insert(key).second) {
+			welded.push_back(p);
+		}
+	}
+
+	return welded;
+}
+
+auto gse::physics::make_hull_triangle(const std::span<const vec3f> points, const std::uint32_t a, const std::uint32_t b, const std::uint32_t c) -> hull_triangle {
+	const vec3f n = normalize(cross(points[b] - points[a], points[c] - points[a]));
+	return {
+		.v = { a, b, c },
+		.normal = n,
+		.distance = dot(n, points[a])
+	};
+}
+
+auto gse::physics::convex_hull::create(const std::span<const vec3<length>> points, const std::size_t vertex_budget) -> std::shared_ptr<const convex_hull> {
+	assert(vertex_budget >= 4 && vertex_budget <= max_vertices, std::source_location::current(), "Convex hull vertex budget must keep feature ids in range.");
+
+	const auto p = weld_points(points, 1e-4f);
+	if (p.size() < 4) return nullptr;
+
+	const auto farthest = [&](auto&& score) {
+		std::uint32_t best = 0;
+		float best_score = -std::numeric_limits<float>::max();
+		for (std::uint32_t i = 0; i < p.size(); ++i) {
+			if (const float value = score(p[i]); value > best_score) {
+				best_score = value;
+				best = i;
+			}
+		}
+		return std::pair{ best, best_score };
+	};
+
+	const auto i0 = farthest([](const vec3f& v) { return -v.x(); }).first;
+	const auto i1 = farthest([&](const vec3f& v) { return magnitude(v - p[i0]); }).first;
+	const auto i2 = farthest([&](const vec3f& v) { return magnitude(cross(p[i1] - p[i0], v - p[i0])); }).first;
+	const vec3f base_normal = normalize(cross(p[i1] - p[i0], p[i2] - p[i0]));
+	const auto [i3, height] = farthest([&](const vec3f& v) { return std::abs(dot(base_normal, v - p[i0])); });
+
+	const float scale = std::max(magnitude(p[i1] - p[i0]), 1e-3f);
+	const float epsilon = scale * 1e-5f;
+	if (!(height > epsilon)) return nullptr;
+
+	std::vector<hull_triangle> triangles;
+	const vec3f interior = (p[i0] + p[i1] + p[i2] + p[i3]) / 4.f;
+	for (const auto& [a, b, c] : { std::array{ i0, i1, i2 }, std::array{ i0, i3, i1 }, std::array{ i0, i2, i3 }, std::array{ i1, i3, i2 } }) {
+		auto t = make_hull_triangle(p, a, b, c);
+		if (dot(t.normal, interior) > t.distance) {
+			t = make_hull_triangle(p, a, c, b);
+		}
+		triangles.push_back(t);
+	}
+
+	std::vector<std::uint32_t> outside;
+	for (std::uint32_t i = 0; i < p.size(); ++i) {
+		if (i != i0 && i != i1 && i != i2 && i != i3) {
+			outside.push_back(i);
+		}
+	}
+
+	std::size_t hull_vertex_count = 4;
+	float remaining_error = 0.f;
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+
+	while (true) {
+		std::uint32_t next = 0;
+		float next_distance = epsilon;
+		std::erase_if(outside, [&](const std::uint32_t i) {
+			float distance = -std::numeric_limits<float>::max();
+			for (const auto& t : triangles) {
+				distance = std::max(distance, dot(t.normal, p[i]) - t.distance);
+			}
+			if (distance > next_distance) {
+				next_distance = distance;
+				next = i;
+			}
+			return distance <= epsilon;
+		});
+
+		if (outside.empty()) break;
+
+		if (hull_vertex_count == vertex_budget) {
+			remaining_error = next_distance;
+			break;
+		}
+
+		edges.clear();
+		for (auto& t : triangles) {
+			if (dot(t.normal, p[next]) - t.distance <= epsilon) continue;
+			t.alive = false;
+			edges.emplace_back(t.v[0], t.v[1]);
+			edges.emplace_back(t.v[1], t.v[2]);
+			edges.emplace_back(t.v[2], t.v[0]);
+		}
+
+		for (const auto& [u, v] : edges) {
+			if (std::ranges::find(edges, std::pair{ v, u }) != edges.end()) continue;
+			triangles.push_back(make_hull_triangle(p, u, v, next));
+		}
+
+		std::erase_if(triangles, [](const hull_triangle& t) { return !t.alive; });
+		std::erase(outside, next);
+		++hull_vertex_count;
+	}
+
+	auto hull = std::make_shared<convex_hull>();
+	std::vector<std::uint32_t> remap(p.size(), std::numeric_limits<std::uint32_t>::max());
+	std::vector<std::uint8_t> grouped(triangles.size(), 0);
+
+	for (std::size_t t = 0; t < triangles.size(); ++t) {
+		if (grouped[t]) continue;
+
+		const auto& seed = triangles[t];
+		std::vector<std::uint32_t> members;
+		for (std::size_t u = t; u < triangles.size(); ++u) {
+			if (grouped[u]) continue;
+			if (dot(triangles[u].normal, seed.normal) < 1.f - 1e-4f || std::abs(triangles[u].distance - seed.distance) > epsilon * 10.f) continue;
+
+			grouped[u] = 1;
+			for (const auto v : triangles[u].v) {
+				if (std::ranges::find(members, v) == members.end()) {
+					members.push_back(v);
+				}
+			}
+		}
+
+		vec3f centroid = {};
+		for (const auto v : members) {
+			centroid += p[v];
+		}
+		centroid /= static_cast<float>(members.size());
+
+		const auto [tu, tv] = compute_tangent_basis(seed.normal);
+		std::ranges::sort(members, {}, [&](const std::uint32_t v) {
+			const vec3f d = p[v] - centroid;
+			return std::atan2(dot(d, tv), dot(d, tu));
+		});
+
+		const face f{
+			.normal = seed.normal,
+			.distance = meters(seed.distance),
+			.first = static_cast<std::uint32_t>(hull->m_face_indices.size()),
+			.count = static_cast<std::uint32_t>(members.size())
+		};
+
+		for (const auto v : members) {
+			if (remap[v] == std::numeric_limits<std::uint32_t>::max()) {
+				remap[v] = static_cast<std::uint32_t>(hull->m_vertices.size());
+				hull->m_vertices.push_back(from_meters(p[v]));
+			}
+			hull->m_face_indices.push_back(remap[v]);
+		}
+		hull->m_faces.push_back(f);
+	}
+
+	hull->m_bounds = {
+		.max = hull->m_vertices.front(),
+		.min = hull->m_vertices.front()
+	};
+	for (const auto& v : hull->m_vertices) {
+		hull->m_bounds.min = min(hull->m_bounds.min, v);
+		hull->m_bounds.max = max(hull->m_bounds.max, v);
+	}
+
+	hull->m_simplification_error = meters(remaining_error);
+
+	return hull;
+}
+
+auto gse::physics::convex_hull::load(const std::filesystem::path& baked_model_path) -> std::shared_ptr<const convex_hull> {
+	std::ifstream in_file(baked_model_path, std::ios::binary);
+	assert(in_file.is_open(), std::source_location::current(), "Failed to open baked model file for convex hull.");
+
+	std::uint32_t magic, version;
+	in_file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	in_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	assert(magic == baked_model_magic && version >= 2, std::source_location::current(), "Baked model has no convex hull section; recompile it.");
+
+	std::uint64_t mesh_count;
+	in_file.read(reinterpret_cast<char*>(&mesh_count), sizeof(mesh_count));
+	for (std::uint64_t i = 0; i < mesh_count; ++i) {
+		std::uint64_t mat_name_len;
+		in_file.read(reinterpret_cast<char*>(&mat_name_len), sizeof(mat_name_len));
+		in_file.seekg(static_cast<std::streamoff>(mat_name_len), std::ios::cur);
+
+		std::uint64_t vertex_count;
+		in_file.read(reinterpret_cast<char*>(&vertex_count), sizeof(vertex_count));
+		in_file.seekg(static_cast<std::streamoff>(vertex_count * sizeof(baked_vertex)), std::ios::cur);
+	}
+
+	std::uint8_t has_hull = 0;
+	in_file.read(reinterpret_cast<char*>(&has_hull), sizeof(has_hull));
+	assert(has_hull != 0, std::source_location::current(), "Baked model has no convex hull; its points span no volume.");
+
+	auto hull = std::make_shared<convex_hull>();
+	const auto read_vector = [&](auto& values) {
+		std::uint64_t count;
+		in_file.read(reinterpret_cast<char*>(&count), sizeof(count));
+		values.resize(count);
+		in_file.read(reinterpret_cast<char*>(values.data()), count * sizeof(values.front()));
+	};
+
+	read_vector(hull->m_vertices);
+	read_vector(hull->m_face_indices);
+	read_vector(hull->m_faces);
+	in_file.read(reinterpret_cast<char*>(&hull->m_bounds), sizeof(hull->m_bounds));
+	in_file.read(reinterpret_cast<char*>(&hull->m_simplification_error), sizeof(hull->m_simplification_error));
+
+	return hull;
+}
+
+auto gse::physics::convex_hull::write(std::ostream& out) const -> void {
+	const auto write_vector = [&](const auto& values) {
+		const std::uint64_t count = values.size();
+		out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		out.write(reinterpret_cast<const char*>(values.data()), count * sizeof(values.front()));
+	};
+
+	write_vector(m_vertices);
+	write_vector(m_face_indices);
+	write_vector(m_faces);
+	out.write(reinterpret_cast<const char*>(&m_bounds), sizeof(m_bounds));
+	out.write(reinterpret_cast<const char*>(&m_simplification_error), sizeof(m_simplification_error));
+}
+
+auto gse::physics::convex_hull::support(const vec3f& direction) const -> const vec3<length>& {
+	std::size_t best = 0;
+	length best_dot = dot(direction, m_vertices[0]);
+	for (std::size_t i = 1; i < m_vertices.size(); ++i) {
+		if (const length d = dot(direction, m_vertices[i]); d > best_dot) {
+			best_dot = d;
+			best = i;
+		}
+	}
+	return m_vertices[best];
+}
+
+auto gse::physics::convex_hull::best_face(const vec3f& direction) const -> std::uint32_t {
+	std::uint32_t best = 0;
+	float best_dot = -std::numeric_limits<float>::max();
+	for (std::uint32_t i = 0; i < m_faces.size(); ++i) {
+		if (const float d = dot(m_faces[i].normal, direction); d > best_dot) {
+			best_dot = d;
+			best = i;
+		}
+	}
+	return best;
+}
+
+auto gse::physics::convex_hull::face_vertices(const std::uint32_t face_index) const -> std::vector<vec3<length>> {
+	const auto& f = m_faces[face_index];
+	std::vector<vec3<length>> out;
+	out.reserve(f.count);
+	for (std::uint32_t i = f.first; i < f.first + f.count; ++i) {
+		out.push_back(m_vertices[m_face_indices[i]]);
+	}
+	return out;
+}
+
+auto gse::physics::convex_hull::raycast(const vec3<length>& origin, const vec3f& direction, const length max_distance) const -> std::optional<hull_hit> {
+	length t_enter = {};
+	length t_exit = max_distance;
+	const face* entered = nullptr;
+
+	for (const auto& f : m_faces) {
+		const float denom = dot(f.normal, direction);
+		const length dist = f.distance - dot(f.normal, origin);
+
+		if (std::abs(denom) < 1e-8f) {
+			if (dist < length{}) return std::nullopt;
+			continue;
+		}
+
+		const length t = dist / denom;
+		if (denom < 0.f) {
+			if (t > t_enter) {
+				t_enter = t;
+				entered = &f;
+			}
+		}
+		else {
+			t_exit = std::min(t_exit, t);
+		}
+
+		if (t_enter > t_exit) return std::nullopt;
+	}
+
+	return hull_hit{
+		.distance = t_enter,
+		.normal = entered ? entered->normal : -direction
+	};
+}
+
+auto gse::physics::convex_hull::vertices() const -> std::span<const vec3<length>> {
+	return m_vertices;
+}
+
+auto gse::physics::convex_hull::faces() const -> std::span<const face> {
+	return m_faces;
+}
+
+auto gse::physics::convex_hull::bounds() const -> const aabb& {
+	return m_bounds;
+}
+
+auto gse::physics::convex_hull::collider_size() const -> vec3<length> {
+	return symmetric_size(m_bounds);
+}
+
+auto gse::physics::convex_hull::simplification_error() const -> length {
+	return m_simplification_error;
+}
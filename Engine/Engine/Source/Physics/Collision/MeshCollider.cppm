@@ -0,0 +1,608 @@
+export module gse.physics:mesh_collider;
+
+import std;
+
+import gse.assert;
+import gse.math;
+
+import :bounding_box;
+import :broad_phase_collision;
+
+export namespace gse::physics {
+	struct collision_triangle {
+		std::array<vec3<length>, 3> vertices;
+		vec3f normal;
+		std::uint32_t index = 0;
+	};
+
+	struct triangle_hit {
+		length distance = {};
+		collision_triangle triangle;
+	};
+
+	class triangle_mesh {
+	public:
+		static auto create(
+			std::span<const vec3<length>> positions,
+			std::span<const std::uint32_t> indices
+		) -> std::shared_ptr<const triangle_mesh>;
+
+		static auto load(
+			const std::filesystem::path& baked_model_path
+		) -> std::shared_ptr<const triangle_mesh>;
+
+		template <typename Visit>
+		auto query(
+			const aabb& local_bounds,
+			Visit&& visit
+		) const -> void;
+
+		auto raycast(
+			const vec3<length>& origin,
+			const vec3f& direction,
+			length max_distance
+		) const -> std::optional<triangle_hit>;
+
+		auto bounds(
+		) const -> const aabb&;
+
+		auto collider_size(
+		) const -> vec3<length>;
+
+		auto triangle_count(
+		) const -> std::size_t;
+	private:
+		struct node {
+			aabb bounds;
+			std::uint32_t first = 0;
+			std::uint32_t count = 0;
+		};
+
+		static constexpr std::uint32_t leaf_size = 4;
+
+		auto build_node(
+			std::uint32_t begin,
+			std::uint32_t end
+		) -> std::uint32_t;
+
+		std::vector<collision_triangle> m_triangles;
+		std::vector<node> m_nodes;
+		aabb m_bounds;
+	};
+
+	class heightfield {
+	public:
+		static auto create(
+			std::uint32_t columns,
+			std::uint32_t rows,
+			length spacing,
+			std::vector<length> heights
+		) -> std::shared_ptr<const heightfield>;
+
+		template <typename Visit>
+		auto query(
+			const aabb& local_bounds,
+			Visit&& visit
+		) const -> void;
+
+		auto raycast(
+			const vec3<length>& origin,
+			const vec3f& direction,
+			length max_distance
+		) const -> std::optional<triangle_hit>;
+
+		auto bounds(
+		) const -> const aabb&;
+
+		auto collider_size(
+		) const -> vec3<length>;
+
+		auto triangle_count(
+		) const -> std::size_t;
+	private:
+		auto sample(
+			std::uint32_t column,
+			std::uint32_t row
+		) const -> vec3<length>;
+
+		auto cell_triangle(
+			std::uint32_t column,
+			std::uint32_t row,
+			std::uint32_t half
+		) const -> collision_triangle;
+
+		std::uint32_t m_columns = 0;
+		std::uint32_t m_rows = 0;
+		length m_spacing = {};
+		std::vector<length> m_heights;
+		aabb m_bounds;
+	};
+}
+
+namespace gse::physics {
+	auto to_meters(
+		const vec3<length>& v
+	) -> vec3f;
+
+	auto from_meters(
+		const vec3f& v
+	) -> vec3<length>;
+
+	auto ray_slab(
+		const vec3f& origin,
+		const vec3f& direction,
+		const vec3f& min,
+		const vec3f& max,
+		float max_t
+	) -> std::optional<std::pair<float, int>>;
+
+	auto ray_triangle(
+		const vec3f& origin,
+		const vec3f& direction,
+		const collision_triangle& triangle,
+		float max_t
+	) -> std::optional<float>;
+
+	auto make_triangle(
+		const vec3<length>& a,
+		const vec3<length>& b,
+		const vec3<length>& c,
+		std::uint32_t index
+	) -> std::optional<collision_triangle>;
+
+	auto triangle_bounds(
+		const collision_triangle& triangle
+	) -> aabb;
+
+	auto symmetric_size(
+		const aabb& bounds
+	) -> vec3<length>;
+
+	struct baked_vertex {
+		vec3<length> position;
+		vec3f normal;
+		vec2f tex_coords;
+	};
+
+	constexpr std::uint32_t baked_model_magic = 0x474D444C;
+
+	auto read_baked_positions(
+		const std::filesystem::path& baked_model_path
+	) -> std::vector<vec3<length>>;
+}
+
+auto gse::physics::to_meters(const vec3<length>& v) -> vec3f {
+	return { v.x().as<meters>(), v.y().as<meters>(), v.z().as<meters>() };
+}
+
+auto gse::physics::from_meters(const vec3f& v) -> vec3<length> {
+	return { v.x(), v.y(), v.z() };
+}
+
+auto gse::physics::ray_slab(const vec3f& origin, const vec3f& direction, const vec3f& min, const vec3f& max, const float max_t) -> std::optional<std::pair<float, int>> {
+	float t_enter = 0.f;
+	float t_exit = max_t;
+	int face = -1;
+
+	for (int i = 0; i < 3; ++i) {
+		if (std::abs(direction[i]) < 1e-8f) {
+			if (origin[i] < min[i] || origin[i] > max[i]) return std::nullopt;
+			continue;
+		}
+
+		const float inv = 1.f / direction[i];
+		float t0 = (min[i] - origin[i]) * inv;
+		float t1 = (max[i] - origin[i]) * inv;
+		int f = i * 2 + 1;
+		if (t0 > t1) {
+			std::swap(t0, t1);
+			f = i * 2;
+		}
+
+		if (t0 > t_enter) {
+			t_enter = t0;
+			face = f;
+		}
+		t_exit = std::min(t_exit, t1);
+
+		if (t_enter > t_exit) return std::nullopt;
+	}
+
+	return std::pair{ t_enter, face };
+}
+
+auto gse::physics::ray_triangle(const vec3f& origin, const vec3f& direction, const collision_triangle& triangle, const float max_t) -> std::optional<float> {
+	const vec3f v0 = to_meters(triangle.vertices[0]);
+	const vec3f e1 = to_meters(triangle.vertices[1]) - v0;
+	const vec3f e2 = to_meters(triangle.vertices[2]) - v0;
+
+	const vec3f p = cross(direction, e2);
+	const float det = dot(e1, p);
+	if (std::abs(det) < 1e-10f) return std::nullopt;
+
+	const float inv_det = 1.f / det;
+	const vec3f s = origin - v0;
+	const float u = dot(s, p) * inv_det;
+	if (u < 0.f || u > 1.f) return std::nullopt;
+
+	const vec3f q = cross(s, e1);
+	const float v = dot(direction, q) * inv_det;
+	if (v < 0.f || u + v > 1.f) return std::nullopt;
+
+	const float t = dot(e2, q) * inv_det;
+	if (t < 0.f || t > max_t) return std::nullopt;
+
+	return t;
+}
+
+auto gse::physics::make_triangle(const vec3<length>& a, const vec3<length>& b, const vec3<length>& c, const std::uint32_t index) -> std::optional<collision_triangle> {
+	const auto n = cross(b - a, c - a);
+	if (magnitude(n) < meters(1e-5f) * meters(1e-5f)) {
+		return std::nullopt;
+	}
+
+	return collision_triangle{
+		.vertices = { a, b, c },
+		.normal = normalize(n),
+		.index = index
+	};
+}
+
+auto gse::physics::triangle_bounds(const collision_triangle& triangle) -> aabb {
+	const auto& [a, b, c] = triangle.vertices;
+	return {
+		.max = max(max(a, b), c),
+		.min = min(min(a, b), c)
+	};
+}
+
+auto gse::physics::symmetric_size(const aabb& bounds) -> vec3<length> {
+	return max(abs(bounds.min), abs(bounds.max)) * 2.f;
+}
+
+auto gse::physics::read_baked_positions(const std::filesystem::path& baked_model_path) -> std::vector<vec3<length>> {
+	std::ifstream in_file(baked_model_path, std::ios::binary);
+	assert(in_file.is_open(), std::source_location::current(), "Failed to open baked model file for collision shape.");
+
+	std::uint32_t magic, version;
+	in_file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	in_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	assert(magic == baked_model_magic, std::source_location::current(), "Baked model file has an invalid header.");
+
+	std::uint64_t mesh_count;
+	in_file.read(reinterpret_cast<char*>(&mesh_count), sizeof(mesh_count));
+
+	std::vector<vec3<length>> positions;
+	for (std::uint64_t i = 0; i < mesh_count; ++i) {
+		std::uint64_t mat_name_len;
+		in_file.read(reinterpret_cast<char*>(&mat_name_len), sizeof(mat_name_len));
+		in_file.seekg(static_cast<std::streamoff>(mat_name_len), std::ios::cur);
+
+		std::uint64_t vertex_count;
+		in_file.read(reinterpret_cast<char*>(&vertex_count), sizeof(vertex_count));
+		std::vector<baked_vertex> vertices(vertex_count);
+		in_file.read(reinterpret_cast<char*>(vertices.data()), vertex_count * sizeof(baked_vertex));
+
+		positions.reserve(positions.size() + vertices.size());
+		for (const auto& v : vertices) {
+			positions.push_back(v.position);
+		}
+	}
+
+	return positions;
+}
+
+auto gse::physics::triangle_mesh::create(const std::span<const vec3<length>> positions, const std::span<const std::uint32_t> indices) -> std::shared_ptr<const triangle_mesh> {
+	auto mesh = std::make_shared<triangle_mesh>();
+	mesh->m_triangles.reserve(indices.size() / 3);
+
+	for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+		if (indices[i] >= positions.size() || indices[i + 1] >= positions.size() || indices[i + 2] >= positions.size()) continue;
+
+		if (auto triangle = make_triangle(positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]], static_cast<std::uint32_t>(i / 3))) {
+			mesh->m_triangles.push_back(*triangle);
+		}
+	}
+
+	if (!mesh->m_triangles.empty()) {
+		mesh->m_nodes.reserve(mesh->m_triangles.size() / leaf_size * 2 + 1);
+		mesh->build_node(0, static_cast<std::uint32_t>(mesh->m_triangles.size()));
+		mesh->m_bounds = mesh->m_nodes.front().bounds;
+	}
+
+	return mesh;
+}
+
+auto gse::physics::triangle_mesh::load(const std::filesystem::path& baked_model_path) -> std::shared_ptr<const triangle_mesh> {
+	const auto positions = read_baked_positions(baked_model_path);
+
+	std::vector<std::uint32_t> indices(positions.size());
+	std::iota(indices.begin(), indices.end(), 0u);
+
+	return create(positions, indices);
+}
+
+template <typename Visit>
+auto gse::physics::triangle_mesh::query(const aabb& local_bounds, Visit&& visit) const -> void {
+	if (m_nodes.empty()) return;
+
+	std::array<std::uint32_t, 64> stack;
+	std::size_t top = 0;
+	stack[top++] = 0;
+
+	while (top > 0) {
+		const auto index = stack[--top];
+		const auto& n = m_nodes[index];
+
+		if (!n.bounds.overlaps(local_bounds)) continue;
+
+		if (n.count > 0) {
+			for (std::uint32_t i = n.first; i < n.first + n.count; ++i) {
+				if (triangle_bounds(m_triangles[i]).overlaps(local_bounds)) {
+					visit(m_triangles[i]);
+				}
+			}
+			continue;
+		}
+
+		stack[top++] = n.first;
+		stack[top++] = index + 1;
+	}
+}
+
+auto gse::physics::triangle_mesh::raycast(const vec3<length>& origin, const vec3f& direction, const length max_distance) const -> std::optional<triangle_hit> {
+	if (m_nodes.empty()) return std::nullopt;
+
+	const vec3f o = to_meters(origin);
+	float best = max_distance.as<meters>();
+	const collision_triangle* best_triangle = nullptr;
+
+	std::array<std::uint32_t, 64> stack;
+	std::size_t top = 0;
+	stack[top++] = 0;
+
+	while (top > 0) {
+		const auto index = stack[--top];
+		const auto& n = m_nodes[index];
+
+		if (!ray_slab(o, direction, to_meters(n.bounds.min), to_meters(n.bounds.max), best)) continue;
+
+		if (n.count > 0) {
+			for (std::uint32_t i = n.first; i < n.first + n.count; ++i) {
+				if (const auto t = ray_triangle(o, direction, m_triangles[i], best)) {
+					best = *t;
+					best_triangle = &m_triangles[i];
+				}
+			}
+			continue;
+		}
+
+		stack[top++] = n.first;
+		stack[top++] = index + 1;
+	}
+
+	if (!best_triangle) return std::nullopt;
+
+	return triangle_hit{
+		.distance = meters(best),
+		.triangle = *best_triangle
+	};
+}
+
+auto gse::physics::triangle_mesh::bounds() const -> const aabb& {
+	return m_bounds;
+}
+
+auto gse::physics::triangle_mesh::collider_size() const -> vec3<length> {
+	return symmetric_size(m_bounds);
+}
+
+auto gse::physics::triangle_mesh::triangle_count() const -> std::size_t {
+	return m_triangles.size();
+}
+
+auto gse::physics::triangle_mesh::build_node(const std::uint32_t begin, const std::uint32_t end) -> std::uint32_t {
+	const auto index = static_cast<std::uint32_t>(m_nodes.size());
+	m_nodes.emplace_back();
+
+	const auto centroid = [](const collision_triangle& t) {
+		return (t.vertices[0] + t.vertices[1] + t.vertices[2]) / 3.f;
+	};
+
+	aabb bounds = triangle_bounds(m_triangles[begin]);
+	vec3<length> centroid_min = centroid(m_triangles[begin]);
+	vec3<length> centroid_max = centroid_min;
+
+	for (std::uint32_t i = begin + 1; i < end; ++i) {
+		bounds = merge(bounds, triangle_bounds(m_triangles[i]));
+		const auto c = centroid(m_triangles[i]);
+		centroid_min = min(centroid_min, c);
+		centroid_max = max(centroid_max, c);
+	}
+
+	if (end - begin <= leaf_size) {
+		m_nodes[index] = {
+			.bounds = bounds,
+			.first = begin,
+			.count = end - begin
+		};
+		return index;
+	}
+
+	const auto extent = centroid_max - centroid_min;
+	int axis = extent.x() > extent.y() ? 0 : 1;
+	if (extent.z() > extent[axis]) {
+		axis = 2;
+	}
+
+	const auto mid = begin + (end - begin) / 2;
+	std::nth_element(m_triangles.begin() + begin, m_triangles.begin() + mid, m_triangles.begin() + end, [axis](const collision_triangle& a, const collision_triangle& b) {
+		return a.vertices[0][axis] + a.vertices[1][axis] + a.vertices[2][axis] < b.vertices[0][axis] + b.vertices[1][axis] + b.vertices[2][axis];
+	});
+
+	build_node(begin, mid);
+	const auto right = build_node(mid, end);
+
+	m_nodes[index] = {
+		.bounds = bounds,
+		.first = right,
+		.count = 0
+	};
+	return index;
+}
+
+auto gse::physics::heightfield::create(const std::uint32_t columns, const std::uint32_t rows, const length spacing, std::vector<length> heights) -> std::shared_ptr<const heightfield> {
+	assert(columns >= 2 && rows >= 2, std::source_location::current(), "Heightfield needs at least 2x2 samples.");
+	assert(heights.size() == static_cast<std::size_t>(columns) * rows, std::source_location::current(), "Heightfield sample count does not match its dimensions.");
+
+	auto field = std::make_shared<heightfield>();
+	field->m_columns = columns;
+	field->m_rows = rows;
+	field->m_spacing = spacing;
+	field->m_heights = std::move(heights);
+
+	const auto [lowest, highest] = std::ranges::minmax(field->m_heights);
+	field->m_bounds = {
+		.max = field->sample(columns - 1, rows - 1),
+		.min = field->sample(0, 0)
+	};
+	field->m_bounds.min.y() = lowest;
+	field->m_bounds.max.y() = highest;
+
+	return field;
+}
+
+template <typename Visit>
+auto gse::physics::heightfield::query(const aabb& local_bounds, Visit&& visit) const -> void {
+	if (!m_bounds.overlaps(local_bounds)) return;
+
+	const auto cell = [&](const length coordinate, const length origin, const std::uint32_t cells) {
+		const float f = ((coordinate - origin) / m_spacing);
+		return static_cast<std::uint32_t>(std::clamp(f, 0.f, static_cast<float>(cells - 1)));
+	};
+
+	const auto column_begin = cell(local_bounds.min.x(), m_bounds.min.x(), m_columns - 1);
+	const auto column_end = cell(local_bounds.max.x(), m_bounds.min.x(), m_columns - 1);
+	const auto row_begin = cell(local_bounds.min.z(), m_bounds.min.z(), m_rows - 1);
+	const auto row_end = cell(local_bounds.max.z(), m_bounds.min.z(), m_rows - 1);
+
+	for (auto row = row_begin; row <= row_end; ++row) {
+		for (auto column = column_begin; column <= column_end; ++column) {
+			const auto [low, high] = std::minmax({
+				m_heights[row * m_columns + column],
+				m_heights[row * m_columns + column + 1],
+				m_heights[(row + 1) * m_columns + column],
+				m_heights[(row + 1) * m_columns + column + 1]
+			});
+
+			if (high < local_bounds.min.y() || low > local_bounds.max.y()) continue;
+
+			for (std::uint32_t half = 0; half < 2; ++half) {
+				visit(cell_triangle(column, row, half));
+			}
+		}
+	}
+}
+
+auto gse::physics::heightfield::raycast(const vec3<length>& origin, const vec3f& direction, const length max_distance) const -> std::optional<triangle_hit> {
+	const vec3f o = to_meters(origin);
+	const auto clipped = ray_slab(o, direction, to_meters(m_bounds.min), to_meters(m_bounds.max), max_distance.as<meters>());
+	if (!clipped) return std::nullopt;
+
+	const float spacing = m_spacing.as<meters>();
+	const vec3f grid_origin = to_meters(m_bounds.min);
+	const float t_exit = [&] {
+		float t = max_distance.as<meters>();
+		for (const int i : { 0, 1, 2 }) {
+			if (std::abs(direction[i]) < 1e-8f) continue;
+			const float bound = direction[i] > 0.f ? to_meters(m_bounds.max)[i] : grid_origin[i];
+			t = std::min(t, (bound - o[i]) / direction[i]);
+		}
+		return t;
+	}();
+
+	float t = clipped->first;
+	const vec3f entry = o + direction * t;
+
+	struct axis_walk {
+		std::int64_t cell = 0;
+		std::int64_t step = 0;
+		float next = std::numeric_limits<float>::max();
+		float delta = std::numeric_limits<float>::max();
+	};
+
+	const auto walk = [&](const int axis, const std::uint32_t samples) {
+		axis_walk w{
+			.cell = std::clamp(static_cast<std::int64_t>((entry[axis] - grid_origin[axis]) / spacing), std::int64_t{ 0 }, static_cast<std::int64_t>(samples) - 2)
+		};
+		if (std::abs(direction[axis]) >= 1e-8f) {
+			w.step = direction[axis] > 0.f ? 1 : -1;
+			const float boundary = grid_origin[axis] + static_cast<float>(w.cell + (w.step > 0 ? 1 : 0)) * spacing;
+			w.next = (boundary - o[axis]) / direction[axis];
+			w.delta = spacing / std::abs(direction[axis]);
+		}
+		return w;
+	};
+
+	auto column = walk(0, m_columns);
+	auto row = walk(2, m_rows);
+
+	while (t <= t_exit) {
+		std::optional<triangle_hit> best;
+		for (std::uint32_t half = 0; half < 2; ++half) {
+			const auto triangle = cell_triangle(static_cast<std::uint32_t>(column.cell), static_cast<std::uint32_t>(row.cell), half);
+			const float limit = best ? best->distance.as<meters>() : max_distance.as<meters>();
+			if (const auto hit = ray_triangle(o, direction, triangle, limit)) {
+				best = triangle_hit{ .distance = meters(*hit), .triangle = triangle };
+			}
+		}
+		if (best) return best;
+
+		auto& next = column.next < row.next ? column : row;
+		next.cell += next.step;
+		t = next.next;
+		next.next += next.delta;
+
+		if (column.cell < 0 || row.cell < 0 || column.cell >= m_columns - 1 || row.cell >= m_rows - 1) break;
+	}
+
+	return std::nullopt;
+}
+
+auto gse::physics::heightfield::bounds() const -> const aabb& {
+	return m_bounds;
+}
+
+auto gse::physics::heightfield::collider_size() const -> vec3<length> {
+	return symmetric_size(m_bounds);
+}
+
+auto gse::physics::heightfield::triangle_count() const -> std::size_t {
+	return static_cast<std::size_t>(m_columns - 1) * (m_rows - 1) * 2;
+}
+
+auto gse::physics::heightfield::sample(const std::uint32_t column, const std::uint32_t row) const -> vec3<length> {
+	return {
+		m_spacing * (static_cast<float>(column) - static_cast<float>(m_columns - 1) * 0.5f),
+		m_heights[row * m_columns + column],
+		m_spacing * (static_cast<float>(row) - static_cast<float>(m_rows - 1) * 0.5f)
+	};
+}
+
+auto gse::physics::heightfield::cell_triangle(const std::uint32_t column, const std::uint32_t row, const std::uint32_t half) const -> collision_triangle {
+	const auto p00 = sample(column, row);
+	const auto p10 = sample(column + 1, row);
+	const auto p01 = sample(column, row + 1);
+	const auto p11 = sample(column + 1, row + 1);
+
+	const auto index = (row * (m_columns - 1) + column) * 2 + half;
+	const auto triangle = half == 0
+		? make_triangle(p00, p01, p11, index)
+		: make_triangle(p00, p11, p10, index);
+
+	return triangle.value_or(collision_triangle{
+		.vertices = { p00, p01, p11 },
+		.normal = { 0.f, 1.f, 0.f },
+		.index = index
+	});
+}
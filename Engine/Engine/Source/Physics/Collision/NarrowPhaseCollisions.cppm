@@ -5,6 +5,8 @@ import std;
 import :bounding_box;
 import :collision_component;
 import :contact_manifold;
+import :convex_hull;
+import :mesh_collider;
 
 import gse.math;
 import gse.utility;
@@ -21,8 +23,15 @@ export namespace gse::narrow_phase_collision {
 		physics::shape_type type = physics::shape_type::box;
 		length radius = {};
 		length half_height = {};
+		const physics::convex_hull* hull = nullptr;
+		const physics::triangle_mesh* mesh = nullptr;
+		const physics::heightfield* field = nullptr;
 	};
 
+	auto shape_of(
+		const physics::collision_component_data& collision
+	) -> shape_data;
+
 	auto sat_speculative(
 		const bounding_box& bb1,
 		const bounding_box& bb2,
@@ -211,6 +220,118 @@ namespace gse::narrow_phase_collision {
 	auto capsule_capsule_manifold(const bounding_box& bb_a, length ha, length ra, const bounding_box& bb_b, length hb, length rb, const vec3f& normal, length separation) -> contact_manifold;
 	auto box_capsule_manifold(const bounding_box& bb, const bounding_box& cap_bb, length cap_h, length cap_r, const vec3f& normal, length separation) -> contact_manifold;
 	auto sphere_capsule_manifold(const vec3<length>& sph_center, length sph_r, const bounding_box& cap_bb, length cap_h, length cap_r, const vec3f& normal, length separation) -> contact_manifold;
+
+	constexpr length mesh_contact_band = meters(0.02f);
+	constexpr float mesh_normal_cluster = 0.9f;
+
+	struct contact_candidate {
+		vec3<length> on_a;
+		vec3<length> on_b;
+		vec3f normal;
+		length separation;
+		feature_id feature;
+	};
+
+	auto to_world(const bounding_box& mesh_bb, const physics::collision_triangle& local) -> physics::collision_triangle;
+	auto to_mesh_local(const bounding_box& mesh_bb, const aabb& world, length margin) -> aabb;
+	auto closest_point_on_triangle(const vec3<length>& p, const physics::collision_triangle& tri) -> vec3<length>;
+	auto projects_inside_triangle(const vec3<length>& p, const physics::collision_triangle& tri) -> bool;
+	auto mesh_feature(const physics::collision_triangle& tri, feature_type convex_type, std::uint8_t convex_index, std::uint8_t convex_side, feature_type mesh_type) -> feature_id;
+
+	auto sphere_contact_candidates(const vec3<length>& center, length radius, const physics::collision_triangle& tri, length margin, std::vector<contact_candidate>& out) -> void;
+	auto capsule_contact_candidates(const bounding_box& cap_bb, length half_h, length radius, const physics::collision_triangle& tri, length margin, std::vector<contact_candidate>& out) -> void;
+	auto box_contact_candidates(const bounding_box& bb, const physics::collision_triangle& tri, length margin, std::vector<contact_candidate>& out) -> void;
+
+	auto collect_mesh_contacts(const shape_data& convex, const shape_data& mesh, length margin) -> std::vector<contact_candidate>;
+	auto reduce_contacts(std::vector<contact_candidate>& contacts, const vec3f& normal) -> void;
+
+	auto mesh_speculative(const shape_data& convex, const shape_data& mesh, length margin) -> std::optional<sat_result>;
+	auto mesh_manifold(const shape_data& convex, const shape_data& mesh, const vec3f& normal, length separation) -> contact_manifold;
+
+	constexpr int gjk_max_iterations = 32;
+	constexpr int epa_max_iterations = 64;
+	constexpr float convex_tolerance = 1e-4f;
+	constexpr float convex_face_alignment = 0.85f;
+
+	struct convex_support {
+		physics::shape_type type = physics::shape_type::box;
+		vec3f center;
+		quat orientation;
+		std::array<vec3f, 3> axes;
+		vec3f half_extents;
+		float radius = 0.f;
+		float half_height = 0.f;
+		const physics::convex_hull* hull = nullptr;
+		std::array<vec3f, 3> triangle;
+
+		auto operator()(const vec3f& direction) const -> vec3f;
+	};
+
+	struct support_point {
+		vec3f w;
+		vec3f a;
+		vec3f b;
+	};
+
+	struct gjk_simplex {
+		std::array<support_point, 4> points;
+		std::array<float, 4> weights = {};
+		std::uint32_t count = 0;
+	};
+
+	struct epa_result {
+		vec3f normal;
+		float depth = 0.f;
+		vec3f point_a;
+		vec3f point_b;
+	};
+
+	struct convex_result {
+		vec3f normal;
+		length separation;
+		vec3<length> point_a;
+		vec3<length> point_b;
+	};
+
+	struct polygon_face {
+		std::uint8_t index = 0;
+		vec3f normal;
+		std::vector<vec3<length>> vertices;
+	};
+
+	auto make_support(const shape_data& shape) -> convex_support;
+	auto make_support(const physics::collision_triangle& tri) -> convex_support;
+	auto minkowski_support(const convex_support& sa, const convex_support& sb, const vec3f& direction) -> support_point;
+
+	auto triangle_barycentric(const vec3f& p, const vec3f& a, const vec3f& b, const vec3f& c) -> vec3f;
+	auto reduce_simplex(gjk_simplex& simplex) -> bool;
+	auto simplex_points(const gjk_simplex& simplex) -> std::pair<vec3f, vec3f>;
+	auto gjk_distance(const convex_support& sa, const convex_support& sb, float max_distance, gjk_simplex& simplex) -> std::optional<vec3f>;
+	auto epa_penetration(const convex_support& sa, const convex_support& sb, const gjk_simplex& simplex) -> std::optional<epa_result>;
+	auto convex_query(const convex_support& sa, const convex_support& sb, length margin) -> std::optional<convex_result>;
+
+	auto is_polyhedral(physics::shape_type type) -> bool;
+	auto support_feature(const shape_data& shape, const vec3<length>& point, const vec3f& direction) -> std::pair<feature_type, std::uint8_t>;
+	auto polyhedral_face(const shape_data& shape, const vec3f& direction) -> polygon_face;
+	auto clip_faces(const polygon_face& reference, const polygon_face& incident, bool reference_is_a) -> clipped_face_contacts;
+	auto polyhedral_contacts(const shape_data& a, const shape_data& b, const vec3f& normal, length band, std::vector<contact_candidate>& out) -> void;
+	auto capsule_face_contacts(const shape_data& capsule, const shape_data& polyhedron, const vec3f& normal, bool capsule_is_a, length band, std::vector<contact_candidate>& out) -> void;
+	auto hull_triangle_contacts(const shape_data& hull, const physics::collision_triangle& tri, length margin, std::vector<contact_candidate>& out) -> void;
+
+	auto convex_speculative(const shape_data& a, const shape_data& b, length margin) -> std::optional<sat_result>;
+	auto convex_manifold(const shape_data& a, const shape_data& b, const vec3f& normal, length separation) -> contact_manifold;
+}
+
+auto gse::narrow_phase_collision::shape_of(const physics::collision_component_data& collision) -> shape_data {
+	return {
+		.bb = &collision.bounding_box,
+		.type = collision.shape,
+		.radius = collision.shape_radius,
+		.half_height = collision.shape_half_height,
+		.hull = collision.hull.get(),
+		.mesh = collision.mesh.get(),
+		.field = collision.field.get()
+	};
 }
 
 auto gse::narrow_phase_collision::support_obb(const bounding_box& bb, const vec3f& dir) -> vec3<length> {
@@ -1313,28 +1434,1114 @@ auto gse::narrow_phase_collision::sphere_capsule_manifold(
 	return manifold;
 }
 
+auto gse::narrow_phase_collision::to_world(const bounding_box& mesh_bb, const physics::collision_triangle& local) -> physics::collision_triangle {
+	const auto orientation = mesh_bb.obb().orientation;
+	const auto center = mesh_bb.center();
+
+	return {
+		.vertices = {
+			center + rotate_vector(orientation, local.vertices[0]),
+			center + rotate_vector(orientation, local.vertices[1]),
+			center + rotate_vector(orientation, local.vertices[2])
+		},
+		.normal = rotate_vector(orientation, local.normal),
+		.index = local.index
+	};
+}
+
+auto gse::narrow_phase_collision::to_mesh_local(const bounding_box& mesh_bb, const aabb& world, const length margin) -> aabb {
+	const auto orientation = mesh_bb.obb().orientation;
+	const auto center = mesh_bb.center();
+	const vec3<length> pad(margin, margin, margin);
+	const auto lo = world.min - pad;
+	const auto hi = world.max + pad;
+
+	constexpr float lowest = std::numeric_limits<float>::lowest();
+	constexpr float highest = std::numeric_limits<float>::max();
+	aabb local{
+		.max = vec3<length>(lowest, lowest, lowest),
+		.min = vec3<length>(highest, highest, highest)
+	};
+
+	for (int i = 0; i < 8; ++i) {
+		const vec3<length> corner(
+			i & 1 ? hi.x() : lo.x(),
+			i & 2 ? hi.y() : lo.y(),
+			i & 4 ? hi.z() : lo.z()
+		);
+		const auto p = inverse_rotate_vector(orientation, corner - center);
+		local.min = min(local.min, p);
+		local.max = max(local.max, p);
+	}
+
+	return local;
+}
+
+auto gse::narrow_phase_collision::closest_point_on_triangle(const vec3<length>& p, const physics::collision_triangle& tri) -> vec3<length> {
+	const vec3f a = physics::to_meters(tri.vertices[0]);
+	const vec3f b = physics::to_meters(tri.vertices[1]);
+	const vec3f c = physics::to_meters(tri.vertices[2]);
+	const vec3f weights = triangle_barycentric(physics::to_meters(p), a, b, c);
+
+	return physics::from_meters(a * weights.x() + b * weights.y() + c * weights.z());
+}
+
+auto gse::narrow_phase_collision::projects_inside_triangle(const vec3<length>& p, const physics::collision_triangle& tri) -> bool {
+	constexpr float tolerance = -1e-6f;
+	const vec3f q = physics::to_meters(p);
+	for (std::size_t i = 0; i < 3; ++i) {
+		const vec3f v0 = physics::to_meters(tri.vertices[i]);
+		const vec3f v1 = physics::to_meters(tri.vertices[(i + 1) % 3]);
+		if (dot(cross(v1 - v0, q - v0), tri.normal) < tolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+auto gse::narrow_phase_collision::mesh_feature(const physics::collision_triangle& tri, const feature_type convex_type, const std::uint8_t convex_index, const std::uint8_t convex_side, const feature_type mesh_type) -> feature_id {
+	return feature_id{
+		.type_a = convex_type,
+		.type_b = mesh_type,
+		.index_a = convex_index,
+		.index_b = static_cast<std::uint8_t>(tri.index & 0xFF),
+		.side_a0 = convex_side,
+		.side_b0 = static_cast<std::uint8_t>((tri.index >> 8) & 0xFF),
+		.side_b1 = static_cast<std::uint8_t>((tri.index >> 16) & 0xFF)
+	};
+}
+
+auto gse::narrow_phase_collision::sphere_contact_candidates(const vec3<length>& center, const length radius, const physics::collision_triangle& tri, const length margin, std::vector<contact_candidate>& out) -> void {
+	if (dot(tri.normal, center - tri.vertices[0]) < length{}) return;
+
+	const auto closest = closest_point_on_triangle(center, tri);
+	const auto diff = center - closest;
+	const auto dist = magnitude(diff);
+	const length separation = radius - dist;
+
+	if (separation < -margin) return;
+
+	const vec3f normal = dist > meters(1e-6f) ? normalize(diff) : tri.normal;
+
+	out.push_back({
+		.on_a = center - normal * radius,
+		.on_b = closest,
+		.normal = normal,
+		.separation = separation,
+		.feature = mesh_feature(tri, feature_type::face, sphere_surface_index, feature_side_none, feature_type::face)
+	});
+}
+
+auto gse::narrow_phase_collision::capsule_contact_candidates(const bounding_box& cap_bb, const length half_h, const length radius, const physics::collision_triangle& tri, const length margin, std::vector<contact_candidate>& out) -> void {
+	const auto& n = tri.normal;
+	const auto& v0 = tri.vertices[0];
+	if (dot(n, cap_bb.center() - v0) < length{}) return;
+
+	const auto [p0, p1] = capsule_endpoints(cap_bb, half_h);
+	const std::array endpoints = { p0, p1 };
+	const std::array gaps = { dot(n, p0 - v0), dot(n, p1 - v0) };
+
+	const auto add_face_contact = [&](const std::size_t k) {
+		const auto [type, index] = classify_capsule_feature(static_cast<float>(k));
+		out.push_back({
+			.on_a = endpoints[k] - n * radius,
+			.on_b = endpoints[k] - n * gaps[k],
+			.normal = n,
+			.separation = radius - gaps[k],
+			.feature = mesh_feature(tri, type, index, feature_side_none, feature_type::face)
+		});
+	};
+
+	bool added = false;
+	for (std::size_t k = 0; k < 2; ++k) {
+		if (radius - gaps[k] >= -margin && projects_inside_triangle(endpoints[k], tri)) {
+			add_face_contact(k);
+			added = true;
+		}
+	}
+	if (added) return;
+
+	if ((gaps[0] < length{}) != (gaps[1] < length{})) {
+		const float t = gaps[0] / (gaps[0] - gaps[1]);
+		if (projects_inside_triangle(p0 + (p1 - p0) * t, tri)) {
+			add_face_contact(gaps[0] < gaps[1] ? 0 : 1);
+			return;
+		}
+	}
+
+	vec3<length> best_segment = p0;
+	vec3<length> best_triangle = closest_point_on_triangle(p0, tri);
+	float best_t = 0.f;
+
+	const auto consider = [&](const vec3<length>& on_segment, const vec3<length>& on_triangle, const float t) {
+		if (magnitude(on_segment - on_triangle) < magnitude(best_segment - best_triangle)) {
+			best_segment = on_segment;
+			best_triangle = on_triangle;
+			best_t = t;
+		}
+	};
+
+	consider(p1, closest_point_on_triangle(p1, tri), 1.f);
+	for (std::size_t i = 0; i < 3; ++i) {
+		const auto& e0 = tri.vertices[i];
+		const auto& e1 = tri.vertices[(i + 1) % 3];
+		const auto [s, t] = segment_segment_closest_params(p0, p1, e0, e1);
+		consider(p0 + (p1 - p0) * s, e0 + (e1 - e0) * t, s);
+	}
+
+	const auto diff = best_segment - best_triangle;
+	const auto dist = magnitude(diff);
+	const length separation = radius - dist;
+	if (separation < -margin) return;
+
+	const vec3f normal = dist > meters(1e-6f) ? normalize(diff) : n;
+	const auto [type, index] = classify_capsule_feature(best_t);
+
+	out.push_back({
+		.on_a = best_segment - normal * radius,
+		.on_b = best_triangle,
+		.normal = normal,
+		.separation = separation,
+		.feature = mesh_feature(tri, type, index, feature_side_none, feature_type::edge)
+	});
+}
+
+auto gse::narrow_phase_collision::box_contact_candidates(const bounding_box& bb, const physics::collision_triangle& tri, const length margin, std::vector<contact_candidate>& out) -> void {
+	const auto& n_t = tri.normal;
+	const auto& [v0, v1, v2] = tri.vertices;
+	const auto center = bb.center();
+	if (dot(n_t, center - v0) < length{}) return;
+
+	const auto o = bb.obb();
+	const auto he = bb.half_extents();
+	const auto centroid = (v0 + v1 + v2) / 3.f;
+	const std::array edges = { v1 - v0, v2 - v1, v0 - v2 };
+
+	sat_axis_choice best_axis;
+	sat_axis_choice best_face_axis;
+
+	auto test_axis = [&](vec3f axis, const sat_axis_source source, const float extent_scale) {
+		if (is_zero(axis, 1e-6f)) return true;
+		axis = normalize(axis);
+		if (dot(axis, center - centroid) < length{}) {
+			axis = -axis;
+		}
+
+		length r = meters(0.f);
+		for (int i = 0; i < 3; ++i) {
+			r += abs(dot(axis, o.axes[i]) * he[i]);
+		}
+
+		const length triangle_max = std::max({ dot(axis, v0), dot(axis, v1), dot(axis, v2) });
+		const length overlap = triangle_max - (dot(axis, center) - r);
+
+		if (overlap < -margin) {
+			return false;
+		}
+
+		if (dot(axis, n_t) >= -1e-3f) {
+			update_sat_choice(best_axis, axis, overlap, source, extent_scale);
+			if (source == sat_axis_source::face) {
+				update_sat_choice(best_face_axis, axis, overlap, source, extent_scale);
+			}
+		}
+		return true;
+	};
+
+	const float box_scale = std::max({ he[0].as<meters>(), he[1].as<meters>(), he[2].as<meters>() });
+	if (!test_axis(n_t, sat_axis_source::face, box_scale)) return;
+	for (int i = 0; i < 3; ++i) {
+		if (!test_axis(o.axes[i], sat_axis_source::face, he[i].as<meters>())) return;
+	}
+	for (int i = 0; i < 3; ++i) {
+		for (const auto& edge : edges) {
+			if (!test_axis(cross(o.axes[i], normalize(edge)), sat_axis_source::cross, 0.f)) return;
+		}
+	}
+
+	best_axis = prefer_face_sat_axis(best_axis, best_face_axis);
+	if (!best_axis.valid) return;
+
+	const auto& n = best_axis.axis;
+	const length band = std::max(-best_axis.overlap, length{}) + mesh_contact_band;
+	const auto first = out.size();
+
+	const auto corners = bb.obb_vertices();
+	for (std::uint8_t k = 0; k < corners.size(); ++k) {
+		const length gap = dot(n_t, corners[k] - v0);
+		if (gap > band || !projects_inside_triangle(corners[k], tri)) continue;
+
+		out.push_back({
+			.on_a = corners[k],
+			.on_b = corners[k] - n_t * gap,
+			.normal = n,
+			.separation = -gap,
+			.feature = mesh_feature(tri, feature_type::vertex, k, feature_side_none, feature_type::face)
+		});
+	}
+
+	const auto face = classify_box_face(bb, -n);
+	const auto face_normal = bb.face_normals()[face];
+	if (dot(face_normal, -n) > 0.95f) {
+		const int axis_idx = face / 2;
+		const int u_axis = (axis_idx + 1) % 3;
+		const int v_axis = (axis_idx + 2) % 3;
+
+		for (std::uint8_t k = 0; k < 3; ++k) {
+			const auto local = tri.vertices[k] - center;
+			if (abs(dot(o.axes[u_axis], local)) > he[u_axis] || abs(dot(o.axes[v_axis], local)) > he[v_axis]) continue;
+
+			const length gap = dot(face_normal, local) - he[axis_idx];
+			if (gap > band) continue;
+
+			out.push_back({
+				.on_a = tri.vertices[k] - face_normal * gap,
+				.on_b = tri.vertices[k],
+				.normal = n,
+				.separation = -gap,
+				.feature = mesh_feature(tri, feature_type::face, face, k, feature_type::vertex)
+			});
+		}
+	}
+
+	if (out.size() == first) {
+		const auto on_a = support_obb(bb, -n);
+		out.push_back({
+			.on_a = on_a,
+			.on_b = closest_point_on_triangle(on_a, tri),
+			.normal = n,
+			.separation = best_axis.overlap,
+			.feature = mesh_feature(tri, feature_type::edge, face, feature_side_none, feature_type::edge)
+		});
+	}
+}
+
+auto gse::narrow_phase_collision::collect_mesh_contacts(const shape_data& convex, const shape_data& mesh, const length margin) -> std::vector<contact_candidate> {
+	std::vector<contact_candidate> contacts;
+	const auto& mesh_bb = *mesh.bb;
+	const auto local_bounds = to_mesh_local(mesh_bb, convex.bb->aabb(), margin);
+
+	const auto visit = [&](const physics::collision_triangle& local) {
+		const auto tri = to_world(mesh_bb, local);
+		switch (convex.type) {
+			case physics::shape_type::sphere:
+				sphere_contact_candidates(convex.bb->center(), convex.radius, tri, margin, contacts);
+				break;
+			case physics::shape_type::capsule:
+				capsule_contact_candidates(*convex.bb, convex.half_height, convex.radius, tri, margin, contacts);
+				break;
+			default:
+				box_contact_candidates(*convex.bb, tri, margin, contacts);
+				break;
+		}
+	};
+
+	if (mesh.mesh) {
+		mesh.mesh->query(local_bounds, visit);
+	}
+	else if (mesh.field) {
+		mesh.field->query(local_bounds, visit);
+	}
+
+	return contacts;
+}
+
+auto gse::narrow_phase_collision::reduce_contacts(std::vector<contact_candidate>& contacts, const vec3f& normal) -> void {
+	std::ranges::sort(contacts, std::greater{}, &contact_candidate::separation);
+
+	std::vector<contact_candidate> unique;
+	unique.reserve(contacts.size());
+	for (const auto& c : contacts) {
+		if (std::ranges::none_of(unique, [&](const contact_candidate& u) { return magnitude(u.on_a - c.on_a) < meters(1e-3f); })) {
+			unique.push_back(c);
+		}
+	}
+	contacts = std::move(unique);
+
+	if (contacts.size() <= 4) return;
+
+	const auto point = [&](const std::size_t i) {
+		return physics::to_meters(contacts[i].on_a);
+	};
+
+	const auto pick = [&](auto&& score) {
+		std::size_t best = 0;
+		float best_score = -std::numeric_limits<float>::max();
+		for (std::size_t i = 0; i < contacts.size(); ++i) {
+			if (const float value = score(point(i)); value > best_score) {
+				best_score = value;
+				best = i;
+			}
+		}
+		return best;
+	};
+
+	const vec3f p0 = point(0);
+	const auto i1 = pick([&](const vec3f& p) { return magnitude(p - p0); });
+	const vec3f p1 = point(i1);
+	const auto i2 = pick([&](const vec3f& p) { return std::abs(dot(cross(p1 - p0, p - p0), normal)); });
+	const vec3f p2 = point(i2);
+
+	const float winding = dot(cross(p1 - p0, p2 - p0), normal) >= 0.f ? 1.f : -1.f;
+	const auto i3 = pick([&](const vec3f& p) {
+		return -std::min({
+			dot(cross(p1 - p0, p - p0), normal) * winding,
+			dot(cross(p2 - p1, p - p1), normal) * winding,
+			dot(cross(p0 - p2, p - p2), normal) * winding
+		});
+	});
+
+	contacts = { contacts[0], contacts[i1], contacts[i2], contacts[i3] };
+}
+
+auto gse::narrow_phase_collision::mesh_speculative(const shape_data& convex, const shape_data& mesh, const length margin) -> std::optional<sat_result> {
+	const auto contacts = collect_mesh_contacts(convex, mesh, margin);
+	if (contacts.empty()) return std::nullopt;
+
+	const auto& deepest = *std::ranges::max_element(contacts, {}, &contact_candidate::separation);
+
+	return sat_result{
+		.normal = -deepest.normal,
+		.separation = deepest.separation,
+		.is_speculative = deepest.separation < length{}
+	};
+}
+
+auto gse::narrow_phase_collision::mesh_manifold(const shape_data& convex, const shape_data& mesh, const vec3f& normal, const length separation) -> contact_manifold {
+	contact_manifold manifold;
+	auto [tu, tv] = compute_tangent_basis(normal);
+	manifold.tangent_u = tu;
+	manifold.tangent_v = tv;
+
+	auto contacts = collect_mesh_contacts(convex, mesh, std::max(-separation, length{}) + mesh_contact_band);
+	if (contacts.empty()) return manifold;
+
+	std::vector<contact_candidate> cluster;
+	cluster.reserve(contacts.size());
+	for (const auto& c : contacts) {
+		if (dot(c.normal, -normal) >= mesh_normal_cluster) {
+			cluster.push_back(c);
+		}
+	}
+
+	if (cluster.empty()) {
+		cluster.push_back(*std::ranges::max_element(contacts, {}, &contact_candidate::separation));
+	}
+
+	reduce_contacts(cluster, normal);
+
+	for (const auto& c : cluster) {
+		manifold.add_point(contact_point{
+			.position_on_a = c.on_a,
+			.position_on_b = c.on_b,
+			.normal = normal,
+			.separation = meters(0.f),
+			.feature = c.feature
+		});
+	}
+
+	return manifold;
+}
+
+auto gse::narrow_phase_collision::convex_support::operator()(const vec3f& direction) const -> vec3f {
+	switch (type) {
+		case physics::shape_type::sphere:
+			return center;
+		case physics::shape_type::capsule:
+			return center + axes[1] * (dot(direction, axes[1]) >= 0.f ? half_height : -half_height);
+		case physics::shape_type::convex_hull:
+			return center + rotate_vector(orientation, physics::to_meters(hull->support(inverse_rotate_vector(orientation, direction))));
+		case physics::shape_type::triangle_mesh:
+			return *std::ranges::max_element(triangle, {}, [&](const vec3f& v) { return dot(direction, v); });
+		default: {
+			vec3f result = center;
+			for (int i = 0; i < 3; ++i) {
+				result += axes[i] * (dot(direction, axes[i]) >= 0.f ? half_extents[i] : -half_extents[i]);
+			}
+			return result;
+		}
+	}
+}
+
+auto gse::narrow_phase_collision::make_support(const shape_data& shape) -> convex_support {
+	const auto o = shape.bb->obb();
+	convex_support support{
+		.type = shape.type,
+		.center = physics::to_meters(o.center),
+		.orientation = o.orientation,
+		.axes = o.axes,
+		.half_extents = physics::to_meters(shape.bb->half_extents()),
+		.hull = shape.hull
+	};
+
+	if (shape.type == physics::shape_type::sphere || shape.type == physics::shape_type::capsule) {
+		support.radius = shape.radius.as<meters>();
+		support.half_height = shape.half_height.as<meters>();
+	}
+
+	return support;
+}
+
+auto gse::narrow_phase_collision::make_support(const physics::collision_triangle& tri) -> convex_support {
+	return {
+		.type = physics::shape_type::triangle_mesh,
+		.center = physics::to_meters((tri.vertices[0] + tri.vertices[1] + tri.vertices[2]) / 3.f),
+		.triangle = {
+			physics::to_meters(tri.vertices[0]),
+			physics::to_meters(tri.vertices[1]),
+			physics::to_meters(tri.vertices[2])
+		}
+	};
+}
+
+auto gse::narrow_phase_collision::minkowski_support(const convex_support& sa, const convex_support& sb, const vec3f& direction) -> support_point {
+	const vec3f a = sa(direction);
+	const vec3f b = sb(-direction);
+	return { .w = a - b, .a = a, .b = b };
+}
+
+auto gse::narrow_phase_collision::triangle_barycentric(const vec3f& p, const vec3f& a, const vec3f& b, const vec3f& c) -> vec3f {
+	const vec3f ab = b - a;
+	const vec3f ac = c - a;
+
+	const vec3f ap = p - a;
+	const float d1 = dot(ab, ap);
+	const float d2 = dot(ac, ap);
+	if (d1 <= 0.f && d2 <= 0.f) return { 1.f, 0.f, 0.f };
+
+	const vec3f bp = p - b;
+	const float d3 = dot(ab, bp);
+	const float d4 = dot(ac, bp);
+	if (d3 >= 0.f && d4 <= d3) return { 0.f, 1.f, 0.f };
+
+	const float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) {
+		const float v = d1 / (d1 - d3);
+		return { 1.f - v, v, 0.f };
+	}
+
+	const vec3f cp = p - c;
+	const float d5 = dot(ab, cp);
+	const float d6 = dot(ac, cp);
+	if (d6 >= 0.f && d5 <= d6) return { 0.f, 0.f, 1.f };
+
+	const float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) {
+		const float w = d2 / (d2 - d6);
+		return { 1.f - w, 0.f, w };
+	}
+
+	const float va = d3 * d6 - d5 * d4;
+	if (va <= 0.f && d4 - d3 >= 0.f && d5 - d6 >= 0.f) {
+		const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		return { 0.f, 1.f - w, w };
+	}
+
+	const float sum = va + vb + vc;
+	if (std::abs(sum) < 1e-12f) return { 1.f, 0.f, 0.f };
+
+	const float v = vb / sum;
+	const float w = vc / sum;
+	return { 1.f - v - w, v, w };
+}
+
+auto gse::narrow_phase_collision::reduce_simplex(gjk_simplex& simplex) -> bool {
+	const auto& p = simplex.points;
+
+	const auto assign = [&](const std::array<support_point, 3> points, const vec3f& weights) {
+		gjk_simplex reduced;
+		for (std::uint32_t i = 0; i < 3; ++i) {
+			if (weights[i] > 0.f) {
+				reduced.points[reduced.count] = points[i];
+				reduced.weights[reduced.count++] = weights[i];
+			}
+		}
+		simplex = reduced;
+	};
+
+	switch (simplex.count) {
+		case 1:
+			simplex.weights[0] = 1.f;
+			return false;
+		case 2: {
+			const vec3f ab = p[1].w - p[0].w;
+			const float length_sq = dot(ab, ab);
+			const float t = length_sq > 1e-12f ? std::clamp(-dot(p[0].w, ab) / length_sq, 0.f, 1.f) : 0.f;
+			assign({ p[0], p[1], p[1] }, { 1.f - t, t, 0.f });
+			return false;
+		}
+		case 3:
+			assign({ p[0], p[1], p[2] }, triangle_barycentric({}, p[0].w, p[1].w, p[2].w));
+			return false;
+		default:
+			break;
+	}
+
+	static constexpr std::array<std::array<std::uint32_t, 4>, 4> faces = {{
+		{ 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 }
+	}};
+
+	float best_distance = std::numeric_limits<float>::max();
+	std::array<support_point, 3> best_points;
+	vec3f best_weights;
+	bool outside = false;
+
+	for (const auto& [i, j, k, l] : faces) {
+		const vec3f n = cross(p[j].w - p[i].w, p[k].w - p[i].w);
+		if (-dot(n, p[i].w) * dot(n, p[l].w - p[i].w) > 0.f) continue;
+
+		outside = true;
+		const vec3f weights = triangle_barycentric({}, p[i].w, p[j].w, p[k].w);
+		const vec3f closest = p[i].w * weights.x() + p[j].w * weights.y() + p[k].w * weights.z();
+		if (const float distance = dot(closest, closest); distance < best_distance) {
+			best_distance = distance;
+			best_points = { p[i], p[j], p[k] };
+			best_weights = weights;
+		}
+	}
+
+	if (!outside) return true;
+
+	assign(best_points, best_weights);
+	return false;
+}
+
+auto gse::narrow_phase_collision::simplex_points(const gjk_simplex& simplex) -> std::pair<vec3f, vec3f> {
+	vec3f a = {};
+	vec3f b = {};
+	for (std::uint32_t i = 0; i < simplex.count; ++i) {
+		a += simplex.points[i].a * simplex.weights[i];
+		b += simplex.points[i].b * simplex.weights[i];
+	}
+	return { a, b };
+}
+
+auto gse::narrow_phase_collision::gjk_distance(const convex_support& sa, const convex_support& sb, const float max_distance, gjk_simplex& simplex) -> std::optional<vec3f> {
+	vec3f direction = sb.center - sa.center;
+	if (is_zero(direction, 1e-6f)) {
+		direction = { 1.f, 0.f, 0.f };
+	}
+
+	simplex = {};
+	simplex.points[0] = minkowski_support(sa, sb, direction);
+	simplex.weights[0] = 1.f;
+	simplex.count = 1;
+	vec3f v = simplex.points[0].w;
+
+	for (int iteration = 0; iteration < gjk_max_iterations; ++iteration) {
+		const float v_sq = dot(v, v);
+		if (v_sq < convex_tolerance * convex_tolerance) {
+			return vec3f{};
+		}
+
+		const auto w = minkowski_support(sa, sb, -v);
+		const float v_dot_w = dot(v, w.w);
+		if (v_dot_w > 0.f && v_dot_w * v_dot_w > max_distance * max_distance * v_sq) {
+			return std::nullopt;
+		}
+
+		if (v_sq - v_dot_w <= std::max(v_sq * 1e-6f, 1e-10f)) {
+			return v;
+		}
+
+		const auto begin = simplex.points.begin();
+		if (std::any_of(begin, begin + simplex.count, [&](const support_point& s) { return is_zero(s.w - w.w, 1e-7f); })) {
+			return v;
+		}
+
+		simplex.points[simplex.count++] = w;
+		if (reduce_simplex(simplex)) {
+			return vec3f{};
+		}
+
+		const auto [a, b] = simplex_points(simplex);
+		v = a - b;
+	}
+
+	return v;
+}
+
+auto gse::narrow_phase_collision::epa_penetration(const convex_support& sa, const convex_support& sb, const gjk_simplex& simplex) -> std::optional<epa_result> {
+	struct epa_face {
+		std::array<std::uint32_t, 3> v;
+		vec3f normal;
+		float distance = 0.f;
+	};
+
+	std::vector<support_point> vertices(simplex.points.begin(), simplex.points.begin() + simplex.count);
+
+	const auto try_add = [&](const vec3f& direction, auto&& accept) {
+		const auto s = minkowski_support(sa, sb, direction);
+		if (!accept(s.w)) return false;
+		vertices.push_back(s);
+		return true;
+	};
+
+	if (vertices.size() == 1) {
+		for (const vec3f& direction : { vec3f(1.f, 0.f, 0.f), vec3f(-1.f, 0.f, 0.f), vec3f(0.f, 1.f, 0.f), vec3f(0.f, -1.f, 0.f), vec3f(0.f, 0.f, 1.f), vec3f(0.f, 0.f, -1.f) }) {
+			if (try_add(direction, [&](const vec3f& w) { return magnitude(w - vertices[0].w) > convex_tolerance; })) break;
+		}
+	}
+
+	if (vertices.size() == 2) {
+		const vec3f axis = vertices[1].w - vertices[0].w;
+		const auto [tu, tv] = compute_tangent_basis(normalize(axis));
+		for (const vec3f& direction : { tu, -tu, tv, -tv }) {
+			if (try_add(direction, [&](const vec3f& w) { return magnitude(cross(axis, w - vertices[0].w)) > convex_tolerance * magnitude(axis); })) break;
+		}
+	}
+
+	if (vertices.size() == 3) {
+		const vec3f n = cross(vertices[1].w - vertices[0].w, vertices[2].w - vertices[0].w);
+		if (!is_zero(n, 1e-12f)) {
+			const vec3f axis = normalize(n);
+			for (const vec3f& direction : { axis, -axis }) {
+				if (try_add(direction, [&](const vec3f& w) { return std::abs(dot(axis, w - vertices[0].w)) > convex_tolerance; })) break;
+			}
+		}
+	}
+
+	if (vertices.size() < 4) return std::nullopt;
+
+	std::vector<epa_face> faces;
+	const auto add_face = [&](const std::uint32_t a, const std::uint32_t b, const std::uint32_t c) {
+		const vec3f n = cross(vertices[b].w - vertices[a].w, vertices[c].w - vertices[a].w);
+		if (is_zero(n, 1e-12f)) return;
+
+		const vec3f normal = normalize(n);
+		faces.push_back({
+			.v = { a, b, c },
+			.normal = normal,
+			.distance = dot(normal, vertices[a].w)
+		});
+	};
+
+	static constexpr std::array<std::array<std::uint32_t, 3>, 4> tetrahedron = {{
+		{ 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 }
+	}};
+
+	const vec3f interior = (vertices[0].w + vertices[1].w + vertices[2].w + vertices[3].w) * 0.25f;
+	for (const auto& [a, b, c] : tetrahedron) {
+		if (dot(cross(vertices[b].w - vertices[a].w, vertices[c].w - vertices[a].w), vertices[a].w - interior) >= 0.f) {
+			add_face(a, b, c);
+		}
+		else {
+			add_face(a, c, b);
+		}
+	}
+
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+	for (int iteration = 0; iteration < epa_max_iterations && !faces.empty(); ++iteration) {
+		const auto closest = *std::ranges::min_element(faces, {}, &epa_face::distance);
+		const auto s = minkowski_support(sa, sb, closest.normal);
+		if (dot(s.w, closest.normal) - closest.distance < convex_tolerance) break;
+
+		const auto visible = [&](const epa_face& f) {
+			return dot(f.normal, s.w - vertices[f.v[0]].w) > 0.f;
+		};
+
+		edges.clear();
+		for (const auto& f : faces) {
+			if (!visible(f)) continue;
+			edges.emplace_back(f.v[0], f.v[1]);
+			edges.emplace_back(f.v[1], f.v[2]);
+			edges.emplace_back(f.v[2], f.v[0]);
+		}
+		std::erase_if(faces, visible);
+
+		const auto index = static_cast<std::uint32_t>(vertices.size());
+		vertices.push_back(s);
+
+		for (const auto& [u, v] : edges) {
+			if (std::ranges::find(edges, std::pair{ v, u }) == edges.end()) {
+				add_face(u, v, index);
+			}
+		}
+	}
+
+	if (faces.empty()) return std::nullopt;
+
+	const auto& best = *std::ranges::min_element(faces, {}, &epa_face::distance);
+	const auto& [a, b, c] = best.v;
+	const vec3f weights = triangle_barycentric(best.normal * best.distance, vertices[a].w, vertices[b].w, vertices[c].w);
+
+	return epa_result{
+		.normal = best.normal,
+		.depth = std::max(best.distance, 0.f),
+		.point_a = vertices[a].a * weights.x() + vertices[b].a * weights.y() + vertices[c].a * weights.z(),
+		.point_b = vertices[a].b * weights.x() + vertices[b].b * weights.y() + vertices[c].b * weights.z()
+	};
+}
+
+auto gse::narrow_phase_collision::convex_query(const convex_support& sa, const convex_support& sb, const length margin) -> std::optional<convex_result> {
+	const float radii = sa.radius + sb.radius;
+	const float margin_m = margin.as<meters>();
+
+	gjk_simplex simplex;
+	const auto closest = gjk_distance(sa, sb, radii + margin_m, simplex);
+	if (!closest) return std::nullopt;
+
+	vec3f normal;
+	float core_distance = 0.f;
+	auto [point_a, point_b] = simplex_points(simplex);
+
+	if (const float distance = magnitude(*closest); distance > convex_tolerance) {
+		normal = -*closest / distance;
+		core_distance = distance;
+	}
+	else if (const auto penetration = epa_penetration(sa, sb, simplex)) {
+		normal = penetration->normal;
+		core_distance = -penetration->depth;
+		point_a = penetration->point_a;
+		point_b = penetration->point_b;
+	}
+	else {
+		const vec3f between = sb.center - sa.center;
+		normal = is_zero(between, 1e-6f) ? vec3f(0.f, 1.f, 0.f) : normalize(between);
+		point_a = sa(normal);
+		point_b = sb(-normal);
+		core_distance = dot(point_b - point_a, normal);
+	}
+
+	const float separation = radii - core_distance;
+	if (separation < -margin_m) return std::nullopt;
+
+	return convex_result{
+		.normal = normal,
+		.separation = meters(separation),
+		.point_a = physics::from_meters(point_a + normal * sa.radius),
+		.point_b = physics::from_meters(point_b - normal * sb.radius)
+	};
+}
+
+auto gse::narrow_phase_collision::is_polyhedral(const physics::shape_type type) -> bool {
+	return type == physics::shape_type::box || type == physics::shape_type::convex_hull;
+}
+
+auto gse::narrow_phase_collision::support_feature(const shape_data& shape, const vec3<length>& point, const vec3f& direction) -> std::pair<feature_type, std::uint8_t> {
+	switch (shape.type) {
+		case physics::shape_type::sphere:
+			return { feature_type::face, sphere_surface_index };
+		case physics::shape_type::capsule: {
+			const auto [p0, p1] = capsule_endpoints(*shape.bb, shape.half_height);
+			const vec3f axis = physics::to_meters(p1 - p0);
+			const float t = dot(physics::to_meters(point - p0), axis) / std::max(dot(axis, axis), 1e-12f);
+			return classify_capsule_feature(std::clamp(t, 0.f, 1.f));
+		}
+		case physics::shape_type::convex_hull: {
+			const auto local = inverse_rotate_vector(shape.bb->obb().orientation, direction);
+			return { feature_type::face, static_cast<std::uint8_t>(shape.hull->best_face(local)) };
+		}
+		default:
+			return { feature_type::face, classify_box_face(*shape.bb, direction) };
+	}
+}
+
+auto gse::narrow_phase_collision::polyhedral_face(const shape_data& shape, const vec3f& direction) -> polygon_face {
+	if (shape.type == physics::shape_type::convex_hull) {
+		const auto orientation = shape.bb->obb().orientation;
+		const auto center = shape.bb->center();
+		const auto index = shape.hull->best_face(inverse_rotate_vector(orientation, direction));
+
+		polygon_face face{
+			.index = static_cast<std::uint8_t>(index),
+			.normal = rotate_vector(orientation, shape.hull->faces()[index].normal)
+		};
+		for (const auto& v : shape.hull->face_vertices(index)) {
+			face.vertices.push_back(center + rotate_vector(orientation, v));
+		}
+		return face;
+	}
+
+	const auto info = find_best_face_info(*shape.bb, direction);
+	return {
+		.index = info.face_index,
+		.normal = info.normal,
+		.vertices = { info.vertices.begin(), info.vertices.end() }
+	};
+}
+
+auto gse::narrow_phase_collision::clip_faces(const polygon_face& reference, const polygon_face& incident, const bool reference_is_a) -> clipped_face_contacts {
+	const auto incident_count = incident.vertices.size();
+	std::vector<clip_vertex> polygon;
+	polygon.reserve(incident_count);
+	for (std::size_t i = 0; i < incident_count; ++i) {
+		clip_vertex vertex{ .point = incident.vertices[i] };
+		add_side(vertex.incident_sides, static_cast<std::uint8_t>(i));
+		add_side(vertex.incident_sides, static_cast<std::uint8_t>((i + incident_count - 1) % incident_count));
+		polygon.push_back(vertex);
+	}
+
+	vec3<length> reference_center = {};
+	for (const auto& v : reference.vertices) {
+		reference_center += v;
+	}
+	reference_center /= static_cast<float>(reference.vertices.size());
+
+	for (std::size_t i = 0; i < reference.vertices.size() && !polygon.empty(); ++i) {
+		const auto& v1 = reference.vertices[i];
+		const auto& v2 = reference.vertices[(i + 1) % reference.vertices.size()];
+
+		vec3f plane_normal = cross(reference.normal, physics::to_meters(v2 - v1));
+		if (is_zero(plane_normal, 1e-9f)) continue;
+
+		plane_normal = normalize(plane_normal);
+		if (dot(plane_normal, reference_center - v1) < length{}) {
+			plane_normal = -plane_normal;
+		}
+
+		polygon = clip_polygon(
+			polygon,
+			plane{
+				.normal = plane_normal,
+				.distance = dot(plane_normal, v1)
+			},
+			true,
+			true,
+			static_cast<std::uint8_t>(i)
+		);
+	}
+
+	return clipped_face_contacts{
+		.vertices = std::move(polygon),
+		.reference_is_a = reference_is_a,
+		.reference_face = reference.index,
+		.incident_face = incident.index
+	};
+}
+
+auto gse::narrow_phase_collision::polyhedral_contacts(const shape_data& a, const shape_data& b, const vec3f& normal, const length band, std::vector<contact_candidate>& out) -> void {
+	const auto face_a = polyhedral_face(a, normal);
+	const auto face_b = polyhedral_face(b, -normal);
+	const float alignment_a = dot(face_a.normal, normal);
+	const float alignment_b = dot(face_b.normal, -normal);
+	if (std::max(alignment_a, alignment_b) < convex_face_alignment) return;
+
+	const bool reference_is_a = alignment_a >= alignment_b - 1e-4f;
+	const auto& reference = reference_is_a ? face_a : face_b;
+	const auto& incident = reference_is_a ? face_b : face_a;
+
+	const auto clipped = clip_faces(reference, incident, reference_is_a);
+	const length reference_distance = dot(reference.normal, reference.vertices[0]);
+
+	for (const auto& vertex : clipped.vertices) {
+		const length gap = dot(reference.normal, vertex.point) - reference_distance;
+		if (gap > band) continue;
+
+		const auto on_reference = vertex.point - reference.normal * gap;
+		out.push_back({
+			.on_a = reference_is_a ? on_reference : vertex.point,
+			.on_b = reference_is_a ? vertex.point : on_reference,
+			.normal = -normal,
+			.separation = -gap,
+			.feature = build_feature_from_clip_vertex(clipped, vertex)
+		});
+	}
+}
+
+auto gse::narrow_phase_collision::capsule_face_contacts(const shape_data& capsule, const shape_data& polyhedron, const vec3f& normal, const bool capsule_is_a, const length band, std::vector<contact_candidate>& out) -> void {
+	const vec3f toward_capsule = capsule_is_a ? -normal : normal;
+	const auto face = polyhedral_face(polyhedron, toward_capsule);
+	if (dot(face.normal, toward_capsule) < convex_face_alignment) return;
+
+	const auto [p0, p1] = capsule_endpoints(*capsule.bb, capsule.half_height);
+
+	vec3<length> face_center = {};
+	for (const auto& v : face.vertices) {
+		face_center += v;
+	}
+	face_center /= static_cast<float>(face.vertices.size());
+
+	float t0 = 0.f;
+	float t1 = 1.f;
+	for (std::size_t i = 0; i < face.vertices.size(); ++i) {
+		const auto& v1 = face.vertices[i];
+		const auto& v2 = face.vertices[(i + 1) % face.vertices.size()];
+
+		vec3f side = cross(face.normal, physics::to_meters(v2 - v1));
+		if (is_zero(side, 1e-9f)) continue;
+
+		side = normalize(side);
+		if (dot(side, face_center - v1) < length{}) {
+			side = -side;
+		}
+
+		const length d0 = dot(side, p0 - v1);
+		const length d1 = dot(side, p1 - v1);
+		if (d0 < length{} && d1 < length{}) return;
+
+		const float crossing = d0 / (d0 - d1);
+		if (d0 < length{}) {
+			t0 = std::max(t0, crossing);
+		}
+		else if (d1 < length{}) {
+			t1 = std::min(t1, crossing);
+		}
+	}
+
+	if (t0 > t1) return;
+
+	const length face_distance = dot(face.normal, face.vertices[0]);
+	for (const float t : { t0, t1 }) {
+		const auto on_axis = p0 + (p1 - p0) * t;
+		const length gap = dot(face.normal, on_axis) - face_distance - capsule.radius;
+		if (gap > band) continue;
+
+		const auto on_capsule = on_axis - face.normal * capsule.radius;
+		const auto on_polyhedron = on_capsule - face.normal * gap;
+		const auto [type, index] = classify_capsule_feature(t);
+
+		out.push_back({
+			.on_a = capsule_is_a ? on_capsule : on_polyhedron,
+			.on_b = capsule_is_a ? on_polyhedron : on_capsule,
+			.normal = -normal,
+			.separation = -gap,
+			.feature = capsule_is_a
+				? feature_id{ .type_a = type, .type_b = feature_type::face, .index_a = index, .index_b = face.index }
+				: feature_id{ .type_a = feature_type::face, .type_b = type, .index_a = face.index, .index_b = index }
+		});
+	}
+}
+
+auto gse::narrow_phase_collision::hull_triangle_contacts(const shape_data& hull, const physics::collision_triangle& tri, const length margin, std::vector<contact_candidate>& out) -> void {
+	const auto& n_t = tri.normal;
+	if (dot(n_t, hull.bb->center() - tri.vertices[0]) < length{}) return;
+
+	const auto query = convex_query(make_support(hull), make_support(tri), margin);
+	if (!query) return;
+
+	const vec3f n = -query->normal;
+	const length band = std::max(-query->separation, length{}) + mesh_contact_band;
+	const auto first = out.size();
+
+	if (const auto incident = polyhedral_face(hull, -n_t); dot(n, n_t) >= convex_face_alignment && dot(incident.normal, -n_t) >= convex_face_alignment) {
+		const polygon_face reference{
+			.normal = n_t,
+			.vertices = { tri.vertices.begin(), tri.vertices.end() }
+		};
+
+		const auto clipped = clip_faces(reference, incident, false);
+		const length plane_distance = dot(n_t, tri.vertices[0]);
+
+		for (const auto& vertex : clipped.vertices) {
+			const length gap = dot(n_t, vertex.point) - plane_distance;
+			if (gap > band) continue;
+
+			out.push_back({
+				.on_a = vertex.point,
+				.on_b = vertex.point - n_t * gap,
+				.normal = n,
+				.separation = -gap,
+				.feature = mesh_feature(tri, feature_type_from_sides(vertex.incident_sides), incident.index, vertex.incident_sides.values[0], feature_type_from_sides(vertex.reference_sides))
+			});
+		}
+	}
+
+	if (out.size() == first) {
+		const auto [type, index] = support_feature(hull, query->point_a, query->normal);
+		out.push_back({
+			.on_a = query->point_a,
+			.on_b = query->point_b,
+			.normal = n,
+			.separation = query->separation,
+			.feature = mesh_feature(tri, type, index, feature_side_none, feature_type::edge)
+		});
+	}
+}
+
+auto gse::narrow_phase_collision::convex_speculative(const shape_data& a, const shape_data& b, const length margin) -> std::optional<sat_result> {
+	const auto result = convex_query(make_support(a), make_support(b), margin);
+	if (!result) return std::nullopt;
+
+	return sat_result{
+		.normal = result->normal,
+		.separation = result->separation,
+		.is_speculative = result->separation < length{}
+	};
+}
+
+auto gse::narrow_phase_collision::convex_manifold(const shape_data& a, const shape_data& b, const vec3f& normal, const length separation) -> contact_manifold {
+	using st = physics::shape_type;
+
+	contact_manifold manifold;
+	auto [tu, tv] = compute_tangent_basis(normal);
+	manifold.tangent_u = tu;
+	manifold.tangent_v = tv;
+
+	const length band = std::max(-separation, length{}) + mesh_contact_band;
+	std::vector<contact_candidate> contacts;
+
+	if (is_polyhedral(a.type) && is_polyhedral(b.type)) {
+		polyhedral_contacts(a, b, normal, band, contacts);
+	}
+	else if (a.type == st::capsule && is_polyhedral(b.type)) {
+		capsule_face_contacts(a, b, normal, true, band, contacts);
+	}
+	else if (b.type == st::capsule && is_polyhedral(a.type)) {
+		capsule_face_contacts(b, a, normal, false, band, contacts);
+	}
+
+	if (contacts.empty()) {
+		const auto query = convex_query(make_support(a), make_support(b), band);
+		if (!query) return manifold;
+
+		const auto [type_a, index_a] = support_feature(a, query->point_a, query->normal);
+		const auto [type_b, index_b] = support_feature(b, query->point_b, -query->normal);
+		contacts.push_back({
+			.on_a = query->point_a,
+			.on_b = query->point_b,
+			.normal = -query->normal,
+			.separation = query->separation,
+			.feature = {
+				.type_a = type_a,
+				.type_b = type_b,
+				.index_a = index_a,
+				.index_b = index_b
+			}
+		});
+	}
+
+	reduce_contacts(contacts, normal);
+
+	for (const auto& c : contacts) {
+		manifold.add_point(contact_point{
+			.position_on_a = c.on_a,
+			.position_on_b = c.on_b,
+			.normal = normal,
+			.separation = meters(0.f),
+			.feature = c.feature
+		});
+	}
+
+	return manifold;
+}
+
 auto gse::narrow_phase_collision::speculative_test(
 	const shape_data& a, const shape_data& b, const length margin
 ) -> std::optional<sat_result> {
 	using st = physics::shape_type;
 	const bool swap = a.type > b.type;
-	const auto& [lo_bb, lo_type, lo_radius, lo_half_height] = swap ? b : a;
-	const auto& [hi_bb, hi_type, hi_radius, hi_half_height] = swap ? a : b;
+	const auto& lo = swap ? b : a;
+	const auto& hi = swap ? a : b;
 
 	std::optional<sat_result> result;
 
-	if (lo_type == st::box && hi_type == st::box) {
-		result = sat_speculative(*lo_bb, *hi_bb, margin);
-	} else if (lo_type == st::box && hi_type == st::sphere) {
-		result = box_sphere_speculative(*lo_bb, hi_bb->center(), hi_radius, margin);
-	} else if (lo_type == st::box && hi_type == st::capsule) {
-		result = box_capsule_speculative(*lo_bb, *hi_bb, hi_half_height, hi_radius, margin);
-	} else if (lo_type == st::sphere && hi_type == st::sphere) {
-		result = sphere_sphere_speculative(lo_bb->center(), lo_radius, hi_bb->center(), hi_radius, margin);
-	} else if (lo_type == st::sphere && hi_type == st::capsule) {
-		result = sphere_capsule_speculative(lo_bb->center(), lo_radius, *hi_bb, hi_half_height, hi_radius, margin);
-	} else if (lo_type == st::capsule && hi_type == st::capsule) {
-		result = capsule_capsule_speculative(*lo_bb, lo_half_height, lo_radius, *hi_bb, hi_half_height, hi_radius, margin);
+	if (lo.type == st::box && hi.type == st::box) {
+		result = sat_speculative(*lo.bb, *hi.bb, margin);
+	} else if (lo.type == st::box && hi.type == st::sphere) {
+		result = box_sphere_speculative(*lo.bb, hi.bb->center(), hi.radius, margin);
+	} else if (lo.type == st::box && hi.type == st::capsule) {
+		result = box_capsule_speculative(*lo.bb, *hi.bb, hi.half_height, hi.radius, margin);
+	} else if (lo.type == st::sphere && hi.type == st::sphere) {
+		result = sphere_sphere_speculative(lo.bb->center(), lo.radius, hi.bb->center(), hi.radius, margin);
+	} else if (lo.type == st::sphere && hi.type == st::capsule) {
+		result = sphere_capsule_speculative(lo.bb->center(), lo.radius, *hi.bb, hi.half_height, hi.radius, margin);
+	} else if (lo.type == st::capsule && hi.type == st::capsule) {
+		result = capsule_capsule_speculative(*lo.bb, lo.half_height, lo.radius, *hi.bb, hi.half_height, hi.radius, margin);
+	} else if (hi.type == st::convex_hull) {
+		result = convex_speculative(lo, hi, margin);
+	} else if (physics::is_mesh_shape(hi.type) && !physics::is_mesh_shape(lo.type)) {
+		result = mesh_speculative(lo, hi, margin);
 	}
 
 	if (swap && result) {
@@ -1350,24 +2557,28 @@ auto gse::narrow_phase_collision::generate_shape_manifold(
 ) -> contact_manifold {
 	using st = physics::shape_type;
 	const bool swap = a.type > b.type;
-	const auto& [lo_bb, lo_type, lo_radius, lo_half_height] = swap ? b : a;
-	const auto& [hi_bb, hi_type, hi_radius, hi_half_height] = swap ? a : b;
+	const auto& lo = swap ? b : a;
+	const auto& hi = swap ? a : b;
 	const auto n = swap ? -normal : normal;
 
 	contact_manifold manifold;
 
-	if (lo_type == st::box && hi_type == st::box) {
-		manifold = generate_manifold(*lo_bb, *hi_bb, n, separation);
-	} else if (lo_type == st::box && hi_type == st::sphere) {
-		manifold = box_sphere_manifold(*lo_bb, hi_bb->center(), hi_radius, n, separation);
-	} else if (lo_type == st::box && hi_type == st::capsule) {
-		manifold = box_capsule_manifold(*lo_bb, *hi_bb, hi_half_height, hi_radius, n, separation);
-	} else if (lo_type == st::sphere && hi_type == st::sphere) {
-		manifold = sphere_sphere_manifold(lo_bb->center(), lo_radius, hi_bb->center(), hi_radius, n, separation);
-	} else if (lo_type == st::sphere && hi_type == st::capsule) {
-		manifold = sphere_capsule_manifold(lo_bb->center(), lo_radius, *hi_bb, hi_half_height, hi_radius, n, separation);
-	} else if (lo_type == st::capsule && hi_type == st::capsule) {
-		manifold = capsule_capsule_manifold(*lo_bb, lo_half_height, lo_radius, *hi_bb, hi_half_height, hi_radius, n, separation);
+	if (lo.type == st::box && hi.type == st::box) {
+		manifold = generate_manifold(*lo.bb, *hi.bb, n, separation);
+	} else if (lo.type == st::box && hi.type == st::sphere) {
+		manifold = box_sphere_manifold(*lo.bb, hi.bb->center(), hi.radius, n, separation);
+	} else if (lo.type == st::box && hi.type == st::capsule) {
+		manifold = box_capsule_manifold(*lo.bb, *hi.bb, hi.half_height, hi.radius, n, separation);
+	} else if (lo.type == st::sphere && hi.type == st::sphere) {
+		manifold = sphere_sphere_manifold(lo.bb->center(), lo.radius, hi.bb->center(), hi.radius, n, separation);
+	} else if (lo.type == st::sphere && hi.type == st::capsule) {
+		manifold = sphere_capsule_manifold(lo.bb->center(), lo.radius, *hi.bb, hi.half_height, hi.radius, n, separation);
+	} else if (lo.type == st::capsule && hi.type == st::capsule) {
+		manifold = capsule_capsule_manifold(*lo.bb, lo.half_height, lo.radius, *hi.bb, hi.half_height, hi.radius, n, separation);
+	} else if (hi.type == st::convex_hull) {
+		manifold = convex_manifold(lo, hi, n, separation);
+	} else if (physics::is_mesh_shape(hi.type) && !physics::is_mesh_shape(lo.type)) {
+		manifold = mesh_manifold(lo, hi, n, separation);
 	}
 
 	if (swap) {
@@ -0,0 +1,639 @@
+export module gse.physics:scene_query;
+
+import std;
+
+import gse.math;
+import gse.utility;
+
+import :bounding_box;
+import :broad_phase_collision;
+import :collision_component;
+import :convex_hull;
+import :mesh_collider;
+import :motion_component;
+import :narrow_phase_collision;
+
+export namespace gse::physics {
+	struct ray {
+		vec3<length> origin;
+		vec3f direction = { 0.f, 0.f, 1.f };
+		length max_distance = meters(1000.f);
+	};
+
+	struct query_shape {
+		shape_type type = shape_type::sphere;
+		vec3<length> half_extents;
+		length radius = {};
+		length half_height = {};
+		quat orientation = quat(1.f, 0.f, 0.f, 0.f);
+	};
+
+	struct shape_sweep {
+		query_shape shape;
+		vec3<length> start;
+		vec3f direction = { 0.f, 0.f, 1.f };
+		length distance = {};
+	};
+
+	struct query_filter {
+		id ignore;
+		bool include_static = true;
+		bool include_dynamic = true;
+		bool include_non_solid = false;
+	};
+
+	struct query_hit {
+		id entity;
+		vec3<length> point;
+		vec3f normal;
+		length distance = {};
+	};
+
+	class scene_query {
+	public:
+		static auto build(
+			const chunk<collision_component>& collision,
+			const chunk<motion_component>& motion
+		) -> std::shared_ptr<const scene_query>;
+
+		auto raycast(
+			const ray& r,
+			const query_filter& filter = {}
+		) const -> std::optional<query_hit>;
+
+		auto raycast(
+			std::span<const ray> rays,
+			std::span<std::optional<query_hit>> hits,
+			const query_filter& filter = {}
+		) const -> void;
+
+		auto sweep(
+			const shape_sweep& s,
+			const query_filter& filter = {}
+		) const -> std::optional<query_hit>;
+
+		auto sweep(
+			std::span<const shape_sweep> sweeps,
+			std::span<std::optional<query_hit>> hits,
+			const query_filter& filter = {}
+		) const -> void;
+
+		auto overlap(
+			const vec3<length>& min,
+			const vec3<length>& max,
+			std::vector<id>& out,
+			const query_filter& filter = {}
+		) const -> void;
+
+		auto overlap(
+			const query_shape& shape,
+			const vec3<length>& center,
+			std::vector<id>& out,
+			const query_filter& filter = {}
+		) const -> void;
+
+		auto proxy_count(
+		) const -> std::size_t;
+	private:
+		struct proxy {
+			id entity;
+			aabb bounds;
+			bounding_box bb;
+			shape_type type = shape_type::box;
+			length radius = {};
+			length half_height = {};
+			std::shared_ptr<const convex_hull> hull;
+			std::shared_ptr<const triangle_mesh> mesh;
+			std::shared_ptr<const heightfield> field;
+			bool dynamic = false;
+			bool solid = true;
+		};
+
+		struct node {
+			aabb bounds;
+			std::uint32_t first = 0;
+			std::uint32_t count = 0;
+		};
+
+		static constexpr std::uint32_t leaf_size = 4;
+		static constexpr int max_sweep_iterations = 32;
+
+		static auto accepts(
+			const proxy& p,
+			const query_filter& filter
+		) -> bool;
+
+		static auto raycast_proxy(
+			const ray& r,
+			const proxy& p,
+			float max_t
+		) -> std::optional<query_hit>;
+
+		static auto sweep_proxy(
+			const shape_sweep& s,
+			const proxy& p,
+			length limit
+		) -> std::optional<query_hit>;
+
+		auto build_node(
+			std::uint32_t begin,
+			std::uint32_t end
+		) -> std::uint32_t;
+
+		template <typename Overlaps, typename Visit>
+		auto traverse(
+			Overlaps&& overlaps,
+			Visit&& visit
+		) const -> void;
+
+		std::vector<proxy> m_proxies;
+		std::vector<node> m_nodes;
+	};
+
+	class scene_query_buffer {
+	public:
+		auto publish(
+			std::shared_ptr<const scene_query> scene
+		) -> void;
+
+		auto acquire(
+		) const -> std::shared_ptr<const scene_query>;
+	private:
+		std::atomic<std::shared_ptr<const scene_query>> m_current;
+	};
+}
+
+namespace gse::physics {
+	auto ray_sphere(
+		const vec3f& origin,
+		const vec3f& direction,
+		const vec3f& center,
+		float radius,
+		float max_t
+	) -> std::optional<float>;
+
+	auto query_box(
+		const query_shape& shape,
+		const vec3<length>& center
+	) -> bounding_box;
+}
+
+auto gse::physics::ray_sphere(const vec3f& origin, const vec3f& direction, const vec3f& center, const float radius, const float max_t) -> std::optional<float> {
+	const vec3f oc = origin - center;
+	const float b = dot(oc, direction);
+	const float c = dot(oc, oc) - radius * radius;
+
+	if (c <= 0.f) return 0.f;
+	if (b > 0.f) return std::nullopt;
+
+	const float disc = b * b - c;
+	if (disc < 0.f) return std::nullopt;
+
+	const float t = -b - std::sqrt(disc);
+	if (t > max_t) return std::nullopt;
+
+	return t;
+}
+
+auto gse::physics::query_box(const query_shape& shape, const vec3<length>& center) -> bounding_box {
+	vec3<length> size = shape.half_extents * 2.f;
+	if (shape.type == shape_type::sphere) {
+		size = vec3<length>(shape.radius * 2.f);
+	}
+	else if (shape.type == shape_type::capsule) {
+		size = vec3<length>(shape.radius * 2.f, (shape.half_height + shape.radius) * 2.f, shape.radius * 2.f);
+	}
+
+	bounding_box bb(center, size);
+	bb.update(center, shape.orientation);
+	return bb;
+}
+
+auto gse::physics::scene_query::build(const chunk<collision_component>& collision, const chunk<motion_component>& motion) -> std::shared_ptr<const scene_query> {
+	auto scene = std::make_shared<scene_query>();
+	scene->m_proxies.reserve(collision.size());
+
+	for (const collision_component& cc : collision) {
+		const auto* mc = motion.find(cc.owner_id());
+
+		scene->m_proxies.push_back({
+			.entity = cc.owner_id(),
+			.bounds = cc.bounding_box.aabb(),
+			.bb = cc.bounding_box,
+			.type = cc.shape,
+			.radius = cc.shape_radius,
+			.half_height = cc.shape_half_height,
+			.hull = cc.hull,
+			.mesh = cc.mesh,
+			.field = cc.field,
+			.dynamic = mc && !mc->position_locked,
+			.solid = cc.resolve_collisions
+		});
+
+		(void)scene->m_proxies.back().bb.aabb();
+	}
+
+	if (!scene->m_proxies.empty()) {
+		scene->m_nodes.reserve(scene->m_proxies.size() / leaf_size * 2 + 1);
+		scene->build_node(0, static_cast<std::uint32_t>(scene->m_proxies.size()));
+	}
+
+	return scene;
+}
+
+auto gse::physics::scene_query::raycast(const ray& r, const query_filter& filter) const -> std::optional<query_hit> {
+	const vec3f origin = to_meters(r.origin);
+	const vec3f direction = normalize(r.direction);
+	const ray normalized{ .origin = r.origin, .direction = direction, .max_distance = r.max_distance };
+
+	float best = r.max_distance.as<meters>();
+	std::optional<query_hit> result;
+
+	traverse(
+		[&](const aabb& bounds) {
+			return ray_slab(origin, direction, to_meters(bounds.min), to_meters(bounds.max), best).has_value();
+		},
+		[&](const proxy& p) {
+			if (!accepts(p, filter)) return;
+			if (auto hit = raycast_proxy(normalized, p, best)) {
+				best = hit->distance.as<meters>();
+				result = hit;
+			}
+		}
+	);
+
+	return result;
+}
+
+auto gse::physics::scene_query::raycast(const std::span<const ray> rays, const std::span<std::optional<query_hit>> hits, const query_filter& filter) const -> void {
+	task::parallel_for(0uz, std::min(rays.size(), hits.size()), [&](const std::size_t i) {
+		hits[i] = raycast(rays[i], filter);
+	});
+}
+
+auto gse::physics::scene_query::sweep(const shape_sweep& s, const query_filter& filter) const -> std::optional<query_hit> {
+	const shape_sweep normalized{
+		.shape = s.shape,
+		.start = s.start,
+		.direction = normalize(s.direction),
+		.distance = s.distance
+	};
+
+	const auto start_box = query_box(s.shape, s.start).aabb();
+	const auto end_box = query_box(s.shape, s.start + normalized.direction * s.distance).aabb();
+	const auto swept = merge(start_box, end_box);
+
+	length best = s.distance;
+	std::optional<query_hit> result;
+
+	traverse(
+		[&](const aabb& bounds) {
+			return bounds.overlaps(swept);
+		},
+		[&](const proxy& p) {
+			if (!accepts(p, filter) || !p.bounds.overlaps(swept)) return;
+			if (auto hit = sweep_proxy(normalized, p, best)) {
+				best = hit->distance;
+				result = hit;
+			}
+		}
+	);
+
+	return result;
+}
+
+auto gse::physics::scene_query::sweep(const std::span<const shape_sweep> sweeps, const std::span<std::optional<query_hit>> hits, const query_filter& filter) const -> void {
+	task::parallel_for(0uz, std::min(sweeps.size(), hits.size()), [&](const std::size_t i) {
+		hits[i] = sweep(sweeps[i], filter);
+	});
+}
+
+auto gse::physics::scene_query::overlap(const vec3<length>& min, const vec3<length>& max, std::vector<id>& out, const query_filter& filter) const -> void {
+	const aabb bounds{ .max = max, .min = min };
+
+	traverse(
+		[&](const aabb& node_bounds) {
+			return node_bounds.overlaps(bounds);
+		},
+		[&](const proxy& p) {
+			if (accepts(p, filter) && p.bounds.overlaps(bounds)) {
+				out.push_back(p.entity);
+			}
+		}
+	);
+}
+
+auto gse::physics::scene_query::overlap(const query_shape& shape, const vec3<length>& center, std::vector<id>& out, const query_filter& filter) const -> void {
+	const auto bb = query_box(shape, center);
+	const auto& bounds = bb.aabb();
+
+	const narrow_phase_collision::shape_data query{
+		.bb = &bb,
+		.type = shape.type,
+		.radius = shape.radius,
+		.half_height = shape.half_height
+	};
+
+	traverse(
+		[&](const aabb& node_bounds) {
+			return node_bounds.overlaps(bounds);
+		},
+		[&](const proxy& p) {
+			if (!accepts(p, filter) || !p.bounds.overlaps(bounds)) return;
+
+			const narrow_phase_collision::shape_data target{
+				.bb = &p.bb,
+				.type = p.type,
+				.radius = p.radius,
+				.half_height = p.half_height,
+				.hull = p.hull.get(),
+				.mesh = p.mesh.get(),
+				.field = p.field.get()
+			};
+
+			if (const auto result = narrow_phase_collision::speculative_test(query, target, meters(0.f)); result && result->separation >= meters(0.f)) {
+				out.push_back(p.entity);
+			}
+		}
+	);
+}
+
+auto gse::physics::scene_query::proxy_count() const -> std::size_t {
+	return m_proxies.size();
+}
+
+auto gse::physics::scene_query::accepts(const proxy& p, const query_filter& filter) -> bool {
+	if (p.entity == filter.ignore) return false;
+	if (!p.solid && !filter.include_non_solid) return false;
+	return p.dynamic ? filter.include_dynamic : filter.include_static;
+}
+
+auto gse::physics::scene_query::raycast_proxy(const ray& r, const proxy& p, const float max_t) -> std::optional<query_hit> {
+	const vec3f origin = to_meters(r.origin);
+	const vec3f& direction = r.direction;
+
+	const auto hit_at = [&](const float t, const vec3f& normal) {
+		return query_hit{
+			.entity = p.entity,
+			.point = r.origin + direction * meters(t),
+			.normal = normal,
+			.distance = meters(t)
+		};
+	};
+
+	switch (p.type) {
+		case shape_type::sphere: {
+			const vec3f center = to_meters(p.bb.center());
+			const auto t = ray_sphere(origin, direction, center, p.radius.as<meters>(), max_t);
+			if (!t) return std::nullopt;
+
+			const vec3f to_hit = origin + direction * *t - center;
+			return hit_at(*t, *t > 0.f ? normalize(to_hit) : -direction);
+		}
+		case shape_type::capsule: {
+			const auto [top, bottom] = narrow_phase_collision::capsule_endpoints(p.bb, p.half_height);
+			const vec3f a = to_meters(top);
+			const vec3f b = to_meters(bottom);
+			const float radius = p.radius.as<meters>();
+
+			const vec3f ba = b - a;
+			const vec3f oa = origin - a;
+			const float baba = dot(ba, ba);
+			const float bard = dot(ba, direction);
+			const float baoa = dot(ba, oa);
+
+			std::optional<float> best;
+
+			const float s0 = baba > 1e-8f ? std::clamp(baoa / baba, 0.f, 1.f) : 0.f;
+			if (const vec3f inside = oa - ba * s0; dot(inside, inside) <= radius * radius) {
+				return hit_at(0.f, -direction);
+			}
+
+			if (const float k2 = baba - bard * bard; k2 > 1e-8f) {
+				const float k1 = baba * dot(oa, direction) - baoa * bard;
+				const float k0 = baba * dot(oa, oa) - baoa * baoa - radius * radius * baba;
+				if (const float h = k1 * k1 - k2 * k0; h >= 0.f) {
+					const float t = (-k1 - std::sqrt(h)) / k2;
+					const float y = baoa + t * bard;
+					if (t >= 0.f && t <= max_t && y > 0.f && y < baba) {
+						best = t;
+					}
+				}
+			}
+
+			for (const auto& cap : { a, b }) {
+				if (const auto t = ray_sphere(origin, direction, cap, radius, best.value_or(max_t)); t && (!best || *t < *best)) {
+					best = t;
+				}
+			}
+
+			if (!best) return std::nullopt;
+
+			const vec3f point = origin + direction * *best;
+			const float s = baba > 1e-8f ? std::clamp(dot(point - a, ba) / baba, 0.f, 1.f) : 0.f;
+			const vec3f to_hit = point - (a + ba * s);
+			return hit_at(*best, *best > 0.f && dot(to_hit, to_hit) > 1e-12f ? normalize(to_hit) : -direction);
+		}
+		case shape_type::convex_hull: {
+			const auto o = p.bb.obb();
+			const auto local_origin = inverse_rotate_vector(o.orientation, r.origin - o.center);
+			const auto local_direction = inverse_rotate_vector(o.orientation, direction);
+
+			const auto hit = p.hull->raycast(local_origin, local_direction, meters(max_t));
+			if (!hit) return std::nullopt;
+
+			return hit_at(hit->distance.as<meters>(), rotate_vector(o.orientation, hit->normal));
+		}
+		case shape_type::triangle_mesh:
+		case shape_type::heightfield: {
+			const auto o = p.bb.obb();
+			const auto local_origin = inverse_rotate_vector(o.orientation, r.origin - o.center);
+			const auto local_direction = inverse_rotate_vector(o.orientation, direction);
+
+			std::optional<triangle_hit> hit;
+			if (p.mesh) {
+				hit = p.mesh->raycast(local_origin, local_direction, meters(max_t));
+			}
+			else if (p.field) {
+				hit = p.field->raycast(local_origin, local_direction, meters(max_t));
+			}
+			if (!hit) return std::nullopt;
+
+			const vec3f normal = rotate_vector(o.orientation, hit->triangle.normal);
+			return hit_at(hit->distance.as<meters>(), dot(normal, direction) <= 0.f ? normal : -normal);
+		}
+		default: {
+			const auto o = p.bb.obb();
+			const auto he = to_meters(p.bb.half_extents());
+			const auto diff = r.origin - o.center;
+
+			vec3f local_origin;
+			vec3f local_direction;
+			for (int i = 0; i < 3; ++i) {
+				local_origin[i] = dot(o.axes[i], diff).as<meters>();
+				local_direction[i] = dot(o.axes[i], direction);
+			}
+
+			const auto slab = ray_slab(local_origin, local_direction, -he, he, max_t);
+			if (!slab) return std::nullopt;
+
+			const auto [t, face] = *slab;
+			if (face < 0) {
+				return hit_at(t, -direction);
+			}
+
+			return hit_at(t, face % 2 == 0 ? o.axes[face / 2] : -o.axes[face / 2]);
+		}
+	}
+}
+
+auto gse::physics::scene_query::sweep_proxy(const shape_sweep& s, const proxy& p, const length limit) -> std::optional<query_hit> {
+	constexpr length tolerance = meters(1e-3f);
+
+	const narrow_phase_collision::shape_data target{
+		.bb = &p.bb,
+		.type = p.type,
+		.radius = p.radius,
+		.half_height = p.half_height,
+		.hull = p.hull.get(),
+		.mesh = p.mesh.get(),
+		.field = p.field.get()
+	};
+
+	auto bb = query_box(s.shape, s.start);
+	length t = {};
+
+	for (int i = 0; i < max_sweep_iterations; ++i) {
+		bb.update(s.start + s.direction * t, s.shape.orientation);
+
+		const narrow_phase_collision::shape_data moving{
+			.bb = &bb,
+			.type = s.shape.type,
+			.radius = s.shape.radius,
+			.half_height = s.shape.half_height
+		};
+
+		auto result = narrow_phase_collision::speculative_test(moving, target, limit - t + tolerance);
+		if (!result) return std::nullopt;
+
+		auto sat = *result;
+		if (!is_mesh_shape(p.type) && dot(sat.normal, p.bb.center() - bb.center()) < meters(0.f)) {
+			sat.normal = -sat.normal;
+		}
+
+		if (const length gap = -sat.separation; gap > tolerance) {
+			const float closing = dot(s.direction, sat.normal);
+			if (closing <= 1e-4f) return std::nullopt;
+
+			t += gap / closing;
+			if (t > limit) return std::nullopt;
+			continue;
+		}
+
+		const auto manifold = narrow_phase_collision::generate_shape_manifold(moving, target, sat.normal, sat.separation);
+
+		vec3<length> point = bb.center();
+		if (manifold.point_count > 0) {
+			point = {};
+			for (std::uint32_t k = 0; k < manifold.point_count; ++k) {
+				point += manifold.points[k].position_on_b;
+			}
+			point = point / static_cast<float>(manifold.point_count);
+		}
+
+		return query_hit{
+			.entity = p.entity,
+			.point = point,
+			.normal = -sat.normal,
+			.distance = t
+		};
+	}
+
+	return std::nullopt;
+}
+
+auto gse::physics::scene_query::build_node(const std::uint32_t begin, const std::uint32_t end) -> std::uint32_t {
+	const auto index = static_cast<std::uint32_t>(m_nodes.size());
+	m_nodes.emplace_back();
+
+	aabb bounds = m_proxies[begin].bounds;
+	vec3<length> centroid_min = (bounds.min + bounds.max) * 0.5f;
+	vec3<length> centroid_max = centroid_min;
+
+	for (std::uint32_t i = begin + 1; i < end; ++i) {
+		const auto& b = m_proxies[i].bounds;
+		bounds = merge(bounds, b);
+		const auto c = (b.min + b.max) * 0.5f;
+		centroid_min = min(centroid_min, c);
+		centroid_max = max(centroid_max, c);
+	}
+
+	if (end - begin <= leaf_size) {
+		m_nodes[index] = {
+			.bounds = bounds,
+			.first = begin,
+			.count = end - begin
+		};
+		return index;
+	}
+
+	const auto extent = centroid_max - centroid_min;
+	int axis = extent.x() > extent.y() ? 0 : 1;
+	if (extent.z() > extent[axis]) {
+		axis = 2;
+	}
+
+	const auto mid = begin + (end - begin) / 2;
+	std::nth_element(m_proxies.begin() + begin, m_proxies.begin() + mid, m_proxies.begin() + end, [axis](const proxy& a, const proxy& b) {
+		return a.bounds.min[axis] + a.bounds.max[axis] < b.bounds.min[axis] + b.bounds.max[axis];
+	});
+
+	build_node(begin, mid);
+	const auto right = build_node(mid, end);
+
+	m_nodes[index] = {
+		.bounds = bounds,
+		.first = right,
+		.count = 0
+	};
+	return index;
+}
+
+template <typename Overlaps, typename Visit>
+auto gse::physics::scene_query::traverse(Overlaps&& overlaps, Visit&& visit) const -> void {
+	if (m_nodes.empty()) return;
+
+	std::array<std::uint32_t, 64> stack;
+	std::size_t top = 0;
+	stack[top++] = 0;
+
+	while (top > 0) {
+		const auto index = stack[--top];
+		const auto& n = m_nodes[index];
+
+		if (!overlaps(n.bounds)) continue;
+
+		if (n.count > 0) {
+			for (std::uint32_t i = n.first; i < n.first + n.count; ++i) {
+				visit(m_proxies[i]);
+			}
+			continue;
+		}
+
+		stack[top++] = n.first;
+		stack[top++] = index + 1;
+	}
+}
+
+auto gse::physics::scene_query_buffer::publish(std::shared_ptr<const scene_query> scene) -> void {
+	m_current.store(std::move(scene), std::memory_order_release);
+}
+
+auto gse::physics::scene_query_buffer::acquire() const -> std::shared_ptr<const scene_query> {
+	if (auto scene = m_current.load(std::memory_order_acquire)) {
+		return scene;
+	}
+
+	static const auto empty = std::make_shared<const scene_query>();
+	return empty;
+}
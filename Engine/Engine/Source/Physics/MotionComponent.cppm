@@ -39,6 +39,7 @@ export namespace gse::physics {
         bool can_sleep = true;
         bool sleeping = false;
 		bool update_orientation = true;
+        bool continuous_collision = false;
 
         vec3<length> previous_position;
         quat previous_orientation = quat(1.f, 0.f, 0.f, 0.f);
@@ -0,0 +1,251 @@
+export module gse.physics:simulation_islands;
+
+import std;
+
+import gse.utility;
+import gse.math;
+
+import :vbd_constraints;
+import :vbd_constraint_graph;
+
+export namespace gse::physics {
+	struct island_member {
+		id body;
+		vec3<length> rest_position;
+	};
+
+	struct island {
+		std::vector<island_member> members;
+		bool sleeping = false;
+	};
+
+	class island_manager {
+	public:
+		auto resting_position(
+			id body
+		) const -> std::optional<vec3<length>>;
+
+		auto wake(
+			id body
+		) -> std::vector<id>;
+
+		template <typename F>
+		auto wake_if(
+			F&& disturbed
+		) -> std::vector<id>;
+
+		auto rebuild(
+			std::span<const id> bodies,
+			std::span<const vbd::body_state> states,
+			std::span<const std::uint8_t> can_sleep,
+			const vbd::constraint_graph& graph
+		) -> std::span<const id>;
+
+		auto clear(
+		) -> void;
+
+		auto island_count(
+		) const -> std::size_t;
+
+		auto sleeping_island_count(
+		) const -> std::size_t;
+
+		auto sleeping_body_count(
+		) const -> std::size_t;
+	private:
+		struct body_slot {
+			std::uint32_t island = 0;
+			std::uint32_t member = 0;
+		};
+
+		static constexpr std::uint32_t no_island = std::numeric_limits<std::uint32_t>::max();
+
+		auto acquire(
+		) -> std::uint32_t;
+
+		auto release(
+			std::uint32_t index
+		) -> void;
+
+		auto wake_island(
+			std::uint32_t index,
+			std::vector<id>& woken
+		) -> void;
+
+		auto find_root(
+			std::uint32_t body
+		) -> std::uint32_t;
+
+		std::vector<island> m_islands;
+		std::vector<std::uint32_t> m_free;
+		std::unordered_map<id, body_slot> m_bodies;
+		std::size_t m_sleeping_islands = 0;
+		std::size_t m_sleeping_bodies = 0;
+
+		std::vector<std::uint32_t> m_parent;
+		std::vector<std::uint32_t> m_root_island;
+		std::vector<id> m_fell_asleep;
+	};
+}
+
+auto gse::physics::island_manager::resting_position(const id body) const -> std::optional<vec3<length>> {
+	const auto it = m_bodies.find(body);
+	if (it == m_bodies.end()) {
+		return std::nullopt;
+	}
+
+	const auto& isl = m_islands[it->second.island];
+	if (!isl.sleeping) {
+		return std::nullopt;
+	}
+
+	return isl.members[it->second.member].rest_position;
+}
+
+auto gse::physics::island_manager::wake(const id body) -> std::vector<id> {
+	std::vector<id> woken;
+	if (const auto it = m_bodies.find(body); it != m_bodies.end()) {
+		wake_island(it->second.island, woken);
+	}
+	return woken;
+}
+
+template <typename F>
+auto gse::physics::island_manager::wake_if(F&& disturbed) -> std::vector<id> {
+	std::vector<id> woken;
+	for (std::uint32_t i = 0; i < m_islands.size(); ++i) {
+		if (!m_islands[i].sleeping) continue;
+		if (std::ranges::any_of(m_islands[i].members, [&](const island_member& m) { return std::invoke(disturbed, m); })) {
+			wake_island(i, woken);
+		}
+	}
+	return woken;
+}
+
+auto gse::physics::island_manager::rebuild(const std::span<const id> bodies, const std::span<const vbd::body_state> states, const std::span<const std::uint8_t> can_sleep, const vbd::constraint_graph& graph) -> std::span<const id> {
+	m_fell_asleep.clear();
+
+	for (std::uint32_t i = 0; i < m_islands.size(); ++i) {
+		if (m_islands[i].sleeping || m_islands[i].members.empty()) continue;
+		for (const auto& m : m_islands[i].members) {
+			m_bodies.erase(m.body);
+		}
+		release(i);
+	}
+
+	const auto count = static_cast<std::uint32_t>(bodies.size());
+	m_parent.resize(count);
+	std::iota(m_parent.begin(), m_parent.end(), 0u);
+
+	const auto unite = [&](const std::uint32_t a, const std::uint32_t b) {
+		if (states[a].locked || states[b].locked) return;
+		const auto root_a = find_root(a);
+		const auto root_b = find_root(b);
+		if (root_a != root_b) {
+			m_parent[root_b] = root_a;
+		}
+	};
+
+	for (const auto& c : graph.contact_constraints()) {
+		unite(c.body_a, c.body_b);
+	}
+	for (const auto& j : graph.joint_constraints()) {
+		unite(j.body_a, j.body_b);
+	}
+
+	m_root_island.assign(count, no_island);
+	std::vector<std::uint32_t> created;
+
+	for (std::uint32_t i = 0; i < count; ++i) {
+		if (states[i].locked) continue;
+
+		const auto root = find_root(i);
+		if (m_root_island[root] == no_island) {
+			m_root_island[root] = acquire();
+			m_islands[m_root_island[root]].sleeping = true;
+			created.push_back(m_root_island[root]);
+		}
+
+		auto& isl = m_islands[m_root_island[root]];
+		m_bodies[bodies[i]] = {
+			.island = m_root_island[root],
+			.member = static_cast<std::uint32_t>(isl.members.size())
+		};
+		isl.members.push_back({
+			.body = bodies[i],
+			.rest_position = states[i].position
+		});
+		isl.sleeping = isl.sleeping && can_sleep[i] && states[i].sleeping();
+	}
+
+	for (const auto index : created) {
+		const auto& isl = m_islands[index];
+		if (!isl.sleeping) continue;
+
+		++m_sleeping_islands;
+		m_sleeping_bodies += isl.members.size();
+		for (const auto& m : isl.members) {
+			m_fell_asleep.push_back(m.body);
+		}
+	}
+
+	return m_fell_asleep;
+}
+
+auto gse::physics::island_manager::clear() -> void {
+	m_islands.clear();
+	m_free.clear();
+	m_bodies.clear();
+	m_sleeping_islands = 0;
+	m_sleeping_bodies = 0;
+}
+
+auto gse::physics::island_manager::island_count() const -> std::size_t {
+	return m_islands.size() - m_free.size();
+}
+
+auto gse::physics::island_manager::sleeping_island_count() const -> std::size_t {
+	return m_sleeping_islands;
+}
+
+auto gse::physics::island_manager::sleeping_body_count() const -> std::size_t {
+	return m_sleeping_bodies;
+}
+
+auto gse::physics::island_manager::acquire() -> std::uint32_t {
+	if (!m_free.empty()) {
+		const auto index = m_free.back();
+		m_free.pop_back();
+		return index;
+	}
+
+	m_islands.emplace_back();
+	return static_cast<std::uint32_t>(m_islands.size() - 1);
+}
+
+auto gse::physics::island_manager::release(const std::uint32_t index) -> void {
+	m_islands[index].members.clear();
+	m_islands[index].sleeping = false;
+	m_free.push_back(index);
+}
+
+auto gse::physics::island_manager::wake_island(const std::uint32_t index, std::vector<id>& woken) -> void {
+	auto& isl = m_islands[index];
+	if (!isl.sleeping) return;
+
+	isl.sleeping = false;
+	--m_sleeping_islands;
+	m_sleeping_bodies -= isl.members.size();
+
+	for (const auto& m : isl.members) {
+		woken.push_back(m.body);
+	}
+}
+
+auto gse::physics::island_manager::find_root(std::uint32_t body) -> std::uint32_t {
+	while (m_parent[body] != body) {
+		m_parent[body] = m_parent[m_parent[body]];
+		body = m_parent[body];
+	}
+	return body;
+}
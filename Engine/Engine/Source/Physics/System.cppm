@@ -7,6 +7,9 @@ import gse.log;
 
 import gse.math;
 import gse.platform;
+import :bounding_box;
+import :broad_phase_collision;
+import :scene_query;
 import :narrow_phase_collision;
 import :motion_component;
 import :collision_component;
@@ -15,6 +18,7 @@ import :vbd_constraints;
 import :vbd_contact_cache;
 import :vbd_solver;
 import :vbd_gpu_solver;
+import :simulation_islands;
 
 export namespace gse::physics {
 	struct joint_definition {
@@ -48,6 +52,8 @@ export namespace gse::physics {
 		time_t<float, seconds> accumulator{};
 		bool update_phys = true;
 		bool use_gpu_solver = false;
+		bool parallel_cpu_solver = true;
+		broad_phase_mode broad_phase = broad_phase_mode::dynamic_tree;
 		gpu::context* gpu_ctx = nullptr;
 
 		state() = default;
@@ -58,6 +64,11 @@ export namespace gse::physics {
 		vbd::contact_cache contact_cache;
 		std::unordered_map<id, std::uint32_t> sleep_counters;
 		std::vector<joint_definition> joints;
+		island_manager islands;
+
+		dynamic_aabb_tree broad_phase_tree;
+		broad_phase_stats last_broad_phase;
+		scene_query_buffer queries;
 
 		bool compare_solvers = false;
 		interval_timer<> comparison_timer{ seconds(0.25f) };
@@ -67,6 +78,18 @@ export namespace gse::physics {
 		};
 		std::optional<solver_comparison_snapshot> comparison_pending;
 
+		struct narrow_phase_hit {
+			std::uint32_t pair_index = 0;
+			narrow_phase_collision::sat_result sat;
+			contact_manifold manifold;
+		};
+
+		struct narrow_phase_scratch {
+			std::vector<narrow_phase_hit> pair_hits;
+			std::vector<std::uint8_t> pair_found;
+			std::vector<narrow_phase_hit> hits;
+		} narrow_phase;
+
 		struct gpu_prev_frame {
 			std::vector<vbd::body_state> result_bodies;
 			std::vector<id> result_entity_ids;
@@ -117,62 +140,327 @@ namespace gse::physics {
 		motion_component* motion;
 	};
 
+	auto find_candidate_pairs(
+		state& s,
+		std::span<const collision_pair> objects,
+		length margin,
+		std::vector<broad_phase_pair>& pairs,
+		std::span<const std::uint8_t> awake = {},
+		time_t<float, seconds> sweep_time = {}
+	) -> broad_phase_stats;
+
+	auto broad_phase_bounds(
+		const collision_pair& object,
+		time_t<float, seconds> sweep_time
+	) -> aabb;
+
+	auto sweep_time_of_impact(
+		const collision_pair& moving,
+		const collision_pair& other,
+		const vec3<length>& start,
+		const vec3<length>& end
+	) -> std::optional<float>;
+
+	auto resolve_continuous_collisions(
+		std::span<const collision_pair> objects,
+		std::span<const broad_phase_pair> pairs,
+		length margin
+	) -> void;
+
+	auto wake_island(
+		state& s,
+		chunk<motion_component>& motion,
+		id body,
+		bool reset_sleep
+	) -> void;
+
+	auto wake_disturbed_islands(
+		state& s,
+		chunk<motion_component>& motion
+	) -> void;
+
+	auto run_narrow_phase(
+		state& s,
+		std::span<const collision_pair> objects,
+		std::span<const broad_phase_pair> pairs,
+		length margin
+	) -> std::span<const state::narrow_phase_hit>;
+
 	auto refresh_airborne_from_collisions(state& s, chunk<motion_component>& motion, chunk<collision_component>& collision) -> void {
 		std::vector<collision_pair> objects;
 		objects.reserve(collision.size());
 
-		for (collision_component& cc : collision) {
+		for (auto [cc, mc] : view(collision, motion)) {
 			if (!cc.resolve_collisions) continue;
-			auto* mc = motion.find(cc.owner_id());
-			if (!mc) continue;
 			objects.push_back({
 				.collision = std::addressof(cc),
-				.motion = mc
+				.motion = std::addressof(mc)
 			});
-			if (!mc->position_locked) {
-				mc->airborne = true;
+			if (!mc.position_locked) {
+				mc.airborne = true;
 			}
 		}
 
 		const auto speculative_margin = s.vbd_solver.config().speculative_margin;
-		for (std::size_t i = 0; i < objects.size(); ++i) {
-			for (std::size_t j = i + 1; j < objects.size(); ++j) {
-				auto& [collision_a, motion_a] = objects[i];
-				auto& [collision_b, motion_b] = objects[j];
-
-				const auto& aabb_a = collision_a->bounding_box.aabb();
-				const auto& aabb_b = collision_b->bounding_box.aabb();
-				if (!aabb_a.overlaps(aabb_b, speculative_margin)) continue;
-
-				const narrow_phase_collision::shape_data sd_a{
-					.bb = &collision_a->bounding_box,
-					.type = collision_a->shape,
-					.radius = collision_a->shape_radius,
-					.half_height = collision_a->shape_half_height
-				};
-				const narrow_phase_collision::shape_data sd_b{
-					.bb = &collision_b->bounding_box,
-					.type = collision_b->shape,
-					.radius = collision_b->shape_radius,
-					.half_height = collision_b->shape_half_height
-				};
-
-				auto sat_result = narrow_phase_collision::speculative_test(sd_a, sd_b, speculative_margin);
-				if (!sat_result) continue;
-
-				auto sat = *sat_result;
-				if (dot(sat.normal, collision_b->bounding_box.center() - collision_a->bounding_box.center()) < meters(0.f)) {
-					sat.normal = -sat.normal;
-				}
+		std::vector<broad_phase_pair> pairs;
+		find_candidate_pairs(s, objects, speculative_margin, pairs);
 
-				if (sat.normal.y() > 0.7f && motion_b && !motion_b->position_locked) {
-					motion_b->airborne = false;
+		for (const auto& [i, j] : pairs) {
+			auto& [collision_a, motion_a] = objects[i];
+			auto& [collision_b, motion_b] = objects[j];
+
+			const auto sd_a = narrow_phase_collision::shape_of(*collision_a);
+			const auto sd_b = narrow_phase_collision::shape_of(*collision_b);
+
+			auto sat_result = narrow_phase_collision::speculative_test(sd_a, sd_b, speculative_margin);
+			if (!sat_result) continue;
+
+			auto sat = *sat_result;
+			if (!is_mesh_shape(sd_a.type) && !is_mesh_shape(sd_b.type) && dot(sat.normal, collision_b->bounding_box.center() - collision_a->bounding_box.center()) < meters(0.f)) {
+				sat.normal = -sat.normal;
+			}
+
+			if (sat.normal.y() > 0.7f && motion_b && !motion_b->position_locked) {
+				motion_b->airborne = false;
+			}
+			if (sat.normal.y() < -0.7f && motion_a && !motion_a->position_locked) {
+				motion_a->airborne = false;
+			}
+		}
+	}
+
+	auto find_candidate_pairs(state& s, const std::span<const collision_pair> objects, const length margin, std::vector<broad_phase_pair>& pairs, const std::span<const std::uint8_t> awake, const time_t<float, seconds> sweep_time) -> broad_phase_stats {
+		clock timer;
+		pairs.clear();
+
+		if (s.broad_phase == broad_phase_mode::brute_force) {
+			for (std::uint32_t i = 0; i < objects.size(); ++i) {
+				for (std::uint32_t j = i + 1; j < objects.size(); ++j) {
+					if (!awake.empty() && !awake[i] && !awake[j]) continue;
+					const auto aabb_a = broad_phase_bounds(objects[i], sweep_time);
+					const auto aabb_b = broad_phase_bounds(objects[j], sweep_time);
+					if (!aabb_a.overlaps(aabb_b, margin)) continue;
+					pairs.push_back({ i, j });
 				}
-				if (sat.normal.y() < -0.7f && motion_a && !motion_a->position_locked) {
-					motion_a->airborne = false;
+			}
+		}
+		else {
+			std::vector<aabb> bounds;
+			bounds.reserve(objects.size());
+
+			s.broad_phase_tree.begin_update();
+			for (std::uint32_t i = 0; i < objects.size(); ++i) {
+				const auto box = broad_phase_bounds(objects[i], sweep_time);
+				bounds.push_back(box);
+				s.broad_phase_tree.update(objects[i].collision->owner_id(), box, i);
+			}
+			s.broad_phase_tree.end_update();
+			s.broad_phase_tree.find_pairs(bounds, margin, pairs, awake);
+		}
+
+		return {
+			.mode = s.broad_phase,
+			.proxy_count = static_cast<std::uint32_t>(objects.size()),
+			.candidate_pairs = static_cast<std::uint32_t>(pairs.size()),
+			.time = timer.elapsed<float>()
+		};
+	}
+
+	auto broad_phase_bounds(const collision_pair& object, const time_t<float, seconds> sweep_time) -> aabb {
+		auto bounds = object.collision->bounding_box.aabb();
+
+		const auto* mc = object.motion;
+		if (!mc || !mc->continuous_collision || mc->position_locked || mc->sleeping) {
+			return bounds;
+		}
+
+		const vec3<length> travel = mc->current_velocity * sweep_time;
+		bounds.min = min(bounds.min, bounds.min + travel);
+		bounds.max = max(bounds.max, bounds.max + travel);
+		return bounds;
+	}
+
+	auto sweep_time_of_impact(const collision_pair& moving, const collision_pair& other, const vec3<length>& start, const vec3<length>& end) -> std::optional<float> {
+		constexpr length tolerance = meters(1e-3f);
+		constexpr int max_iterations = 32;
+
+		const length distance = magnitude(end - start);
+		const vec3f direction = normalize(end - start);
+
+		auto bb = moving.collision->bounding_box;
+		auto sd_moving = narrow_phase_collision::shape_of(*moving.collision);
+		sd_moving.bb = &bb;
+		const auto sd_other = narrow_phase_collision::shape_of(*other.collision);
+
+		length travelled = {};
+		for (int i = 0; i < max_iterations; ++i) {
+			bb.update(start + direction * travelled, moving.motion->orientation);
+
+			auto result = narrow_phase_collision::speculative_test(sd_moving, sd_other, distance - travelled + tolerance);
+			if (!result) return std::nullopt;
+
+			auto sat = *result;
+			if (!is_mesh_shape(sd_moving.type) && !is_mesh_shape(sd_other.type) && dot(sat.normal, other.collision->bounding_box.center() - bb.center()) < meters(0.f)) {
+				sat.normal = -sat.normal;
+			}
+
+			if (const length gap = -sat.separation; gap > tolerance) {
+				const float closing = dot(direction, sat.normal);
+				if (closing <= 1e-4f) return std::nullopt;
+
+				travelled += gap / closing;
+				if (travelled > distance) return std::nullopt;
+				continue;
+			}
+
+			if (i == 0) return std::nullopt;
+			break;
+		}
+
+		const float fraction = travelled / distance;
+		return fraction;
+	}
+
+	auto resolve_continuous_collisions(const std::span<const collision_pair> objects, const std::span<const broad_phase_pair> pairs, const length margin) -> void {
+		std::vector<float> earliest(objects.size(), 1.f);
+
+		const auto sweep = [&](const std::uint32_t moving, const std::uint32_t other) {
+			const auto* mc = objects[moving].motion;
+			if (!mc->continuous_collision || mc->position_locked || mc->sleeping) return;
+			if (magnitude(mc->current_position - mc->previous_position) <= margin) return;
+
+			if (const auto t = sweep_time_of_impact(objects[moving], objects[other], mc->previous_position, mc->current_position)) {
+				earliest[moving] = std::min(earliest[moving], *t);
+			}
+		};
+
+		for (const auto& [a, b] : pairs) {
+			sweep(a, b);
+			sweep(b, a);
+		}
+
+		for (std::size_t i = 0; i < objects.size(); ++i) {
+			if (earliest[i] >= 1.f) continue;
+
+			auto& [cc, mc] = objects[i];
+			mc->current_position = mc->previous_position + (mc->current_position - mc->previous_position) * earliest[i];
+			cc->bounding_box.update(mc->current_position, mc->orientation);
+		}
+	}
+
+	auto wake_island(state& s, chunk<motion_component>& motion, const id body, const bool reset_sleep) -> void {
+		auto woken = s.islands.wake(body);
+		if (woken.empty()) {
+			woken.push_back(body);
+		}
+
+		for (const auto eid : woken) {
+			if (reset_sleep) {
+				s.sleep_counters[eid] = 0;
+			}
+			if (auto* mc = motion.find(eid)) {
+				mc->sleeping = false;
+			}
+		}
+	}
+
+	auto wake_disturbed_islands(state& s, chunk<motion_component>& motion) -> void {
+		const auto& cfg = s.vbd_solver.config();
+
+		std::vector<id> disturbed;
+		std::size_t tracked = 0;
+
+		for (motion_component& mc : motion) {
+			if (mc.position_locked || !mc.sleeping) continue;
+
+			const auto rest = s.islands.resting_position(mc.owner_id());
+			if (rest) {
+				++tracked;
+			}
+
+			const bool resting =
+				rest &&
+				magnitude(mc.current_position - *rest) < meters(1e-4f) &&
+				magnitude(mc.current_velocity) < cfg.velocity_sleep_threshold &&
+				magnitude(mc.pending_impulse) <= meters_per_second(1e-6f) &&
+				!(mc.velocity_drive_active && magnitude(mc.velocity_drive_target) > meters_per_second(.01f));
+
+			if (!resting) {
+				disturbed.push_back(mc.owner_id());
+			}
+		}
+
+		if (tracked < s.islands.sleeping_body_count()) {
+			for (const auto eid : s.islands.wake_if([&](const island_member& m) {
+				const auto* mc = motion.find(m.body);
+				return !mc || !mc->sleeping;
+			})) {
+				s.sleep_counters[eid] = 0;
+				if (auto* mc = motion.find(eid)) {
+					mc->sleeping = false;
 				}
 			}
 		}
+
+		for (const auto eid : disturbed) {
+			wake_island(s, motion, eid, true);
+		}
+
+		for (const auto& jd : s.joints) {
+			auto* mc_a = motion.find(jd.entity_a);
+			auto* mc_b = motion.find(jd.entity_b);
+			if (!mc_a || !mc_b || mc_a->position_locked || mc_b->position_locked) continue;
+
+			if (mc_a->sleeping != mc_b->sleeping) {
+				wake_island(s, motion, mc_a->sleeping ? jd.entity_a : jd.entity_b, false);
+			}
+		}
+	}
+
+	auto run_narrow_phase(state& s, const std::span<const collision_pair> objects, const std::span<const broad_phase_pair> pairs, const length margin) -> std::span<const state::narrow_phase_hit> {
+		auto& [pair_hits, pair_found, hits] = s.narrow_phase;
+
+		pair_hits.resize(pairs.size());
+		pair_found.assign(pairs.size(), 0);
+
+		task::parallel_for(0uz, pairs.size(), [&](const std::size_t k) {
+			const auto* collision_a = objects[pairs[k].a].collision;
+			const auto* collision_b = objects[pairs[k].b].collision;
+
+			const auto sd_a = narrow_phase_collision::shape_of(*collision_a);
+			const auto sd_b = narrow_phase_collision::shape_of(*collision_b);
+
+			auto sat_result = narrow_phase_collision::speculative_test(sd_a, sd_b, margin);
+			if (!sat_result) return;
+
+			auto& sat = *sat_result;
+
+			if (!is_mesh_shape(sd_a.type) && !is_mesh_shape(sd_b.type) && dot(sat.normal, collision_b->bounding_box.center() - collision_a->bounding_box.center()) < meters(0.f)) {
+				sat.normal = -sat.normal;
+			}
+
+			auto manifold = narrow_phase_collision::generate_shape_manifold(
+				sd_a, sd_b, sat.normal, sat.separation
+			);
+
+			if (manifold.point_count == 0) return;
+
+			pair_hits[k] = {
+				.pair_index = static_cast<std::uint32_t>(k),
+				.sat = sat,
+				.manifold = manifold
+			};
+			pair_found[k] = 1;
+		});
+
+		hits.clear();
+		for (std::size_t k = 0; k < pairs.size(); ++k) {
+			if (pair_found[k]) {
+				hits.push_back(pair_hits[k]);
+			}
+		}
+
+		return hits;
 	}
 
 	struct contact_compare_key {
@@ -284,6 +572,14 @@ auto gse::physics::system::initialize(const initialize_phase& phase, state& s) -
 		.type = typeid(bool)
 	});
 
+	phase.channels.push(save::register_property{
+		.category = "Physics",
+		.name = "Parallel CPU Solver",
+		.description = "Solve each VBD color group across worker threads",
+		.ref = &s.parallel_cpu_solver,
+		.type = typeid(bool)
+	});
+
 	phase.channels.push(save::register_property{
 		.category = "Physics",
 		.name = "Compare Solvers",
@@ -292,6 +588,18 @@ auto gse::physics::system::initialize(const initialize_phase& phase, state& s) -
 		.type = typeid(bool)
 	});
 
+	phase.channels.push(save::register_property{
+		.category = "Physics",
+		.name = "Broad Phase",
+		.description = "Candidate pair generation used before the narrow phase",
+		.ref = reinterpret_cast<int*>(&s.broad_phase),
+		.type = typeid(int),
+		.enum_options = {
+			{"Brute Force", static_cast<int>(broad_phase_mode::brute_force)},
+			{"Dynamic AABB Tree", static_cast<int>(broad_phase_mode::dynamic_tree)}
+		}
+	});
+
 	s.vbd_solver.configure(vbd::solver_config{
 		.iterations = 10,
 		.alpha = 0.99f,
@@ -305,7 +613,8 @@ auto gse::physics::system::initialize(const initialize_phase& phase, state& s) -
 		.friction_coefficient = 0.6f,
 		.velocity_sleep_threshold = meters_per_second(0.05f),
 		.angular_sleep_threshold = radians_per_second(0.05f),
-		.speculative_margin = meters(0.02f)
+		.speculative_margin = meters(0.02f),
+		.parallel_colors = s.parallel_cpu_solver
 	});
 
 	if (s.gpu_ctx) {
@@ -336,6 +645,9 @@ auto gse::physics::system::update(update_phase& phase, state& s) -> void {
 	if (s.use_gpu_solver) {
 		phase.schedule([steps, frame_time, &s, const_update_time](chunk<motion_component> motion, chunk<collision_component> collision) {
 			update_vbd_gpu(steps, s, motion, collision, const_update_time);
+			if (steps > 0) {
+				s.queries.publish(scene_query::build(collision, motion));
+			}
 
 			const float blend = std::min(frame_time / (const_update_time * 2.f), 1.f);
 
@@ -355,6 +667,9 @@ auto gse::physics::system::update(update_phase& phase, state& s) -> void {
 
 	phase.schedule([steps, alpha, &s](chunk<motion_component> motion, chunk<collision_component> collision) {
 		update_vbd(steps, s, motion, collision);
+		if (steps > 0) {
+			s.queries.publish(scene_query::build(collision, motion));
+		}
 
 		for (motion_component& mc : motion) {
 			if (mc.position_locked) {
@@ -753,40 +1068,112 @@ auto gse::physics::update_vbd_gpu(const int steps, state& s, chunk<motion_compon
 auto gse::physics::update_vbd(const int steps, state& s, chunk<motion_component>& motion, chunk<collision_component>& collision) -> void {
 	const time_t<float, seconds> const_update_time = system_clock::constant_update_time<time_t<float, seconds>>();
 
-	std::unordered_map<id, std::uint32_t> id_to_body_index;
-	id_to_body_index.reserve(motion.size());
-	std::vector<motion_component*> motion_ptrs;
-	motion_ptrs.reserve(motion.size());
-
-	{
-		std::uint32_t body_idx = 0;
-		for (motion_component& mc : motion) {
-			id_to_body_index[mc.owner_id()] = body_idx++;
-			motion_ptrs.push_back(std::addressof(mc));
-		}
+	if (s.vbd_solver.config().parallel_colors != s.parallel_cpu_solver) {
+		auto cfg = s.vbd_solver.config();
+		cfg.parallel_colors = s.parallel_cpu_solver;
+		s.vbd_solver.configure(cfg);
 	}
 
+	constexpr std::uint32_t no_body = std::numeric_limits<std::uint32_t>::max();
+
+	const auto motion_index = [&](const motion_component* mc) {
+		return mc ? static_cast<std::uint32_t>(motion.index_of(*mc)) : no_body;
+	};
+
 	std::vector<collision_pair> objects;
 	objects.reserve(collision.size());
-	for (collision_component& cc : collision) {
+	std::vector<collision_component*> body_collisions(motion.size(), nullptr);
+	for (auto [cc, mc] : view(collision, motion)) {
+		body_collisions[motion.index_of(mc)] = std::addressof(cc);
 		if (!cc.resolve_collisions) continue;
 		objects.push_back({
 			.collision = std::addressof(cc),
-			.motion = motion.find(cc.owner_id())
+			.motion = std::addressof(mc)
 		});
 	}
 
+	std::vector<std::uint8_t> object_awake(objects.size());
+	std::vector<std::uint32_t> body_of(motion.size());
+	std::vector<std::uint32_t> solved;
+	std::vector<std::size_t> active_joints;
+	std::vector<broad_phase_pair> pairs;
+
+	const auto classify_objects = [&] {
+		for (std::size_t i = 0; i < objects.size(); ++i) {
+			const auto* mc = objects[i].motion;
+			object_awake[i] = !mc->position_locked && !mc->sleeping;
+		}
+	};
 
 	for (int step = 0; step < steps; ++step) {
-		std::vector<vbd::body_state> bodies;
-		bodies.reserve(motion.size());
+		wake_disturbed_islands(s, motion);
+
+		classify_objects();
+		auto broad_phase = find_candidate_pairs(s, objects, s.vbd_solver.config().speculative_margin, pairs, object_awake, const_update_time);
+
+		for (bool woke = true; woke; ) {
+			woke = false;
+			for (const auto& [a, b] : pairs) {
+				for (const auto k : { a, b }) {
+					if (const auto* mc = objects[k].motion; !mc->position_locked && mc->sleeping) {
+						wake_island(s, motion, mc->owner_id(), false);
+						woke = true;
+					}
+				}
+			}
+
+			if (woke) {
+				classify_objects();
+				broad_phase = find_candidate_pairs(s, objects, s.vbd_solver.config().speculative_margin, pairs, object_awake, const_update_time);
+			}
+		}
+
+		s.last_broad_phase = broad_phase;
+		static const id candidate_pairs_counter = find_or_generate_id("physics.broad_phase.candidate_pairs");
+		static const id broad_phase_ms_counter = find_or_generate_id("physics.broad_phase.ms");
+		trace::counter(candidate_pairs_counter, static_cast<double>(broad_phase.candidate_pairs));
+		trace::counter(broad_phase_ms_counter, static_cast<double>(broad_phase.time.as<milliseconds>()));
+
+		std::ranges::fill(body_of, no_body);
+		solved.clear();
+
+		const auto include = [&](const std::uint32_t index) {
+			if (index == no_body || body_of[index] != no_body) return;
+			body_of[index] = static_cast<std::uint32_t>(solved.size());
+			solved.push_back(index);
+		};
 
 		for (motion_component& mc : motion) {
+			if (mc.position_locked || mc.sleeping) continue;
+			include(motion_index(std::addressof(mc)));
+		}
+
+		for (const auto& [a, b] : pairs) {
+			include(motion_index(objects[a].motion));
+			include(motion_index(objects[b].motion));
+		}
+
+		active_joints.clear();
+		for (std::size_t j = 0; j < s.joints.size(); ++j) {
+			const auto index_a = motion_index(motion.find(s.joints[j].entity_a));
+			const auto index_b = motion_index(motion.find(s.joints[j].entity_b));
+			if (index_a == no_body || index_b == no_body) continue;
+			if (body_of[index_a] == no_body && body_of[index_b] == no_body) continue;
+
+			include(index_a);
+			include(index_b);
+			active_joints.push_back(j);
+		}
+
+		std::vector<vbd::body_state> bodies;
+		bodies.reserve(solved.size());
+
+		for (const auto index : solved) {
+			auto& mc = motion[index];
 			mc.previous_position = mc.current_position;
 			mc.previous_orientation = mc.orientation;
 
-			const auto eid = mc.owner_id();
-			const auto sc_it = s.sleep_counters.find(eid);
+			const auto sc_it = s.sleep_counters.find(mc.owner_id());
 			const auto sc = sc_it != s.sleep_counters.end() ? sc_it->second : 0u;
 
 			bodies.push_back({
@@ -812,10 +1199,10 @@ auto gse::physics::update_vbd(const int steps, state& s, chunk<motion_component>
 			mc.airborne = true;
 		}
 
-		for (collision_component& cc : collision) {
-			if (!cc.resolve_collisions) continue;
+		for (const auto& [cc, mc] : objects) {
+			if (!mc->position_locked && mc->sleeping) continue;
 
-			cc.collision_information = {
+			cc->collision_information = {
 				.colliding = false,
 				.collision_normal = {},
 				.penetration = {},
@@ -825,168 +1212,124 @@ auto gse::physics::update_vbd(const int steps, state& s, chunk<motion_component>
 
 		s.vbd_solver.begin_frame(bodies, s.contact_cache);
 
-		for (std::size_t i = 0; i < objects.size(); ++i) {
-			for (std::size_t j = i + 1; j < objects.size(); ++j) {
-				auto& [collision_a, motion_a] = objects[i];
-				auto& [collision_b, motion_b] = objects[j];
-
-				const auto& aabb_a = collision_a->bounding_box.aabb();
-				const auto& aabb_b = collision_b->bounding_box.aabb();
-
-				if (!aabb_a.overlaps(aabb_b, s.vbd_solver.config().speculative_margin)) continue;
-
-				const narrow_phase_collision::shape_data sd_a{
-					.bb = &collision_a->bounding_box,
-					.type = collision_a->shape,
-					.radius = collision_a->shape_radius,
-					.half_height = collision_a->shape_half_height
-				};
-				const narrow_phase_collision::shape_data sd_b{
-					.bb = &collision_b->bounding_box,
-					.type = collision_b->shape,
-					.radius = collision_b->shape_radius,
-					.half_height = collision_b->shape_half_height
-				};
-
-				auto sat_result = narrow_phase_collision::speculative_test(
-					sd_a, sd_b, s.vbd_solver.config().speculative_margin
-				);
-
-				if (!sat_result) continue;
-
-				auto& sat = *sat_result;
-
-				if (dot(sat.normal, collision_b->bounding_box.center() - collision_a->bounding_box.center()) < meters(0.f)) {
-					sat.normal = -sat.normal;
-				}
-
-				auto manifold = narrow_phase_collision::generate_shape_manifold(
-					sd_a, sd_b, sat.normal, sat.separation
-				);
+		for (const auto& [pair_index, sat, manifold] : run_narrow_phase(s, objects, pairs, s.vbd_solver.config().speculative_margin)) {
+			auto& [collision_a, motion_a] = objects[pairs[pair_index].a];
+			auto& [collision_b, motion_b] = objects[pairs[pair_index].b];
 
-				if (manifold.point_count == 0) continue;
+			const auto index_a = motion_index(motion_a);
+			const auto index_b = motion_index(motion_b);
+			const auto body_a = body_of[index_a];
+			const auto body_b = body_of[index_b];
 
-				const auto id_a = collision_a->owner_id();
-				const auto id_b = collision_b->owner_id();
-
-				const auto it_a = id_to_body_index.find(id_a);
-				const auto it_b = id_to_body_index.find(id_b);
-				if (it_a == id_to_body_index.end() || it_b == id_to_body_index.end()) continue;
-
-				const std::uint32_t body_a = it_a->second;
-				const std::uint32_t body_b = it_b->second;
+			if (sat.normal.y() > 0.7f && motion_b) {
+				motion_b->airborne = false;
+			}
+			if (sat.normal.y() < -0.7f && motion_a) {
+				motion_a->airborne = false;
+			}
 
-				if (sat.normal.y() > 0.7f && motion_b) {
-					motion_b->airborne = false;
-				}
-				if (sat.normal.y() < -0.7f && motion_a) {
-					motion_a->airborne = false;
-				}
+			collision_a->collision_information.colliding = true;
+			collision_a->collision_information.collision_normal = sat.normal;
+			collision_a->collision_information.penetration = -sat.separation;
 
-				collision_a->collision_information.colliding = true;
-				collision_a->collision_information.collision_normal = sat.normal;
-				collision_a->collision_information.penetration = -sat.separation;
+			collision_b->collision_information.colliding = true;
+			collision_b->collision_information.collision_normal = -sat.normal;
+			collision_b->collision_information.penetration = -sat.separation;
 
-				collision_b->collision_information.colliding = true;
-				collision_b->collision_information.collision_normal = -sat.normal;
-				collision_b->collision_information.penetration = -sat.separation;
+			const auto& cfg = s.vbd_solver.config();
+			const vec3f constraint_normal = -sat.normal;
 
-				const auto& cfg = s.vbd_solver.config();
-				const vec3f constraint_normal = -sat.normal;
+			const auto& bs_a = s.vbd_solver.body_states()[body_a];
+			const auto& bs_b = s.vbd_solver.body_states()[body_b];
+			const stiffness penalty_floor = cfg.penalty_min;
 
-				const auto& bs_a = s.vbd_solver.body_states()[body_a];
-				const auto& bs_b = s.vbd_solver.body_states()[body_b];
-				const stiffness penalty_floor = cfg.penalty_min;
+			for (std::uint32_t p = 0; p < manifold.point_count; ++p) {
+				const auto& [position_on_a, position_on_b, normal, separation, feature] = manifold.points[p];
 
-				for (std::uint32_t p = 0; p < manifold.point_count; ++p) {
-					const auto& [position_on_a, position_on_b, normal, separation, feature] = manifold.points[p];
+				const vec3<length> world_r_a = position_on_a - bs_a.position;
+				const vec3<length> world_r_b = position_on_b - bs_b.position;
 
-					const vec3<length> world_r_a = position_on_a - bs_a.position;
-					const vec3<length> world_r_b = position_on_b - bs_b.position;
+				vec3<length> local_r_a = inverse_rotate_vector(bs_a.orientation, world_r_a);
+				vec3<length> local_r_b = inverse_rotate_vector(bs_b.orientation, world_r_b);
 
-					vec3<length> local_r_a = inverse_rotate_vector(bs_a.orientation, world_r_a);
-					vec3<length> local_r_b = inverse_rotate_vector(bs_b.orientation, world_r_b);
+				auto cached = s.contact_cache.lookup(index_a, index_b, feature);
+				const vec3<length> current_d = position_on_a - position_on_b;
+				const length current_normal_gap = dot(constraint_normal, current_d) + cfg.collision_margin;
+				const bool reuse_cached_normal =
+					cached &&
+					(cached->lambda[0] < newtons(-1e-3f) || current_normal_gap < meters(-1e-4f));
+				const bool reuse_cached_tangent =
+					reuse_cached_normal &&
+					cached.has_value();
+				const bool reuse_cached_sticking =
+					reuse_cached_tangent &&
+					cached->sticking;
 
-					auto cached = s.contact_cache.lookup(body_a, body_b, feature);
-					const vec3<length> current_d = position_on_a - position_on_b;
-					const length current_normal_gap = dot(constraint_normal, current_d) + cfg.collision_margin;
-					const bool reuse_cached_normal =
-						cached &&
-						(cached->lambda[0] < newtons(-1e-3f) || current_normal_gap < meters(-1e-4f));
-					const bool reuse_cached_tangent =
-						reuse_cached_normal &&
-						cached.has_value();
-					const bool reuse_cached_sticking =
-						reuse_cached_tangent &&
-						cached->sticking;
+				vec3<force> init_lambda;
+				vec3<stiffness> init_penalty = { penalty_floor, penalty_floor, penalty_floor };
 
-					vec3<force> init_lambda;
-					vec3<stiffness> init_penalty = { penalty_floor, penalty_floor, penalty_floor };
+				if (reuse_cached_normal) {
+					init_penalty[0] = std::max(cached->penalty[0], penalty_floor);
 
-					if (reuse_cached_normal) {
-						init_penalty[0] = std::max(cached->penalty[0], penalty_floor);
+					const vec3<force> cached_normal_force = cached->normal * cached->lambda[0];
+					init_lambda[0] = std::min(dot(cached_normal_force, constraint_normal), force{});
+				}
 
-						const vec3<force> cached_normal_force = cached->normal * cached->lambda[0];
-						init_lambda[0] = std::min(dot(cached_normal_force, constraint_normal), force{});
-					}
+				if (reuse_cached_tangent) {
+					init_penalty[1] = std::max(cached->penalty[1], penalty_floor);
+					init_penalty[2] = std::max(cached->penalty[2], penalty_floor);
 
-					if (reuse_cached_tangent) {
-						init_penalty[1] = std::max(cached->penalty[1], penalty_floor);
-						init_penalty[2] = std::max(cached->penalty[2], penalty_floor);
+					const vec3<force> cached_tangent_force =
+						cached->tangent_u * cached->lambda[1] +
+						cached->tangent_v * cached->lambda[2];
 
-						const vec3<force> cached_tangent_force =
-							cached->tangent_u * cached->lambda[1] +
-							cached->tangent_v * cached->lambda[2];
+					init_lambda[1] = dot(cached_tangent_force, manifold.tangent_u);
+					init_lambda[2] = dot(cached_tangent_force, manifold.tangent_v);
 
-						init_lambda[1] = dot(cached_tangent_force, manifold.tangent_u);
-						init_lambda[2] = dot(cached_tangent_force, manifold.tangent_v);
+					const force friction_bound = abs(init_lambda[0]) * cfg.friction_coefficient;
+					init_lambda[1] = std::clamp(init_lambda[1], -friction_bound, friction_bound);
+					init_lambda[2] = std::clamp(init_lambda[2], -friction_bound, friction_bound);
+				}
 
-						const force friction_bound = abs(init_lambda[0]) * cfg.friction_coefficient;
-						init_lambda[1] = std::clamp(init_lambda[1], -friction_bound, friction_bound);
-						init_lambda[2] = std::clamp(init_lambda[2], -friction_bound, friction_bound);
-					}
+				if (reuse_cached_sticking) {
+					local_r_a = cached->local_anchor_a;
+					local_r_b = cached->local_anchor_b;
+				}
 
-					if (reuse_cached_sticking) {
-						local_r_a = cached->local_anchor_a;
-						local_r_b = cached->local_anchor_b;
-					}
+				const float pair_restitution = std::max(
+					motion_a ? motion_a->restitution : 0.f,
+					motion_b ? motion_b->restitution : 0.f
+				);
 
-					const float pair_restitution = std::max(
-						motion_a ? motion_a->restitution : 0.f,
-						motion_b ? motion_b->restitution : 0.f
-					);
-
-					s.vbd_solver.add_contact_constraint(vbd::contact_constraint{
-						.body_a = body_a,
-						.body_b = body_b,
-						.normal = constraint_normal,
-						.tangent_u = manifold.tangent_u,
-						.tangent_v = manifold.tangent_v,
-						.r_a = local_r_a,
-						.r_b = local_r_b,
-						.c0 = { separation, 0.f, 0.f },
-						.lambda = init_lambda,
-						.penalty = init_penalty,
-						.penalty_floor = penalty_floor,
-						.friction_coeff = cfg.friction_coefficient,
-						.restitution = pair_restitution,
-						.sticking = cached ? cached->sticking : false,
-						.feature = feature
-					});
-
-					collision_a->collision_information.collision_points.push_back(position_on_a);
-				}
+				s.vbd_solver.add_contact_constraint(vbd::contact_constraint{
+					.body_a = body_a,
+					.body_b = body_b,
+					.normal = constraint_normal,
+					.tangent_u = manifold.tangent_u,
+					.tangent_v = manifold.tangent_v,
+					.r_a = local_r_a,
+					.r_b = local_r_b,
+					.c0 = { separation, 0.f, 0.f },
+					.lambda = init_lambda,
+					.penalty = init_penalty,
+					.penalty_floor = penalty_floor,
+					.friction_coeff = cfg.friction_coefficient,
+					.restitution = pair_restitution,
+					.sticking = cached ? cached->sticking : false,
+					.feature = feature
+				});
+
+				collision_a->collision_information.collision_points.push_back(position_on_a);
 			}
 		}
 
-		for (motion_component& mc : motion) {
+		for (const auto index : solved) {
+			const auto& mc = motion[index];
 			if (!mc.velocity_drive_active) continue;
 			if (mc.airborne) continue;
-			const auto it = id_to_body_index.find(mc.owner_id());
-			if (it == id_to_body_index.end()) continue;
 
 			s.vbd_solver.add_motor_constraint(vbd::velocity_motor_constraint{
-				.body_index = it->second,
+				.body_index = body_of[index],
 				.target_velocity = mc.velocity_drive_target,
 				.compliance = 0.5f,
 				.max_force = newtons(mc.mass.as<kilograms>() * 50.f),
@@ -994,19 +1337,19 @@ auto gse::physics::update_vbd(const int steps, state& s, chunk<motion_component>
 			});
 		}
 
-		for (auto& jd : s.joints) {
-			const auto it_a = id_to_body_index.find(jd.entity_a);
-			const auto it_b = id_to_body_index.find(jd.entity_b);
-			if (it_a == id_to_body_index.end() || it_b == id_to_body_index.end()) continue;
+		for (const auto j : active_joints) {
+			auto& jd = s.joints[j];
+			const auto body_a = body_of[motion_index(motion.find(jd.entity_a))];
+			const auto body_b = body_of[motion_index(motion.find(jd.entity_b))];
 
 			if (!jd.rest_orientation_initialized && jd.type != vbd::joint_type::distance) {
-				jd.rest_orientation = bodies[it_b->second].orientation * conjugate(bodies[it_a->second].orientation);
+				jd.rest_orientation = bodies[body_b].orientation * conjugate(bodies[body_a].orientation);
 				jd.rest_orientation_initialized = true;
 			}
 
 			s.vbd_solver.add_joint_constraint(vbd::joint_constraint{
-				.body_a = it_a->second,
-				.body_b = it_b->second,
+				.body_a = body_a,
+				.body_b = body_b,
 				.type = jd.type,
 				.local_anchor_a = jd.local_anchor_a,
 				.local_anchor_b = jd.local_anchor_b,
@@ -1031,55 +1374,72 @@ auto gse::physics::update_vbd(const int steps, state& s, chunk<motion_component>
 		s.vbd_solver.solve(const_update_time);
 
 		{
-			std::uint32_t ji = 0;
 			const auto& solved_joints = s.vbd_solver.graph().joint_constraints();
-			for (auto& jd : s.joints) {
-				const auto it_a = id_to_body_index.find(jd.entity_a);
-				const auto it_b = id_to_body_index.find(jd.entity_b);
-				if (it_a == id_to_body_index.end() || it_b == id_to_body_index.end()) continue;
-				if (ji < solved_joints.size()) {
-					const auto& sj = solved_joints[ji];
-					jd.pos_lambda = sj.pos_lambda;
-					jd.pos_penalty = sj.pos_penalty;
-					jd.ang_lambda = sj.ang_lambda;
-					jd.ang_penalty = sj.ang_penalty;
-					jd.limit_lambda = sj.limit_lambda;
-					jd.limit_penalty = sj.limit_penalty;
-				}
-				++ji;
+			for (std::size_t ji = 0; ji < active_joints.size() && ji < solved_joints.size(); ++ji) {
+				auto& jd = s.joints[active_joints[ji]];
+				const auto& sj = solved_joints[ji];
+				jd.pos_lambda = sj.pos_lambda;
+				jd.pos_penalty = sj.pos_penalty;
+				jd.ang_lambda = sj.ang_lambda;
+				jd.ang_penalty = sj.ang_penalty;
+				jd.limit_lambda = sj.limit_lambda;
+				jd.limit_penalty = sj.limit_penalty;
 			}
 		}
 
 		std::vector<vbd::body_state> result_bodies;
-		s.vbd_solver.end_frame(result_bodies, s.contact_cache);
+		s.vbd_solver.end_frame(result_bodies, s.contact_cache, solved);
 
-		for (std::size_t i = 0; i < motion_ptrs.size(); ++i) {
-			auto* mc = motion_ptrs[i];
+		std::vector<id> solved_ids;
+		std::vector<std::uint8_t> can_sleep;
+		solved_ids.reserve(solved.size());
+		can_sleep.reserve(solved.size());
+
+		for (std::size_t i = 0; i < solved.size(); ++i) {
+			auto& mc = motion[solved[i]];
 			const auto& bs = result_bodies[i];
 
-			mc->current_position = bs.position;
-			mc->current_velocity = bs.body_velocity;
-			if (mc->update_orientation) {
-				mc->orientation = bs.orientation;
-				mc->angular_velocity = bs.body_angular_velocity;
+			mc.current_position = bs.position;
+			mc.current_velocity = bs.body_velocity;
+			if (mc.update_orientation) {
+				mc.orientation = bs.orientation;
+				mc.angular_velocity = bs.body_angular_velocity;
 			}
 
-			s.sleep_counters[mc->owner_id()] = bs.sleep_counter;
-			mc->sleeping = bs.sleeping();
+			if (!mc.position_locked) {
+				s.sleep_counters[mc.owner_id()] = bs.sleep_counter;
+			}
 
-			if (auto* cc = collision.find(mc->owner_id())) {
-				cc->bounding_box.update(mc->current_position, mc->orientation);
+			if (auto* cc = body_collisions[solved[i]]) {
+				cc->bounding_box.update(mc.current_position, mc.orientation);
 			}
+
+			solved_ids.push_back(mc.owner_id());
+			can_sleep.push_back(mc.can_sleep);
+		}
+
+		resolve_continuous_collisions(objects, pairs, s.vbd_solver.config().speculative_margin);
+
+		for (const auto eid : s.islands.rebuild(solved_ids, result_bodies, can_sleep, s.vbd_solver.graph())) {
+			auto* mc = motion.find(eid);
+			if (!mc) continue;
+
+			mc->sleeping = true;
+			mc->current_velocity = {};
+			mc->angular_velocity = {};
+			mc->previous_position = mc->current_position;
+			mc->previous_orientation = mc->orientation;
 		}
 
 		for (motion_component& mc : motion) {
 			if (mc.position_locked) continue;
 			if (magnitude(mc.pending_impulse) > meters_per_second(1e-6f)) {
+				if (mc.sleeping) {
+					wake_island(s, motion, mc.owner_id(), true);
+				}
 				mc.current_velocity += mc.pending_impulse;
 				s.sleep_counters[mc.owner_id()] = 0;
-				if (const auto it = id_to_body_index.find(mc.owner_id()); it != id_to_body_index.end()) {
-					s.contact_cache.remove_body(it->second);
-				}
+				s.contact_cache.remove_body(motion_index(std::addressof(mc)));
 				mc.pending_impulse = {};
 			}
 		}
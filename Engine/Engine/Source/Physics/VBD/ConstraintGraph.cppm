@@ -7,6 +7,8 @@ import :vbd_constraints;
 export namespace gse::vbd {
 	class constraint_graph {
 	public:
+		static constexpr std::uint32_t max_colors = 64;
+
 		auto add_contact(
 			const contact_constraint& c
 		) -> std::uint32_t;
@@ -139,13 +141,13 @@ auto gse::vbd::constraint_graph::compute_coloring(
 
 		std::uint64_t used_colors = 0;
 		for (const auto neighbor : adjacency[bi]) {
-			if (body_color[neighbor] >= 0 && body_color[neighbor] < 64) {
+			if (body_color[neighbor] >= 0 && body_color[neighbor] < static_cast<int>(max_colors)) {
 				used_colors |= (1ull << body_color[neighbor]);
 			}
 		}
 
 		int color = 0;
-		while (color < 64 && (used_colors & (1ull << color))) {
+		while (color < static_cast<int>(max_colors) && (used_colors & (1ull << color))) {
 			++color;
 		}
 
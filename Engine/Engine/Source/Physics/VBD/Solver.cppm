@@ -30,6 +30,7 @@ export namespace gse::vbd {
 		velocity velocity_sleep_threshold = meters_per_second(0.001f);
 		angular_velocity angular_sleep_threshold = radians_per_second(0.05f);
 		length speculative_margin = meters(0.02f);
+		bool parallel_colors = false;
 	};
 
 	class solver {
@@ -68,7 +69,8 @@ export namespace gse::vbd {
 
 		auto end_frame(
 			std::vector<body_state>& bodies,
-			contact_cache& cache
+			contact_cache& cache,
+			std::span<const std::uint32_t> cache_ids = {}
 		) -> void;
 
 		auto body_states(
@@ -79,6 +81,13 @@ export namespace gse::vbd {
 
 		auto graph(this auto&& self) -> auto& { return self.m_graph; }
 	private:
+		auto accumulate_body(
+			std::uint32_t body_idx,
+			time_squared h_squared,
+			time_step dt,
+			float alpha
+		) -> void;
+
 		auto accumulate_contact(
 			const contact_constraint& constraint,
 			std::uint32_t body_idx,
@@ -585,7 +594,6 @@ auto gse::vbd::solver::solve(const time_step dt) -> void {
 		}
 	}
 
-	const auto& contacts = m_graph.contact_constraints();
 	const auto& motors = m_graph.motor_constraints();
 	const auto& joints = m_graph.joint_constraints();
 
@@ -597,18 +605,18 @@ auto gse::vbd::solver::solve(const time_step dt) -> void {
 			current_alpha = it < static_cast<int>(m_config.iterations) ? 1.0f : 0.0f;
 		}
 
-		for (const auto& body_color : m_graph.body_colors()) {
+		for (const auto& [color, body_color] : m_graph.body_colors() | std::views::enumerate) {
+			if (m_config.parallel_colors && std::cmp_less(color, constraint_graph::max_colors)) {
+				task::parallel_for(0uz, body_color.size(), [&](const std::size_t k) {
+					const auto bi = body_color[k];
+					accumulate_body(bi, h_squared, dt, current_alpha);
+					perform_newton_step(bi, h_squared);
+				});
+				continue;
+			}
+
 			for (const auto bi : body_color) {
-				m_solve_state[bi] = {};
-				for (const auto ci : m_graph.body_contact_indices(bi)) {
-					accumulate_contact(contacts[ci], bi, h_squared, current_alpha);
-				}
-				for (const auto ji : m_graph.body_joint_indices(bi)) {
-					accumulate_joint(joints[ji], bi, h_squared, dt, current_alpha);
-				}
-				if (const auto mi = m_body_motor_index[bi]; mi != no_motor) {
-					accumulate_motor(motors[mi], h_squared);
-				}
+				accumulate_body(bi, h_squared, dt, current_alpha);
 			}
 
 			for (const auto bi : body_color) {
@@ -737,7 +745,11 @@ auto gse::vbd::solver::solve(const time_step dt) -> void {
 	}
 }
 
-auto gse::vbd::solver::end_frame(std::vector<body_state>& bodies, contact_cache& cache) -> void {
+auto gse::vbd::solver::end_frame(std::vector<body_state>& bodies, contact_cache& cache, const std::span<const std::uint32_t> cache_ids) -> void {
+	const auto cache_id = [&](const std::uint32_t body) {
+		return cache_ids.empty() ? body : cache_ids[body];
+	};
+
 	for (const auto& c : m_graph.contact_constraints()) {
 		const force friction_bound = abs(c.lambda[0]) * c.friction_coeff;
 		const force tangential_lambda = hypot(c.lambda[1], c.lambda[2]);
@@ -748,7 +760,7 @@ auto gse::vbd::solver::end_frame(std::vector<body_state>& bodies, contact_cache&
 			tangential_gap < m_config.stick_threshold &&
 			tangential_lambda < friction_bound;
 
-		cache.store(c.body_a, c.body_b, c.feature, cached_lambda{
+		cache.store(cache_id(c.body_a), cache_id(c.body_b), c.feature, cached_lambda{
 			.lambda = c.lambda,
 			.penalty = c.penalty,
 			.normal = c.normal,
@@ -772,6 +784,23 @@ auto gse::vbd::solver::body_states() const -> std::span<const body_state> {
 	return m_bodies;
 }
 
+auto gse::vbd::solver::accumulate_body(const std::uint32_t body_idx, const time_squared h_squared, const time_step dt, const float alpha) -> void {
+	const auto& contacts = m_graph.contact_constraints();
+	const auto& motors = m_graph.motor_constraints();
+	const auto& joints = m_graph.joint_constraints();
+
+	m_solve_state[body_idx] = {};
+	for (const auto ci : m_graph.body_contact_indices(body_idx)) {
+		accumulate_contact(contacts[ci], body_idx, h_squared, alpha);
+	}
+	for (const auto ji : m_graph.body_joint_indices(body_idx)) {
+		accumulate_joint(joints[ji], body_idx, h_squared, dt, alpha);
+	}
+	if (const auto mi = m_body_motor_index[body_idx]; mi != no_motor) {
+		accumulate_motor(motors[mi], h_squared);
+	}
+}
+
 auto gse::vbd::solver::accumulate_contact(const contact_constraint& constraint, const std::uint32_t body_idx, const time_squared h_squared, const float alpha) -> void {
 	const auto& body_a = m_bodies[constraint.body_a];
 	const auto& body_b = m_bodies[constraint.body_b];
@@ -985,7 +1014,9 @@ auto gse::vbd::solver::perform_newton_step(const std::uint32_t body_idx, const t
 }
 
 auto gse::vbd::solver::update_dual(const float alpha) -> void {
-	for (auto& con : m_graph.contact_constraints()) {
+	auto& contacts = m_graph.contact_constraints();
+
+	auto update_contact = [&](contact_constraint& con) {
 		const auto& body_a = m_bodies[con.body_a];
 		const auto& body_b = m_bodies[con.body_b];
 
@@ -1021,6 +1052,17 @@ auto gse::vbd::solver::update_dual(const float alpha) -> void {
 				con.penalty[2] = std::min(con.penalty[2] + m_config.beta * abs(c[2]).as<meters>(), m_config.penalty_max);
 			}
 		}
+	};
+
+	if (m_config.parallel_colors) {
+		task::parallel_for(0uz, contacts.size(), [&](const std::size_t i) {
+			update_contact(contacts[i]);
+		});
+		return;
+	}
+
+	for (auto& con : contacts) {
+		update_contact(con);
 	}
 }
 
@@ -15,8 +15,8 @@ export namespace gs {
         int m_selected = -1;
         gse::clock m_refresh_clock;
         gse::interval_timer<> m_server_info_timer{ gse::seconds(10.f) };
-        std::uint8_t m_connected_players = 0;
-        std::uint8_t m_connected_max_players = 0;
+        std::uint16_t m_connected_players = 0;
+        std::uint16_t m_connected_max_players = 0;
     };
 }
 
@@ -63,7 +63,48 @@ export namespace gs {
 				});
 		}
 
+		auto update() -> void override {
+			if (const auto* ps = gse::try_state_of<gse::physics::state>()) {
+				const auto& [mode, proxy_count, candidate_pairs, time] = ps->last_broad_phase;
+				auto& totals = m_broad_phase_totals[static_cast<std::size_t>(mode)];
+				totals.samples++;
+				totals.proxy_count = proxy_count;
+				totals.candidate_pairs += candidate_pairs;
+				totals.time += time;
+			}
+
+			if (!m_broad_phase_report.tick()) {
+				return;
+			}
+
+			for (const auto mode : { gse::physics::broad_phase_mode::brute_force, gse::physics::broad_phase_mode::dynamic_tree }) {
+				const auto& [samples, proxy_count, candidate_pairs, time] = m_broad_phase_totals[static_cast<std::size_t>(mode)];
+				if (samples == 0) {
+					continue;
+				}
+
+				std::println(
+					"Broad phase [{}]: {} proxies, {:.1f} candidate pairs, {:.3f} ms (avg of {} frames)",
+					mode == gse::physics::broad_phase_mode::brute_force ? "brute force" : "dynamic tree",
+					proxy_count,
+					static_cast<double>(candidate_pairs) / static_cast<double>(samples),
+					time.as<gse::milliseconds>() / static_cast<float>(samples),
+					samples
+				);
+			}
+		}
+
 	private:
+		struct broad_phase_totals {
+			std::size_t samples = 0;
+			std::uint32_t proxy_count = 0;
+			std::uint64_t candidate_pairs = 0;
+			gse::time_t<float, gse::seconds> time = {};
+		};
+
+		gse::interval_timer<> m_broad_phase_report{ gse::seconds(2.f) };
+		std::array<broad_phase_totals, 2> m_broad_phase_totals;
+
 		auto build_inverted_mass_pyramid() const -> void {
 			constexpr float x = -15.f;
 			constexpr float z = 0.f;
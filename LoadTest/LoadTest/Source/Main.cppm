@@ -0,0 +1,341 @@
+import std;
+
+import gse;
+import gse.network;
+import gse.platform;
+import gse.utility;
+import gse.math;
+import gse.server;
+
+import gs;
+
+struct bot_stats {
+	std::size_t sent_bytes = 0;
+	std::size_t received_packets = 0;
+	std::size_t received_bytes = 0;
+	std::size_t missing = 0;
+};
+
+class bot {
+public:
+	bot(const gse::network::address& server, const gse::network::link_conditions& conditions, const std::uint32_t seed)
+		: m_link(m_socket, conditions, conditions, seed), m_server(server), m_seed(seed) {}
+
+	auto start() -> bool {
+		if (!m_socket.bind({ .ip = "0.0.0.0", .port = 0 })) {
+			return false;
+		}
+
+		send(gse::network::connection_request{});
+		m_retry.reset();
+		return true;
+	}
+
+	auto tick() -> void {
+		while (const auto received = m_link.receive_data(m_buffer)) {
+			receive(std::span(m_buffer).first(received->bytes_read));
+		}
+
+		if (!m_connected) {
+			if (m_retry.elapsed() > gse::seconds(1.f)) {
+				send(gse::network::connection_request{});
+				m_retry.reset();
+			}
+			m_link.pump();
+			return;
+		}
+
+		if (m_input_clock.elapsed() > gse::milliseconds(16.f)) {
+			m_input_clock.reset();
+			send_input();
+		}
+
+		m_link.pump();
+	}
+
+	auto connected() const -> bool {
+		return m_connected;
+	}
+
+	auto take_stats() -> bot_stats {
+		return std::exchange(m_stats, {});
+	}
+
+	auto link() const -> const gse::network::link_conditioner& {
+		return m_link;
+	}
+
+	auto request_stats() -> void {
+		m_server_stats.reset();
+		send(gse::network::server_stats_request{});
+	}
+
+	auto server_stats() const -> const std::optional<gse::network::server_stats_response>& {
+		return m_server_stats;
+	}
+private:
+	template <typename T>
+	auto send(const T& msg) -> void {
+		gse::network::bitstream stream(m_buffer);
+		stream.write(gse::packet_header{
+			.sequence = ++m_server.sequence(),
+			.ack = m_server.remote_ack_sequence(),
+			.ack_bits = m_server.remote_ack_bitfield()
+		});
+		gse::network::write(stream, msg);
+		flush(stream.bytes_written());
+	}
+
+	auto send_input() -> void {
+		const std::uint64_t phase = m_sequence / 60 + m_seed;
+		const std::array<std::uint64_t, 1> held{ std::uint64_t{ 1 } << (phase % 4) };
+		const std::array<std::uint64_t, 1> none{};
+
+		m_input.begin_frame();
+		m_input.ensure_capacity(64);
+		m_input.load_state(none, none, held);
+
+		const auto yaw = gse::degrees(static_cast<float>((m_sequence * 3 + m_seed * 37) % 360));
+
+		gse::network::bitstream stream(m_buffer);
+		gse::network::write_input_frame(stream, m_server, ++m_sequence, m_input, {}, {}, yaw);
+		flush(stream.bytes_written());
+	}
+
+	auto flush(const std::size_t size) -> void {
+		const gse::network::packet p{
+			.data = reinterpret_cast<std::uint8_t*>(m_buffer.data()),
+			.size = size
+		};
+		(void)m_link.send_data(p, m_server.addr());
+		m_stats.sent_bytes += size;
+	}
+
+	auto receive(const std::span<const std::byte> data) -> void {
+		auto stream = gse::network::bitstream::reader(data);
+		const auto header = stream.read<gse::packet_header>();
+
+		m_stats.received_packets++;
+		m_stats.received_bytes += data.size();
+
+		auto& ack = m_server.remote_ack_sequence();
+		auto& bits = m_server.remote_ack_bitfield();
+
+		if (header.sequence > ack) {
+			const std::uint32_t diff = header.sequence - ack;
+			if (ack != 0 && diff > 1) {
+				m_stats.missing += diff - 1;
+			}
+			bits = diff < 32 ? (bits << diff) | (1u << (diff - 1)) : 0;
+			ack = header.sequence;
+		}
+		else if (const std::uint32_t diff = ack - header.sequence; diff > 0 && diff < 32) {
+			bits |= 1u << (diff - 1);
+			m_stats.missing -= std::min<std::size_t>(m_stats.missing, 1);
+		}
+
+		const auto id = gse::network::message_id(stream);
+
+		if (m_connected) {
+			if (id == gse::network::message_id(std::type_identity<gse::network::message_batch>{})) {
+				gse::network::for_each_batched(stream, [&](gse::network::bitstream& entry, const std::uint16_t entry_id) {
+					gse::network::try_decode<gse::network::server_stats_response>(entry, entry_id, [&](const auto& m) {
+						m_server_stats = m;
+					});
+				});
+			}
+			return;
+		}
+
+		gse::network::try_decode<gse::network::connection_accepted>(stream, id, [&](const auto&) {
+			m_connected = true;
+			send(gse::network::pong{ .sequence = 0 });
+		});
+	}
+
+	gse::network::udp_socket m_socket;
+	gse::network::link_conditioner m_link;
+	gse::network::remote_peer m_server;
+	gse::actions::state m_input;
+	std::array<std::byte, gse::max_packet_size> m_buffer{};
+	gse::clock m_retry;
+	gse::clock m_input_clock;
+	std::uint32_t m_seed = 0;
+	std::uint32_t m_sequence = 0;
+	bool m_connected = false;
+	bot_stats m_stats;
+	std::optional<gse::network::server_stats_response> m_server_stats;
+};
+
+auto argument(const int argc, char** argv, const int index, const double fallback) -> double {
+	return argc > index ? std::stod(argv[index]) : fallback;
+}
+
+auto main(const int argc, char** argv) -> int {
+	const auto max_bots = static_cast<std::size_t>(argument(argc, argv, 1, 256));
+	const auto step_seconds = static_cast<float>(argument(argc, argv, 2, 5.0));
+
+	const gse::network::link_conditions conditions{
+		.latency = gse::milliseconds(static_cast<float>(argument(argc, argv, 3, 0.0))),
+		.jitter = gse::milliseconds(static_cast<float>(argument(argc, argv, 4, 0.0))),
+		.loss = static_cast<float>(argument(argc, argv, 5, 0.0)),
+		.reorder = static_cast<float>(argument(argc, argv, 6, 0.0)),
+		.bandwidth = static_cast<std::size_t>(argument(argc, argv, 7, 0.0))
+	};
+
+	const std::string_view target = argc > 8 ? argv[8] : "local";
+	const bool local = target == "local";
+
+	const gse::network::address server{
+		.ip = local ? "127.0.0.1" : std::string(target),
+		.port = static_cast<std::uint16_t>(argument(argc, argv, 9, 9000))
+	};
+
+	const std::string scene = argc > 10 ? argv[10] : "Default Scene";
+	const bool delta_encoding = argc <= 11 || std::string_view(argv[11]) != "full";
+
+	std::jthread local_server;
+	if (local) {
+		local_server = std::jthread([port = server.port, max_bots, scene, delta_encoding] {
+			gse::run_server<gs::world_loader>({
+				.port = port,
+				.max_players = static_cast<std::uint16_t>(max_bots),
+				.initial_scene = scene,
+				.delta_encoding = delta_encoding,
+				.headless = true
+			});
+		});
+	}
+
+	const auto stop_local_server = gse::make_scope_exit([local] {
+		if (local) {
+			gse::shutdown();
+		}
+	});
+
+	std::println(
+		"LoadTest: up to {} bots against {} {}:{}, {}s per step",
+		max_bots,
+		local ? "in-process headless server" : "server",
+		server.ip,
+		server.port,
+		step_seconds
+	);
+	if (local) {
+		std::println("Scene: {}, {} replication", scene, delta_encoding ? "delta" : "full");
+	}
+	std::println(
+		"Link: latency {} ms, jitter {} ms, loss {:.1f}%, reorder {:.1f}%, bandwidth {} B/s per bot",
+		conditions.latency.as<gse::milliseconds>(),
+		conditions.jitter.as<gse::milliseconds>(),
+		conditions.loss * 100.f,
+		conditions.reorder * 100.f,
+		conditions.bandwidth
+	);
+	std::println(
+		"{:>6} {:>10} {:>9} {:>9} {:>9} {:>11} {:>11} {:>11} {:>11} {:>11} {:>9} {:>9}",
+		"bots", "connected", "tick ms", "update ms", "srv drop", "srv KiB/s", "srv pkt/s", "rx KiB/s", "tx KiB/s", "rx pkt/s", "missing", "lost"
+	);
+
+	std::vector<std::unique_ptr<bot>> bots;
+
+	auto fetch_server_stats = [&] -> std::optional<gse::network::server_stats_response> {
+		auto& probe = *bots.front();
+		if (!probe.connected()) {
+			return std::nullopt;
+		}
+
+		const gse::clock wait;
+		gse::clock retry;
+		probe.request_stats();
+
+		while (!probe.server_stats() && wait.elapsed() < gse::seconds(1.f)) {
+			if (retry.elapsed() > gse::milliseconds(250.f)) {
+				probe.request_stats();
+				retry.reset();
+			}
+			for (const auto& b : bots) {
+				b->tick();
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		return probe.server_stats();
+	};
+
+	for (std::size_t target = 1; bots.size() < max_bots; target = std::min(target * 2, max_bots)) {
+		while (bots.size() < target) {
+			auto b = std::make_unique<bot>(server, conditions, static_cast<std::uint32_t>(bots.size() + 1));
+			if (!b->start()) {
+				std::println("Failed to bind bot socket");
+				return 1;
+			}
+			bots.push_back(std::move(b));
+		}
+
+		const auto server_before = fetch_server_stats();
+
+		std::size_t lost_before = 0;
+		for (const auto& b : bots) {
+			(void)b->take_stats();
+			lost_before += b->link().incoming_stats().lost + b->link().outgoing_stats().lost + b->link().incoming_stats().throttled + b->link().outgoing_stats().throttled;
+		}
+
+		const gse::clock step;
+		while (step.elapsed() < gse::seconds(step_seconds)) {
+			for (const auto& b : bots) {
+				b->tick();
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		const auto server_after = fetch_server_stats();
+		const float seconds = step.elapsed().as<gse::seconds>();
+
+		double tick_ms = 0.0;
+		double update_ms = 0.0;
+		std::uint64_t server_dropped = 0;
+		double server_kib = 0.0;
+		double server_packets = 0.0;
+		if (server_before && server_after && server_after->ticks > server_before->ticks) {
+			const auto ticks = static_cast<double>(server_after->ticks - server_before->ticks);
+			tick_ms = static_cast<double>(server_after->tick_time_us - server_before->tick_time_us) / ticks / 1000.0;
+			update_ms = static_cast<double>(server_after->update_time_us - server_before->update_time_us) / ticks / 1000.0;
+			server_dropped = server_after->dropped_incoming - server_before->dropped_incoming + server_after->dropped_outgoing - server_before->dropped_outgoing;
+			server_kib = static_cast<double>(server_after->bytes_sent - server_before->bytes_sent) / seconds / 1024.0;
+			server_packets = static_cast<double>(server_after->packets_sent - server_before->packets_sent) / seconds;
+		}
+
+		bot_stats total;
+		std::size_t connected = 0;
+		std::size_t lost_after = 0;
+
+		for (const auto& b : bots) {
+			const auto s = b->take_stats();
+			total.sent_bytes += s.sent_bytes;
+			total.received_packets += s.received_packets;
+			total.received_bytes += s.received_bytes;
+			total.missing += s.missing;
+			connected += b->connected() ? 1 : 0;
+			lost_after += b->link().incoming_stats().lost + b->link().outgoing_stats().lost + b->link().incoming_stats().throttled + b->link().outgoing_stats().throttled;
+		}
+
+		std::println(
+			"{:>6} {:>10} {:>9.2f} {:>9.2f} {:>9} {:>11.1f} {:>11.0f} {:>11.1f} {:>11.1f} {:>11.0f} {:>9} {:>9}",
+			bots.size(),
+			connected,
+			tick_ms,
+			update_ms,
+			server_dropped,
+			server_kib,
+			server_packets,
+			static_cast<double>(total.received_bytes) / seconds / 1024.0,
+			static_cast<double>(total.sent_bytes) / seconds / 1024.0,
+			static_cast<double>(total.received_packets) / seconds,
+			total.missing,
+			lost_after - lost_before
+		);
+	}
+
+	return 0;
+}
@@ -1,6 +1,6 @@
 export module gse.server;
 
-import :server;
+export import :server;
 import :input_source;
 
 import std;
@@ -11,22 +11,39 @@ export namespace gse {
 	public:
 		using hook::hook;
 
+		static auto configure(
+			const server_options& options
+		) -> void;
+
 		auto initialize() -> void override;
 		auto update() -> void override;
 		auto render() -> void override;
 
 	private:
+		static inline server_options s_options;
+
 		server* m_server = nullptr;
 		std::uint32_t m_tick_count = 0;
 		interval_timer<> m_timer{ seconds(5.f) };
 	};
+
+	template <typename... Hooks>
+	auto run_server(
+		const server_options& options
+	) -> void;
+}
+
+auto gse::server_app::configure(const server_options& options) -> void {
+	s_options = options;
 }
 
 auto gse::server_app::initialize() -> void {
-	set_ui_focus(true);
+	if (!s_options.headless) {
+		set_ui_focus(true);
+	}
 	m_owner->set_networked(true);
 
-	m_server = &m_owner->hook_world<server>(9000);
+	m_server = &m_owner->hook_world<server>(s_options);
 	m_owner->hook_world<networked_world<server_input_source>>(
 		server_input_source{
 			&m_server->clients()
@@ -61,3 +78,15 @@ auto gse::server_app::render() -> void {
 		gui::value("Ticks", m_tick_count);
 	});
 }
+
+template <typename... Hooks>
+auto gse::run_server(const server_options& options) -> void {
+	server_app::configure(options);
+
+	if (options.headless) {
+		start<server_app, Hooks...>(flags<engine_flag>{});
+	}
+	else {
+		start<server_app, Hooks...>();
+	}
+}
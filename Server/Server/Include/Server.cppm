@@ -24,27 +24,34 @@ export namespace gse {
 		id controller_id;
 		actions::state latest_input;
 		std::uint32_t last_input_sequence = 0;
+		std::uint32_t stepped_input_sequence = 0;
 		gse::angle camera_yaw{};
 		bool have_seq = false;
 	};
 
 	struct incoming_packet {
 		network::address from;
-		std::size_t size = 0;
-		std::array<std::byte, max_packet_size> buffer{};
+		network::packet_buffer buffer;
 	};
 
 	struct outgoing_packet {
 		network::address to;
-		std::size_t size = 0;
-		std::array<std::byte, max_packet_size> buffer{};
+		network::packet_buffer buffer;
+	};
+
+	struct server_options {
+		std::uint16_t port = 9000;
+		std::uint16_t max_players = 8;
+		std::string initial_scene = "Default Scene";
+		bool delta_encoding = true;
+		bool headless = false;
 	};
 
 	class server : public hook<world> {
 	public:
 		server(
 			world* owner,
-			std::uint16_t port
+			const server_options& options
 		);
 
 		auto initialize(
@@ -56,8 +63,9 @@ export namespace gse {
 		template <typename T>
 		auto send(
 			const T& msg,
-			const network::address& to
-		) -> void;
+			const network::address& to,
+			std::uint32_t baseline_token = 0
+		) -> std::size_t;
 
 		template <typename T>
 		auto send_reliable(
@@ -76,20 +84,49 @@ export namespace gse {
 
 		auto host_address(
 		) const -> std::optional<network::address>;
+
+		auto dropped_incoming(
+		) const -> std::uint64_t;
+
+		auto dropped_outgoing(
+		) const -> std::uint64_t;
+
+		auto stats(
+		) const -> network::server_stats_response;
 	private:
+		auto flush_send_queues(
+		) -> void;
+
+		auto push_outgoing(
+			outgoing_packet&& packet
+		) -> void;
+
 		static auto process_header(
 			network::bitstream& stream,
 			network::remote_peer& peer
 		) -> packet_header;
 
 		std::uint16_t m_port;
+		std::uint16_t m_max_players;
+		std::string m_initial_scene;
+		bool m_delta_encoding;
 		network::udp_socket m_socket;
 		std::unordered_map<network::address, network::remote_peer> m_peers;
+		std::unordered_map<network::address, network::send_queue> m_send_queues;
 		std::unordered_map<network::address, client_data> m_clients;
 		std::unordered_set<network::address> m_pending_snapshots;
+		network::interest_manager m_interest;
 		std::optional<id> m_host_entity;
 		std::optional<network::address> m_host_addr;
 		spsc_ring_buffer<incoming_packet, 1024> m_incoming;
+		std::atomic<std::uint64_t> m_dropped_incoming = 0;
+		std::atomic<std::uint64_t> m_dropped_outgoing = 0;
+		std::uint64_t m_ticks = 0;
+		std::uint64_t m_tick_time_us = 0;
+		std::uint64_t m_update_time_us = 0;
+		std::uint64_t m_packets_sent = 0;
+		std::uint64_t m_bytes_sent = 0;
+		clock m_tick_clock;
 		mpsc_ring_buffer<outgoing_packet, 1024> m_outgoing;
 		std::jthread m_thread;
 		std::uint32_t m_next_player_id = 0;
@@ -101,8 +138,8 @@ export namespace gse {
 	};
 }
 
-gse::server::server(world* owner, const std::uint16_t port)
-	: hook(owner), m_port(port) {}
+gse::server::server(world* owner, const server_options& options)
+	: hook(owner), m_port(options.port), m_max_players(options.max_players), m_initial_scene(options.initial_scene), m_delta_encoding(options.delta_encoding) {}
 
 auto gse::server::initialize() -> void {
 	if (!m_socket.bind(network::address{
@@ -118,61 +155,125 @@ auto gse::server::initialize() -> void {
 	}
 
 	m_thread = std::jthread([this](const std::stop_token& st) {
-		std::array<std::byte, max_packet_size> buffer;
+		constexpr std::size_t batch_size = 32;
 		constexpr time_t<std::uint32_t> max_sleep = milliseconds(8);
 
+		std::array<network::packet_buffer, batch_size> buffers;
+		std::array<network::datagram, batch_size> received;
+		std::array<outgoing_packet, batch_size> out_pkts;
+		std::array<network::datagram, batch_size> outgoing;
+
 		while (!st.stop_requested()) {
 			(void)m_socket.wait_readable(max_sleep);
 
-			while (const auto received = m_socket.receive_data(buffer)) {
-				incoming_packet pkt;
-				pkt.from = received->from;
-				pkt.size = received->bytes_read;
-				std::memcpy(pkt.buffer.data(), buffer.data(), received->bytes_read);
-				if (!m_incoming.push(pkt)) {
+			bool ring_full = false;
+			while (true) {
+				const auto space = std::min(batch_size, m_incoming.free_slots());
+				if (space == 0) {
+					ring_full = true;
 					break;
 				}
+
+				for (std::size_t i = 0; i < space; ++i) {
+					if (!buffers[i]) {
+						buffers[i] = network::packet_buffer::acquire();
+						received[i].buffer = buffers[i].data();
+					}
+				}
+
+				const auto count = m_socket.receive_batch(std::span(received.data(), space));
+				if (count == 0) {
+					break;
+				}
+
+				for (std::size_t i = 0; i < count; ++i) {
+					buffers[i].resize(received[i].size);
+					if (!m_incoming.push(incoming_packet{ .from = received[i].addr, .buffer = std::move(buffers[i]) })) {
+						buffers[i] = {};
+						m_dropped_incoming.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
 			}
 
-			outgoing_packet out_pkt;
-			while (m_outgoing.pop(out_pkt)) {
-				const network::packet out{
-					.data = reinterpret_cast<std::uint8_t*>(out_pkt.buffer.data()),
-					.size = out_pkt.size
-				};
+			while (true) {
+				std::size_t pending = 0;
+				while (pending < batch_size && m_outgoing.pop(out_pkts[pending])) {
+					outgoing[pending] = {
+						.buffer = out_pkts[pending].buffer.data(),
+						.size = out_pkts[pending].buffer.size(),
+						.addr = out_pkts[pending].to
+					};
+					++pending;
+				}
+
+				if (pending == 0) {
+					break;
+				}
+
+				if (const auto sent = m_socket.send_batch(std::span(outgoing.data(), pending)); sent < pending) {
+					m_dropped_outgoing.fetch_add(pending - sent, std::memory_order_relaxed);
+				}
+
+				for (std::size_t i = 0; i < pending; ++i) {
+					out_pkts[i].buffer = {};
+				}
+
+				if (pending < batch_size) {
+					break;
+				}
+			}
 
-				m_socket.send_data(out, out_pkt.to);
+			if (ring_full) {
+				std::this_thread::yield();
 			}
 		}
 	});
 }
 
 template <typename T>
-auto gse::server::send(const T& msg, const network::address& to) -> void {
-	const auto it = m_peers.find(to);
-	if (it == m_peers.end()) {
-		return;
+auto gse::server::send(const T& msg, const network::address& to, const std::uint32_t baseline_token) -> std::size_t {
+	const auto it = m_send_queues.find(to);
+	if (it == m_send_queues.end()) {
+		return 0;
 	}
 
-	auto& peer = it->second;
+	return it->second.push(msg, baseline_token);
+}
 
-	std::array<std::byte, max_packet_size> buffer;
-	const packet_header header{
-		.sequence = ++peer.sequence(),
-		.ack = peer.remote_ack_sequence(),
-		.ack_bits = peer.remote_ack_bitfield()
-	};
+auto gse::server::flush_send_queues() -> void {
+	std::size_t packets = 0;
+	std::size_t bytes = 0;
+	std::size_t dropped = 0;
 
-	network::bitstream stream(buffer);
-	stream.write(header);
-	network::write(stream, msg);
+	for (auto& [addr, queue] : m_send_queues) {
+		const auto it = m_peers.find(addr);
+		if (it == m_peers.end()) {
+			continue;
+		}
+
+		packets += queue.flush(it->second, [&](network::packet_buffer&& buffer) {
+			const auto size = buffer.size();
+			if (!m_outgoing.push(outgoing_packet{ .to = addr, .buffer = std::move(buffer) })) {
+				++dropped;
+				return;
+			}
+			bytes += size;
+		});
+	}
+
+	m_dropped_outgoing.fetch_add(dropped, std::memory_order_relaxed);
+	m_packets_sent += packets;
+	m_bytes_sent += bytes;
 
-	outgoing_packet pkt;
-	pkt.to = to;
-	pkt.size = stream.bytes_written();
-	std::memcpy(pkt.buffer.data(), buffer.data(), pkt.size);
+	trace::counter(find_or_generate_id("server.packets_sent"), static_cast<double>(packets));
+	trace::counter(find_or_generate_id("server.bytes_sent"), static_cast<double>(bytes));
+	trace::counter(find_or_generate_id("server.packets_dropped"), static_cast<double>(dropped));
+}
 
-	m_outgoing.push(pkt);
+auto gse::server::push_outgoing(outgoing_packet&& packet) -> void {
+	if (!m_outgoing.push(std::move(packet))) {
+		m_dropped_outgoing.fetch_add(1, std::memory_order_relaxed);
+	}
 }
 
 template <typename T>
@@ -184,27 +285,21 @@ auto gse::server::send_reliable(const T& msg, const network::address& to) -> voi
 
 	auto& peer = it->second;
 
-	std::array<std::byte, max_packet_size> buffer;
 	const packet_header header{
 		.sequence = ++peer.sequence(),
 		.ack = peer.remote_ack_sequence(),
 		.ack_bits = peer.remote_ack_bitfield()
 	};
 
-	network::bitstream stream(buffer);
+	auto buffer = network::packet_buffer::acquire();
+	network::bitstream stream(buffer.data());
 	stream.write(header);
 	network::write(stream, msg);
+	buffer.resize(stream.bytes_written());
 
-	const std::size_t size = stream.bytes_written();
-
-	peer.queue_reliable(header.sequence, std::span(buffer.data(), size));
+	peer.queue_reliable(header.sequence, buffer.bytes());
 
-	outgoing_packet pkt;
-	pkt.to = to;
-	pkt.size = size;
-	std::memcpy(pkt.buffer.data(), buffer.data(), size);
-
-	m_outgoing.push(pkt);
+	push_outgoing(outgoing_packet{ .to = to, .buffer = std::move(buffer) });
 }
 
 auto gse::server::resend_reliable_messages() -> void {
@@ -212,28 +307,23 @@ auto gse::server::resend_reliable_messages() -> void {
 		auto to_resend = peer.messages_to_resend(reliable_retry_interval_ms);
 
 		for (auto* msg : to_resend) {
-			std::array<std::byte, max_packet_size> buffer;
-
 			const packet_header new_header{
 				.sequence = ++peer.sequence(),
 				.ack = peer.remote_ack_sequence(),
 				.ack_bits = peer.remote_ack_bitfield()
 			};
 
-			network::bitstream stream(buffer);
+			auto buffer = network::packet_buffer::acquire();
+			network::bitstream stream(buffer.data());
 			stream.write(new_header);
 
 			constexpr std::size_t header_size = sizeof(packet_header);
 			if (msg->data.size() > header_size) {
 				stream.write_bytes(msg->data.data() + header_size, msg->data.size() - header_size);
 			}
+			buffer.resize(stream.bytes_written());
 
-			outgoing_packet pkt;
-			pkt.to = addr;
-			pkt.size = stream.bytes_written();
-			std::memcpy(pkt.buffer.data(), buffer.data(), pkt.size);
-
-			m_outgoing.push(pkt);
+			push_outgoing(outgoing_packet{ .to = addr, .buffer = std::move(buffer) });
 
 			msg->sent_time_ms = network::current_time_ms();
 			++msg->send_count;
@@ -242,8 +332,15 @@ auto gse::server::resend_reliable_messages() -> void {
 }
 
 auto gse::server::update() -> void {
+	const clock update_clock;
+
+	const auto tick_time = m_tick_clock.reset();
+	if (m_ticks++ > 0) {
+		m_tick_time_us += static_cast<std::uint64_t>(tick_time.as<microseconds>());
+	}
+
 	if (!m_owner->current_scene()) {
-		m_owner->activate(find("Default Scene"));
+		m_owner->activate(find(m_initial_scene));
 	}
 
 	constexpr std::size_t max_packets_per_update = 256;
@@ -254,8 +351,7 @@ auto gse::server::update() -> void {
 	while (processed_packets < max_packets_per_update && m_incoming.pop(pkt)) {
 		++processed_packets;
 
-		const std::span data(pkt.buffer.data(), pkt.size);
-		network::bitstream stream(data);
+		auto stream = network::bitstream::reader(pkt.buffer.bytes());
 
 		const auto it = m_peers.find(pkt.from);
 		const auto header = stream.read<packet_header>();
@@ -263,34 +359,31 @@ auto gse::server::update() -> void {
 
 		if (it == m_peers.end()) {
 			if (network::try_decode<network::server_info_request>(stream, mid, [&](const auto&) {
-				std::array<std::byte, max_packet_size> buffer;
-				network::bitstream out_stream(buffer);
+				auto buffer = network::packet_buffer::acquire();
+				network::bitstream out_stream(buffer.data());
 
 				const packet_header header_out{};
 				out_stream.write(header_out);
 				network::write(out_stream, network::server_info_response{
-					.players = static_cast<std::uint8_t>(m_clients.size()),
-					.max_players = 8
+					.players = static_cast<std::uint16_t>(m_clients.size()),
+					.max_players = m_max_players
 				});
+				buffer.resize(out_stream.bytes_written());
 
-				outgoing_packet out_pkt;
-				out_pkt.to = pkt.from;
-				out_pkt.size = out_stream.bytes_written();
-				std::memcpy(out_pkt.buffer.data(), buffer.data(), out_pkt.size);
-				m_outgoing.push(out_pkt);
+				push_outgoing(outgoing_packet{ .to = pkt.from, .buffer = std::move(buffer) });
 			})) {
 				continue;
 			}
 
 			network::try_decode<network::connection_request>(stream, mid, [&](const auto&) {
-				constexpr std::uint8_t max_players = 8;
-				if (m_clients.size() >= max_players) {
+				if (m_clients.size() >= m_max_players) {
 					std::println("Client [{}:{}] failed to connect (server full: {}/{})",
-						pkt.from.ip, pkt.from.port, m_clients.size(), max_players);
+						pkt.from.ip, pkt.from.port, m_clients.size(), m_max_players);
 					return;
 				}
 
 				m_peers.emplace(pkt.from, network::remote_peer(pkt.from));
+				m_send_queues.try_emplace(pkt.from);
 
 				if (auto* scene = m_owner->current_scene()) {
 					const auto controller_name = std::format("PlayerController_{}", m_next_player_id++);
@@ -307,7 +400,7 @@ auto gse::server::update() -> void {
 
 				send_reliable(network::connection_accepted{}, pkt.from);
 				std::println("Client [{}:{}] connected ({}/{})",
-					pkt.from.ip, pkt.from.port, m_clients.size(), max_players);
+					pkt.from.ip, pkt.from.port, m_clients.size(), m_max_players);
 
 				if (const auto* active = m_owner->current_scene()) {
 					const network::notify_scene_change msg{
@@ -391,10 +484,13 @@ auto gse::server::update() -> void {
 			})
 			.else_if_is([&](const network::server_info_request&) {
 				send(network::server_info_response{
-					.players = static_cast<std::uint8_t>(m_clients.size()),
-					.max_players = 8
+					.players = static_cast<std::uint16_t>(m_clients.size()),
+					.max_players = m_max_players
 				}, pkt.from);
 			})
+			.else_if_is([&](const network::server_stats_request&) {
+				send(stats(), pkt.from);
+			})
 			.else_if_is([&](const network::input_frame_header& fh) {
 				const std::size_t wc = fh.action_word_count;
 
@@ -486,19 +582,66 @@ auto gse::server::update() -> void {
 	resend_reliable_messages();
 
 	if (auto* sc = m_owner->current_scene()) {
-		auto send_all = [this](const auto& msg, const network::address& to) {
-			this->send(msg, to);
+		auto send_all = [this](const auto& msg, const network::address& to, const std::uint32_t baseline_token = 0) {
+			return this->send(msg, to, baseline_token);
 		};
 
-		if (!m_pending_snapshots.empty()) {
-			for (const auto& addr : m_pending_snapshots) {
-				network::replicate_snapshot_to(send_all, sc->registry(), addr);
+		for (const auto& addr : m_pending_snapshots) {
+			m_interest.reset(addr);
+		}
+		m_pending_snapshots.clear();
+
+		std::vector<network::interest_viewer> viewers;
+		viewers.reserve(m_peers.size());
+
+		for (const auto& addr : m_peers | std::views::keys) {
+			network::interest_viewer viewer{ .addr = addr };
+
+			if (const auto client_it = m_clients.find(addr); client_it != m_clients.end()) {
+				if (const auto* pc = sc->registry().try_linked_object_read<player_controller>(client_it->second.controller_id)) {
+					if (const auto* mc = sc->registry().try_linked_object_read<physics::motion_component>(pc->controlled_entity_id)) {
+						viewer.position = mc->current_position;
+					}
+				}
 			}
-			m_pending_snapshots.clear();
+
+			viewers.push_back(viewer);
 		}
 
-		network::replicate_deltas(send_all, sc->registry(), m_peers);
+		m_interest.update(sc->registry(), viewers);
+		network::replicate_deltas(send_all, sc->registry(), m_peers, m_interest, m_delta_encoding);
+
+		// The scene steps after this hook, so the state read here comes from the step
+		// that consumed the input which was latest at the end of the previous update.
+		for (auto& [addr, cd] : m_clients) {
+			const auto stepped = std::exchange(cd.stepped_input_sequence, cd.last_input_sequence);
+			if (stepped == 0) {
+				continue;
+			}
+
+			const auto* pc = sc->registry().try_linked_object_read<player_controller>(cd.controller_id);
+			if (!pc) {
+				continue;
+			}
+
+			if (const auto* mc = sc->registry().try_linked_object_read<physics::motion_component>(pc->controlled_entity_id)) {
+				send(network::input_ack{
+					.input_sequence = stepped,
+					.position = mc->current_position,
+					.velocity = mc->current_velocity
+				}, addr);
+			}
+		}
 	}
+
+	flush_send_queues();
+
+	const auto update_time = update_clock.elapsed();
+	m_update_time_us += static_cast<std::uint64_t>(update_time.as<microseconds>());
+
+	trace::counter(find_or_generate_id("server.packets_dropped_incoming"), static_cast<double>(dropped_incoming()));
+	trace::counter(find_or_generate_id("server.packets_dropped_outgoing"), static_cast<double>(dropped_outgoing()));
+	trace::counter(find_or_generate_id("server.update_ms"), static_cast<double>(update_time.as<milliseconds>()));
 }
 
 auto gse::server::peers() const -> const std::unordered_map<network::address, network::remote_peer>& {
@@ -517,6 +660,26 @@ auto gse::server::host_address() const -> std::optional<network::address> {
 	return m_host_addr;
 }
 
+auto gse::server::dropped_incoming() const -> std::uint64_t {
+	return m_dropped_incoming.load(std::memory_order_relaxed);
+}
+
+auto gse::server::dropped_outgoing() const -> std::uint64_t {
+	return m_dropped_outgoing.load(std::memory_order_relaxed);
+}
+
+auto gse::server::stats() const -> network::server_stats_response {
+	return {
+		.ticks = m_ticks,
+		.tick_time_us = m_tick_time_us,
+		.update_time_us = m_update_time_us,
+		.dropped_incoming = dropped_incoming(),
+		.dropped_outgoing = dropped_outgoing(),
+		.packets_sent = m_packets_sent,
+		.bytes_sent = m_bytes_sent
+	};
+}
+
 auto gse::server::process_header(network::bitstream& stream, network::remote_peer& peer) -> packet_header {
 	const auto header = stream.read<packet_header>();
 
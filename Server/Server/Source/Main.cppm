@@ -1,8 +1,32 @@
+import std;
+
 import gse;
 import gse.server;
 
 import gs;
 
-auto main() -> int {
-	gse::start<gse::server_app, gs::world_loader>({});
-}
\ No newline at end of file
+auto main(const int argc, char** argv) -> int {
+	gse::server_options options{
+		.max_players = 64
+	};
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		const bool has_value = i + 1 < argc;
+
+		if (arg == "--headless") {
+			options.headless = true;
+		}
+		else if (arg == "--port" && has_value) {
+			options.port = static_cast<std::uint16_t>(std::stoul(argv[++i]));
+		}
+		else if (arg == "--max-players" && has_value) {
+			options.max_players = static_cast<std::uint16_t>(std::stoul(argv[++i]));
+		}
+		else if (arg == "--scene" && has_value) {
+			options.initial_scene = argv[++i];
+		}
+	}
+
+	gse::run_server<gs::world_loader>(options);
+}
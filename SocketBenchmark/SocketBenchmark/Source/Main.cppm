@@ -0,0 +1,128 @@
+import std;
+
+import gse.network;
+import gse.math;
+
+struct run_result {
+	std::size_t sent = 0;
+	std::size_t received = 0;
+	double seconds = 0.0;
+};
+
+auto run(const std::size_t packets, const std::size_t size, const std::size_t batch) -> std::optional<run_result> {
+	gse::network::udp_socket receiver;
+	gse::network::udp_socket sender;
+
+	constexpr gse::network::socket_options options{
+		.receive_buffer_size = 8 * 1024 * 1024,
+		.send_buffer_size = 8 * 1024 * 1024
+	};
+
+	if (!receiver.bind({ .ip = "127.0.0.1", .port = 0 }, options) || !sender.bind({ .ip = "127.0.0.1", .port = 0 }, options)) {
+		return std::nullopt;
+	}
+
+	const auto target = *receiver.local_address();
+
+	std::atomic<bool> done = false;
+	std::size_t received = 0;
+
+	std::jthread drain([&] {
+		std::vector<std::array<std::byte, gse::max_packet_size>> buffers(batch);
+		std::vector<gse::network::datagram> slots(batch);
+		for (std::size_t i = 0; i < batch; ++i) {
+			slots[i].buffer = buffers[i];
+		}
+
+		while (received < packets) {
+			if (receiver.wait_readable(gse::milliseconds(50)) != gse::network::wait_result::ready) {
+				if (done.load(std::memory_order_acquire)) {
+					break;
+				}
+				continue;
+			}
+
+			if (batch == 1) {
+				while (receiver.receive_data(slots[0].buffer)) {
+					++received;
+				}
+			}
+			else {
+				while (const auto count = receiver.receive_batch(slots)) {
+					received += count;
+				}
+			}
+		}
+	});
+
+	std::vector<std::byte> payload(size, std::byte{ 0x5A });
+	std::vector<gse::network::datagram> outgoing(batch, {
+		.buffer = payload,
+		.size = size,
+		.addr = target
+	});
+
+	const auto start = std::chrono::steady_clock::now();
+
+	std::size_t sent = 0;
+	while (sent < packets) {
+		const std::size_t n = std::min(batch, packets - sent);
+		if (batch == 1) {
+			const gse::network::packet p{
+				.data = reinterpret_cast<std::uint8_t*>(payload.data()),
+				.size = size
+			};
+			if (sender.send_data(p, target) == gse::network::socket_state::error) {
+				std::this_thread::yield();
+				continue;
+			}
+			++sent;
+		}
+		else {
+			const auto count = sender.send_batch(std::span(outgoing.data(), n));
+			if (count == 0) {
+				std::this_thread::yield();
+			}
+			sent += count;
+		}
+	}
+
+	done.store(true, std::memory_order_release);
+	drain.join();
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	return run_result{
+		.sent = sent,
+		.received = received,
+		.seconds = elapsed.count()
+	};
+}
+
+auto main(const int argc, char** argv) -> int {
+	const std::size_t packets = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+	const std::size_t size = std::min<std::size_t>(argc > 2 ? std::stoul(argv[2]) : 512, gse::max_packet_size);
+
+	std::println("SocketBenchmark: {} packets of {} bytes over loopback", packets, size);
+	std::println("{:>8} {:>12} {:>12} {:>10} {:>8}", "batch", "sent/s", "recv/s", "MiB/s", "loss");
+
+	for (const std::size_t batch : { 1uz, 8uz, 32uz, 64uz }) {
+		const auto result = run(packets, size, batch);
+		if (!result) {
+			std::println("Failed to bind loopback sockets");
+			return 1;
+		}
+
+		const auto& [sent, received, seconds] = *result;
+		std::println(
+			"{:>8} {:>12.0f} {:>12.0f} {:>10.1f} {:>7.2f}%",
+			batch,
+			static_cast<double>(sent) / seconds,
+			static_cast<double>(received) / seconds,
+			static_cast<double>(received * size) / seconds / (1024.0 * 1024.0),
+			100.0 * (1.0 - static_cast<double>(received) / static_cast<double>(sent))
+		);
+	}
+
+	return 0;
+}
@@ -0,0 +1,265 @@
+import std;
+
+import gse.utility;
+
+namespace format = gse::trace::capture_format;
+
+struct frame_record {
+	std::uint64_t frame_index = 0;
+	std::vector<format::event_record> events;
+};
+
+struct span {
+	std::uint64_t id = 0;
+	std::uint64_t parent_eid = 0;
+	std::uint32_t tid = 0;
+	std::uint64_t frame_index = 0;
+	std::uint64_t start = 0;
+	std::uint64_t end = 0;
+	std::uint64_t child_time = 0;
+	bool closed = false;
+};
+
+struct capture {
+	format::file_header header;
+	std::vector<frame_record> frames;
+	std::unordered_map<std::uint64_t, std::string> names;
+};
+
+auto read_capture(const std::filesystem::path& path) -> std::optional<capture> {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		std::println("Failed to open {}", path.string());
+		return std::nullopt;
+	}
+
+	const std::vector<char> bytes{ std::istreambuf_iterator(file), std::istreambuf_iterator<char>() };
+
+	capture out;
+	if (bytes.size() < sizeof(format::file_header)) {
+		std::println("{} is too small to be a trace capture", path.string());
+		return std::nullopt;
+	}
+
+	std::memcpy(&out.header, bytes.data(), sizeof(out.header));
+	if (out.header.magic != format::file_magic || out.header.version != format::version) {
+		std::println("{} is not a trace capture", path.string());
+		return std::nullopt;
+	}
+
+	if (out.header.ring_offset > bytes.size() || out.header.name_offset + out.header.name_size > bytes.size()) {
+		std::println("{} is truncated", path.string());
+		return std::nullopt;
+	}
+
+	const std::span names{ bytes.data() + out.header.name_offset, out.header.name_size };
+	for (std::size_t cursor = 0; cursor + sizeof(format::name_record) <= names.size();) {
+		format::name_record name;
+		std::memcpy(&name, names.data() + cursor, sizeof(name));
+		cursor += format::align(sizeof(name));
+		if (cursor + name.length > names.size()) {
+			break;
+		}
+		out.names.try_emplace(name.id, names.data() + cursor, name.length);
+		cursor += format::align(name.length);
+	}
+
+	const std::span ring{ bytes.data() + out.header.ring_offset, std::min<std::size_t>(out.header.capacity, bytes.size() - out.header.ring_offset) };
+
+	auto parse_region = [&](std::size_t offset, const std::size_t end) {
+		while (offset + sizeof(format::record_header) <= end) {
+			format::record_header record;
+			std::memcpy(&record, ring.data() + offset, sizeof(record));
+
+			if (record.magic != format::record_magic || record.size < sizeof(record) || offset + record.size > end ||
+				format::align(sizeof(record)) + std::size_t{ record.event_count } * sizeof(format::event_record) > record.size) {
+				offset += 8;
+				continue;
+			}
+
+			const auto cursor = offset + format::align(sizeof(record));
+			frame_record frame{ .frame_index = record.frame_index };
+			frame.events.resize(record.event_count);
+			std::memcpy(frame.events.data(), ring.data() + cursor, record.event_count * sizeof(format::event_record));
+			out.frames.push_back(std::move(frame));
+
+			offset += record.size;
+		}
+	};
+
+	if (out.header.wrap_offset != 0) {
+		parse_region(out.header.write_offset, out.header.wrap_offset);
+	}
+	parse_region(0, out.header.write_offset);
+
+	std::ranges::sort(out.frames, {}, &frame_record::frame_index);
+	return out;
+}
+
+auto name_of(const capture& c, const std::uint64_t id) -> std::string {
+	if (const auto it = c.names.find(id); it != c.names.end() && !it->second.empty()) {
+		return it->second;
+	}
+	return std::format("{:#018x}", id);
+}
+
+auto percentile(std::span<const std::uint64_t> sorted, const double p) -> double {
+	if (sorted.empty()) {
+		return 0.0;
+	}
+	const auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+	return static_cast<double>(sorted[index]) / 1e3;
+}
+
+auto main(const int argc, char** argv) -> int {
+	if (argc < 2) {
+		std::println("Usage: TraceAnalyzer <capture.gstrace> [worst frame count]");
+		return 1;
+	}
+
+	const auto loaded = read_capture(argv[1]);
+	if (!loaded) {
+		return 1;
+	}
+
+	const auto& c = *loaded;
+	const std::size_t worst_count = argc > 2 ? std::stoul(argv[2]) : 10;
+
+	std::unordered_map<std::uint64_t, span> spans;
+	for (const auto& frame : c.frames) {
+		for (const auto& e : frame.events) {
+			switch (static_cast<format::event_kind>(e.type)) {
+				case format::event_kind::begin: {
+					spans[e.eid] = {
+						.id = e.id,
+						.parent_eid = e.parent_eid,
+						.tid = e.tid,
+						.frame_index = frame.frame_index,
+						.start = e.ts_ns,
+						.end = e.ts_ns
+					};
+					break;
+				}
+				case format::event_kind::end: {
+					if (const auto it = spans.find(e.eid); it != spans.end()) {
+						it->second.end = std::max(it->second.start, e.ts_ns);
+						it->second.closed = true;
+					}
+					break;
+				}
+				default:
+					break;
+			}
+		}
+	}
+
+	std::erase_if(spans, [](const auto& entry) {
+		return !entry.second.closed;
+	});
+
+	for (const auto& s : spans | std::views::values) {
+		if (const auto parent = spans.find(s.parent_eid); parent != spans.end()) {
+			const auto begin = std::max(s.start, parent->second.start);
+			const auto end = std::min(s.end, parent->second.end);
+			if (end > begin) {
+				parent->second.child_time += end - begin;
+			}
+		}
+	}
+
+	std::unordered_map<std::uint64_t, std::vector<std::uint64_t>> self_times;
+	std::unordered_map<std::uint64_t, std::uint64_t> frame_durations;
+	std::unordered_map<std::uint32_t, std::vector<std::pair<std::uint64_t, std::uint64_t>>> thread_intervals;
+	std::uint64_t first_ts = std::numeric_limits<std::uint64_t>::max();
+	std::uint64_t last_ts = 0;
+
+	for (const auto& s : spans | std::views::values) {
+		const auto duration = s.end - s.start;
+		self_times[s.id].push_back(duration - std::min(duration, s.child_time));
+
+		first_ts = std::min(first_ts, s.start);
+		last_ts = std::max(last_ts, s.end);
+
+		const auto parent = spans.find(s.parent_eid);
+		if (parent == spans.end() || parent->second.tid != s.tid) {
+			thread_intervals[s.tid].emplace_back(s.start, s.end);
+		}
+
+		if (parent == spans.end()) {
+			auto& frame_duration = frame_durations[s.frame_index];
+			frame_duration = std::max(frame_duration, duration);
+		}
+	}
+
+	std::println("Frames: {} captured, {} dropped; names: {} recorded, {} dropped", c.frames.size(), c.header.dropped_frames, c.header.name_count, c.header.dropped_names);
+	std::println("Spans:  {}", spans.size());
+	std::println("");
+
+	struct id_stats {
+		std::string name;
+		std::size_t count;
+		double p50;
+		double p95;
+		double p99;
+	};
+
+	std::vector<id_stats> stats;
+	for (auto& [id, times] : self_times) {
+		std::ranges::sort(times);
+		stats.push_back({
+			.name = name_of(c, id),
+			.count = times.size(),
+			.p50 = percentile(times, 0.50),
+			.p95 = percentile(times, 0.95),
+			.p99 = percentile(times, 0.99)
+		});
+	}
+	std::ranges::sort(stats, std::greater{}, &id_stats::p99);
+
+	std::println("{:<48} {:>10} {:>12} {:>12} {:>12}", "Self time (us)", "count", "p50", "p95", "p99");
+	for (const auto& s : stats) {
+		std::println("{:<48} {:>10} {:>12.2f} {:>12.2f} {:>12.2f}", s.name, s.count, s.p50, s.p95, s.p99);
+	}
+	std::println("");
+
+	std::vector<std::pair<std::uint64_t, std::uint64_t>> worst(frame_durations.begin(), frame_durations.end());
+	std::ranges::sort(worst, std::greater{}, &std::pair<std::uint64_t, std::uint64_t>::second);
+	worst.resize(std::min(worst.size(), worst_count));
+
+	std::println("Worst frames");
+	for (const auto& [frame_index, duration] : worst) {
+		std::println("  frame {:>8}: {:>10.3f} ms", frame_index, static_cast<double>(duration) / 1e6);
+	}
+	std::println("");
+
+	const auto wall = last_ts > first_ts ? last_ts - first_ts : 0;
+
+	std::vector<std::uint32_t> tids;
+	for (const auto& tid : thread_intervals | std::views::keys) {
+		tids.push_back(tid);
+	}
+	std::ranges::sort(tids);
+
+	std::println("Thread utilization over {:.3f} ms", static_cast<double>(wall) / 1e6);
+	for (const auto tid : tids) {
+		auto& intervals = thread_intervals[tid];
+		std::ranges::sort(intervals);
+
+		std::uint64_t busy = 0;
+		std::uint64_t open_start = intervals.front().first;
+		std::uint64_t open_end = intervals.front().second;
+		for (const auto& [start, end] : intervals | std::views::drop(1)) {
+			if (start > open_end) {
+				busy += open_end - open_start;
+				open_start = start;
+			}
+			open_end = std::max(open_end, end);
+		}
+		busy += open_end - open_start;
+
+		const auto utilization = wall > 0 ? 100.0 * static_cast<double>(busy) / static_cast<double>(wall) : 0.0;
+		std::println("  thread {:>3}: {:>6.2f}%", tid, utilization);
+	}
+
+	return 0;
+}
@@ -0,0 +1,12 @@
+function(gse_add_tool name)
+	file(GLOB_RECURSE TOOL_SOURCES CONFIGURE_DEPENDS "${CMAKE_CURRENT_SOURCE_DIR}/${name}/Source/*.cppm")
+
+	add_executable(${name} ${TOOL_SOURCES})
+
+	target_link_libraries(${name} PRIVATE Engine ${ARGN})
+
+	if(MSVC)
+		set_target_properties(${name} PROPERTIES MSVC_RUNTIME_LIBRARY "MultiThreaded$<$<CONFIG:Debug>:Debug>")
+		target_compile_options(${name} PRIVATE /arch:AVX2 /MP)
+	endif()
+endfunction()